@@ -4,7 +4,28 @@
       "target_name": "hpxaddon",
       "sources": [
         "src/addon/addon.cpp",
+        "src/addon/value_index_object.cpp",
+        "src/addon/resident_buffer_object.cpp",
+        "src/addon/csr_matrix_object.cpp",
+        "src/addon/arrow_column_object.cpp",
+        "src/addon/predicate_pool_object.cpp",
+        "src/addon/bitmap_object.cpp",
         "src/hpx_wrapper/hpx_wrapper.cpp",
+        "src/hpx_index/hpx_index.cpp",
+        "src/hpx_resident/hpx_resident.cpp",
+        "src/hpx_sketches/hpx_sketches.cpp",
+        "src/hpx_approx/hpx_approx.cpp",
+        "src/hpx_timeseries/hpx_timeseries.cpp",
+        "src/hpx_numeric/hpx_numeric.cpp",
+        "src/hpx_graph/hpx_graph.cpp",
+        "src/hpx_cluster/hpx_cluster.cpp",
+        "src/hpx_io/hpx_io.cpp",
+        "src/hpx_snapshot/hpx_snapshot.cpp",
+        "src/hpx_encoding/hpx_encoding.cpp",
+        "src/hpx_arrow/hpx_arrow.cpp",
+        "src/hpx_plugin/hpx_plugin.cpp",
+        "src/hpx_pool/hpx_pool.cpp",
+        "src/hpx_bitmap/hpx_bitmap.cpp",
         "src/hpx_manager/hpx_manager.cpp",
         "src/hpx_config/hpx_config.cpp",
         "src/utils/async_helpers.cpp",
@@ -20,6 +41,21 @@
         "src/utils",
         "src/addon",
         "src/hpx_wrapper",
+        "src/hpx_index",
+        "src/hpx_resident",
+        "src/hpx_sketches",
+        "src/hpx_approx",
+        "src/hpx_timeseries",
+        "src/hpx_numeric",
+        "src/hpx_graph",
+        "src/hpx_cluster",
+        "src/hpx_io",
+        "src/hpx_snapshot",
+        "src/hpx_encoding",
+        "src/hpx_arrow",
+        "src/hpx_plugin",
+        "src/hpx_pool",
+        "src/hpx_bitmap",
         "src/hpx_manager",
         "src/hpx_config",
         "src/extern/json/include"
@@ -29,6 +65,7 @@
         "-lhpx",
         "-ljemalloc",
         "-lhwloc",
+        "-ldl",
         "-lpthread"
       ],
       "defines": [
@@ -60,6 +97,36 @@
       "dependencies": [
         "<!(node -p \"require('node-addon-api').gyp\")"
       ]
+    },
+    {
+      "target_name": "hpx_test_kernels",
+      "type": "loadable_module",
+      "sources": [
+        "src/hpx_plugin/test_kernels/hpx_test_kernels.c"
+      ],
+      "include_dirs": [
+        "src/hpx_plugin"
+      ]
+    },
+    {
+      "target_name": "hpx_test_kernels_bad_abi",
+      "type": "loadable_module",
+      "sources": [
+        "src/hpx_plugin/test_kernels/hpx_test_kernels.c"
+      ],
+      "include_dirs": [
+        "src/hpx_plugin"
+      ],
+      "defines": [
+        "HPX_TEST_KERNELS_ABI_VERSION=0"
+      ]
+    },
+    {
+      "target_name": "hpx_test_arrow",
+      "type": "loadable_module",
+      "sources": [
+        "src/hpx_arrow/test_arrow/hpx_test_arrow.c"
+      ]
     }
   ]
 }
@@ -5,6 +5,27 @@
 #include "async_helpers.hpp"
 #include "data_conversion.hpp"
 #include "tsfn_manager.hpp"
+#include "hpx_index.hpp"
+#include "value_index_object.hpp"
+#include "hpx_resident.hpp"
+#include "resident_buffer_object.hpp"
+#include "hpx_sketches.hpp"
+#include "hpx_approx.hpp"
+#include "hpx_timeseries.hpp"
+#include "hpx_numeric.hpp"
+#include "csr_matrix_object.hpp"
+#include "hpx_graph.hpp"
+#include "hpx_cluster.hpp"
+#include "hpx_io.hpp"
+#include "hpx_snapshot.hpp"
+#include "hpx_encoding.hpp"
+#include "hpx_arrow.hpp"
+#include "arrow_column_object.hpp"
+#include "hpx_plugin.hpp"
+#include "hpx_pool.hpp"
+#include "predicate_pool_object.hpp"
+#include "hpx_bitmap.hpp"
+#include "bitmap_object.hpp"
 #include "log_macros.hpp"
 
 #include <napi.h>
@@ -17,6 +38,9 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstring> // for memcpy
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 /**
  * @brief This file defines the Node.js exposed functions that interface with HPX-based algorithms.
@@ -257,6 +281,73 @@ Napi::Value Equal(const Napi::CallbackInfo& info) {
     );
 }
 
+/**
+ * @brief Returns the first index at which two Int32Arrays differ.
+ *
+ * Uses hpx_mismatch, which compares both arrays in place. The arrays are retained until the
+ * Promise settles. Resolves with -1 if the arrays are equal, or with the shorter length if one
+ * array is a prefix of the other.
+ *
+ */
+Napi::Value Mismatch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto v1 = GetInt32ArrayArgument(info, 0);
+    auto v2 = GetInt32ArrayArgument(info, 1);
+    if (env.IsExceptionPending()) return env.Null();
+    const int32_t* v1Ptr = v1.Data(); size_t v1Size = v1.ElementLength();
+    const int32_t* v2Ptr = v2.Data(); size_t v2Size = v2.ElementLength();
+    auto retained = RetainArguments(info, {0, 1});
+
+    return QueueAsyncWork<int64_t>(
+        env,
+        [v1Ptr, v1Size, v2Ptr, v2Size](int64_t &res, std::string &err){
+            try {
+                auto fut = hpx_mismatch(v1Ptr, v1Size, v2Ptr, v2Size);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, int64_t &res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(Napi::Number::New(env, (double)res));
+        }
+    );
+}
+
+/**
+ * @brief Returns all indices at which two Int32Arrays differ.
+ *
+ * Uses hpx_diff_positions, which compares both arrays in place. Indices past the end of the
+ * shorter array count as differences. Returns a Promise with a Uint32Array of ascending indices.
+ *
+ */
+Napi::Value DiffPositions(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto v1 = GetInt32ArrayArgument(info, 0);
+    auto v2 = GetInt32ArrayArgument(info, 1);
+    if (env.IsExceptionPending()) return env.Null();
+    const int32_t* v1Ptr = v1.Data(); size_t v1Size = v1.ElementLength();
+    const int32_t* v2Ptr = v2.Data(); size_t v2Size = v2.ElementLength();
+    auto retained = RetainArguments(info, {0, 1});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint32_t>>>(
+        env,
+        [v1Ptr, v1Size, v2Ptr, v2Size](std::shared_ptr<std::vector<uint32_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_diff_positions(v1Ptr, v1Size, v2Ptr, v2Size);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint32_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Uint32Array arr = Napi::Uint32Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size()*sizeof(uint32_t));
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
 /**
  * @brief Finds the first occurrence of a given value in an Int32Array.
  *
@@ -349,6 +440,42 @@ Napi::Value PartialSort(const Napi::CallbackInfo& info) {
     );
 }
 
+/**
+ * @brief Computes exact quantiles (e.g. [0.5, 0.9, 0.99]) of an Int32Array without a full sort.
+ *
+ * Uses hpx_quantiles (parallel multi-select, linear interpolation between ranks).
+ * Returns a Promise with a Float64Array holding one value per requested quantile.
+ *
+ */
+Napi::Value Quantiles(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    auto quantiles = GetNumberListArgument(info, 1);
+    if (env.IsExceptionPending()) return env.Null();
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<double>>>(
+        env,
+        [dataPtr, dataSize, quantiles](std::shared_ptr<std::vector<double>>& res, std::string &err){
+            try {
+                auto fut = hpx_quantiles(dataPtr, dataSize, quantiles);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<double>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Float64Array arr = Napi::Float64Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size() * sizeof(double));
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
 /**
  * @brief Copies the first 'count' elements of the array into a new array.
  *
@@ -422,17 +549,106 @@ Napi::Value Fill(const Napi::CallbackInfo& info) {
     );
 }
 
+/**
+ * @brief Resolves a kernel name passed instead of a JS callback.
+ *
+ * Throws a JS Error (and returns nullptr) if no loaded plugin defines the name or the kernel
+ * has none of the accepted kinds.
+ */
+static std::shared_ptr<const NativeKernel> GetKernelArgument(const Napi::CallbackInfo& info, size_t index,
+                                                             std::initializer_list<hpx_kernel_kind> kinds) {
+    std::string name = info[index].As<Napi::String>().Utf8Value();
+    auto kernel = hpx_find_kernel(name);
+    if (!kernel) {
+        Napi::Error::New(info.Env(), "Unknown kernel '" + name + "'; load it with loadKernelPlugin()").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    if (std::find(kinds.begin(), kinds.end(), kernel->kind) == kinds.end()) {
+        Napi::TypeError::New(info.Env(), "Kernel '" + name + "' has the wrong kind for this operation").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    return kernel;
+}
+
+/**
+ * @brief Queues a plugin kernel that produces a new Int32Array from the input at argument 0.
+ */
+template <typename Run>
+static Napi::Value QueueKernelArray(const Napi::CallbackInfo& info, Run run) {
+    Napi::Env env = info.Env();
+    auto retained = RetainArguments(info, {0});
+    return QueueAsyncWork<std::shared_ptr<std::vector<int32_t>>>(
+        env,
+        [run](std::shared_ptr<std::vector<int32_t>>& res, std::string &err){
+            try {
+                auto fut = run();
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<int32_t>>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            Napi::Int32Array arr = Napi::Int32Array::New(env, res->size());
+            memcpy(arr.Data(), res->data(), res->size()*sizeof(int32_t));
+            def.Resolve(arr);
+        }
+    );
+}
+
 /**
  * @brief Counts how many elements satisfy a given JavaScript predicate.
  *
  * Uses a ThreadSafeFunction to call the JS predicate in batch mode.
  * 1 = element satisfies predicate, 0 = does not.
+ * The predicate may also be the name of a plugin predicate kernel, which runs on the HPX workers,
+ * or a PredicatePool, whose worker threads evaluate chunks of the input concurrently.
  * Returns a Promise with the count as a Number.
  *
  */
 Napi::Value CountIf(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     auto inputArr = GetInt32ArrayArgument(info,0);
+    PredicatePoolObject* pool = info.Length() > 1 && !env.IsExceptionPending() ? PredicatePoolObject::FromValue(info[1]) : nullptr;
+    if (pool) {
+        auto retained = RetainArguments(info, {0, 1});
+        MaskJob job;
+        const int32_t* data = nullptr;
+        if (!pool->Dispatch(env, inputArr, job, data, retained)) return env.Null();
+        size_t size = inputArr.ElementLength();
+        return QueueAsyncWork<int64_t>(
+            env,
+            [job, size](int64_t &res, std::string &err) {
+                try {
+                    hpx_wait_for_mask(job);
+                    auto fut = hpx_count_mask(job.mask, size);
+                    res = fut.get();
+                } catch(const std::exception& e){ err = e.what(); }
+            },
+            [retained](Napi::Env env, Napi::Promise::Deferred& def, int64_t &res, const std::string &err) {
+                if(!err.empty()) def.Reject(Napi::String::New(env,err));
+                else def.Resolve(Napi::Number::New(env,(double)res));
+            }
+        );
+    }
+    if (info.Length() > 1 && info[1].IsString() && !env.IsExceptionPending()) {
+        auto kernel = GetKernelArgument(info, 1, {HPX_KERNEL_PREDICATE});
+        if (!kernel) return env.Null();
+        const int32_t* data = inputArr.Data();
+        size_t size = inputArr.ElementLength();
+        auto retained = RetainArguments(info, {0});
+        return QueueAsyncWork<int64_t>(
+            env,
+            [data, size, kernel](int64_t &res, std::string &err) {
+                try {
+                    auto fut = hpx_kernel_count_if(data, size, kernel);
+                    res = fut.get();
+                } catch(const std::exception& e){ err = e.what(); }
+            },
+            [retained](Napi::Env env, Napi::Promise::Deferred& def, int64_t &res, const std::string &err) {
+                if(!err.empty()) def.Reject(Napi::String::New(env,err));
+                else def.Resolve(Napi::Number::New(env,(double)res));
+            }
+        );
+    }
     Napi::Function fn = info[1].As<Napi::Function>();
 
     const int32_t* dataPtr = inputArr.Data();
@@ -493,11 +709,43 @@ Napi::Value CountIf(const Napi::CallbackInfo& info) {
  *
  * Similar to CountIf, but returns all elements for which predicate is true.
  * Uses mask-based approach (GetPredicateMaskBatchUsingTSFN) and returns a Promise with the filtered array.
+ * Accepts the name of a plugin predicate kernel or a PredicatePool instead of the JS predicate.
  *
  */
 Napi::Value CopyIf(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     auto inputArr = GetInt32ArrayArgument(info,0);
+    PredicatePoolObject* pool = info.Length() > 1 && !env.IsExceptionPending() ? PredicatePoolObject::FromValue(info[1]) : nullptr;
+    if (pool) {
+        auto retained = RetainArguments(info, {0, 1});
+        MaskJob job;
+        const int32_t* data = nullptr;
+        if (!pool->Dispatch(env, inputArr, job, data, retained)) return env.Null();
+        size_t size = inputArr.ElementLength();
+        return QueueAsyncWork<std::shared_ptr<std::vector<int32_t>>>(
+            env,
+            [job, data, size](std::shared_ptr<std::vector<int32_t>>& res, std::string &err) {
+                try {
+                    hpx_wait_for_mask(job);
+                    auto fut = hpx_copy_masked(data, job.mask, size);
+                    res = fut.get();
+                } catch(const std::exception &e){ err = e.what(); }
+            },
+            [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<int32_t>>& res, const std::string &err) {
+                if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+                Napi::Int32Array arr = Napi::Int32Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size()*sizeof(int32_t));
+                def.Resolve(arr);
+            }
+        );
+    }
+    if (info.Length() > 1 && info[1].IsString() && !env.IsExceptionPending()) {
+        auto kernel = GetKernelArgument(info, 1, {HPX_KERNEL_PREDICATE});
+        if (!kernel) return env.Null();
+        const int32_t* data = inputArr.Data();
+        size_t size = inputArr.ElementLength();
+        return QueueKernelArray(info, [data, size, kernel]() { return hpx_kernel_copy_if(data, size, kernel); });
+    }
     Napi::Function fn = info[1].As<Napi::Function>();
     const int32_t* dataPtr = inputArr.Data();
     size_t dataSize = inputArr.ElementLength();
@@ -562,12 +810,20 @@ Napi::Value CopyIf(const Napi::CallbackInfo& info) {
  * @brief Sorts an Int32Array using a user-provided JavaScript key extraction function.
  *
  * Instead of calling a JS comparator per element, we do a single batch call to get keys, then sort C++ side.
+ * Accepts the name of a plugin comparator or key kernel instead of the JS key function.
  * Returns a Promise with the sorted array.
  *
  */
 Napi::Value SortComp(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     auto inputArr = GetInt32ArrayArgument(info,0);
+    if (info.Length() > 1 && info[1].IsString() && !env.IsExceptionPending()) {
+        auto kernel = GetKernelArgument(info, 1, {HPX_KERNEL_COMPARATOR, HPX_KERNEL_KEY});
+        if (!kernel) return env.Null();
+        const int32_t* data = inputArr.Data();
+        size_t size = inputArr.ElementLength();
+        return QueueKernelArray(info, [data, size, kernel]() { return hpx_kernel_sort(data, size, size, kernel); });
+    }
     Napi::Function fn = info[1].As<Napi::Function>();
     const int32_t* dataPtr = inputArr.Data();
     size_t dataSize = inputArr.ElementLength();
@@ -627,6 +883,7 @@ Napi::Value SortComp(const Napi::CallbackInfo& info) {
  * @brief Partially sorts the array using a JavaScript key extractor. Only the smallest 'middle' elements are guaranteed sorted.
  *
  * Similar approach to SortComp: one JS call to get keys, then hpx logic to partial sort.
+ * Accepts the name of a plugin comparator or key kernel instead of the JS key function.
  * Returns a Promise with partially sorted array.
  *
  */
@@ -634,6 +891,14 @@ Napi::Value PartialSortComp(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     auto inputArr = GetInt32ArrayArgument(info,0);
     uint32_t middle = info[1].As<Napi::Number>().Uint32Value();
+    if (info.Length() > 2 && info[2].IsString() && !env.IsExceptionPending()) {
+        auto kernel = GetKernelArgument(info, 2, {HPX_KERNEL_COMPARATOR, HPX_KERNEL_KEY});
+        if (!kernel) return env.Null();
+        const int32_t* data = inputArr.Data();
+        size_t size = inputArr.ElementLength();
+        size_t mid = std::min<size_t>(middle, size);
+        return QueueKernelArray(info, [data, size, mid, kernel]() { return hpx_kernel_sort(data, size, mid, kernel); });
+    }
     Napi::Function fn = info[2].As<Napi::Function>();
     const int32_t* dataPtr = inputArr.Data();
     size_t dataSize = inputArr.ElementLength();
@@ -686,7 +951,2085 @@ Napi::Value PartialSortComp(const Napi::CallbackInfo& info) {
     );
 }
 
+/**
+ * @brief Builds a persistent value -> positions index over an Int32Array.
+ *
+ * The index is built once on HPX (parallel sort of (value, position) pairs) and keeps its own
+ * copy of the positions, so the input can be modified or dropped afterwards. The returned
+ * ValueIndex object answers count/find/findAll in O(log distinct) and batch lookups on HPX.
+ *
+ */
+Napi::Value BuildValueIndex(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<const ValueIndex>>(
+        env,
+        [dataPtr, dataSize](std::shared_ptr<const ValueIndex>& res, std::string &err){
+            try {
+                auto fut = ValueIndex::Build(dataPtr, dataSize);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<const ValueIndex>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(ValueIndexObject::NewInstance(env, res));
+        }
+    );
+}
+
+/**
+ * @brief Copies an Int32Array into a natively held ResidentBuffer.
+ *
+ * Options (optional second argument): { zoneMap: boolean } builds a min/max summary per 64K block,
+ * which lets count/find/countRange skip blocks that cannot match. The summary is maintained by
+ * every write(). Returns a Promise resolved with the ResidentBuffer object.
+ *
+ */
+Napi::Value CreateResidentBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    bool zoneMap = false;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        if (opts.Has("zoneMap")) zoneMap = opts.Get("zoneMap").ToBoolean().Value();
+    }
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<ResidentBuffer>>(
+        env,
+        [dataPtr, dataSize, zoneMap](std::shared_ptr<ResidentBuffer>& res, std::string &err){
+            try {
+                auto fut = hpx_resident_create(dataPtr, dataSize, zoneMap);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<ResidentBuffer>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(ResidentBufferObject::NewInstance(env, res));
+        }
+    );
+}
+
+/**
+ * @brief Builds a blocked Bloom filter over the keys of an Int32Array.
+ *
+ * Options (optional second argument): { fpRate: number } target false positive rate (default 0.01).
+ * Returns a Promise with the serialized filter as a Uint8Array, which can be stored, sent to another
+ * process and passed to bloomQuery as is.
+ *
+ */
+Napi::Value BloomBuild(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto keysArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    double fpRate = 0.01;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        if (opts.Has("fpRate")) fpRate = opts.Get("fpRate").ToNumber().DoubleValue();
+    }
+    const int32_t* keysPtr = keysArr.Data();
+    size_t keysSize = keysArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint8_t>>>(
+        env,
+        [keysPtr, keysSize, fpRate](std::shared_ptr<std::vector<uint8_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_bloom_build(keysPtr, keysSize, fpRate);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint8_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Uint8Array arr = Napi::Uint8Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size());
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
+/**
+ * @brief Tests an Int32Array of probes against a serialized Bloom filter.
+ *
+ * Returns a Promise with a Uint8Array mask: 1 = possibly present, 0 = definitely absent.
+ * Rejects if the filter bytes are not a valid filter produced by bloomBuild.
+ *
+ */
+Napi::Value BloomQuery(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto filterArr = GetUint8ArrayArgument(info, 0);
+    auto probesArr = GetInt32ArrayArgument(info, 1);
+    if (env.IsExceptionPending()) return env.Null();
+    const uint8_t* filterPtr = filterArr.Data(); size_t filterSize = filterArr.ElementLength();
+    const int32_t* probesPtr = probesArr.Data(); size_t probesSize = probesArr.ElementLength();
+    auto retained = RetainArguments(info, {0, 1});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint8_t>>>(
+        env,
+        [filterPtr, filterSize, probesPtr, probesSize](std::shared_ptr<std::vector<uint8_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_bloom_query(filterPtr, filterSize, probesPtr, probesSize);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint8_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Uint8Array arr = Napi::Uint8Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size());
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
+// Converts an HllResult into the { estimate, sketch } object returned to JS
+static Napi::Object HllResultToObject(Napi::Env env, const HllResult& res) {
+    Napi::Object obj = Napi::Object::New(env);
+    Napi::Uint8Array sketch = Napi::Uint8Array::New(env, res.sketch->size());
+    memcpy(sketch.Data(), res.sketch->data(), res.sketch->size());
+    obj.Set("estimate", Napi::Number::New(env, res.estimate));
+    obj.Set("sketch", sketch);
+    return obj;
+}
+
+/**
+ * @brief Estimates the number of distinct values in an Int32Array with HyperLogLog.
+ *
+ * Options (optional second argument): { precision: number } index bits in [4, 18] (default 14,
+ * about 0.8% standard error with a 16 KB sketch).
+ * Returns a Promise with { estimate, sketch }; sketches can be combined later with hllMerge.
+ *
+ */
+Napi::Value DistinctApprox(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    uint32_t precision = 14;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        if (opts.Has("precision")) precision = opts.Get("precision").ToNumber().Uint32Value();
+    }
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<HllResult>(
+        env,
+        [dataPtr, dataSize, precision](HllResult& res, std::string &err){
+            try {
+                auto fut = hpx_hll_build(dataPtr, dataSize, precision);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, HllResult& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(HllResultToObject(env, res));
+        }
+    );
+}
+
+/**
+ * @brief Merges HyperLogLog sketches (an Array of Uint8Arrays) of equal precision.
+ *
+ * The merged sketch equals the sketch of the union of all underlying data, so distinct counts
+ * can be rolled up over many chunks without revisiting them. Returns a Promise with
+ * { estimate, sketch }.
+ *
+ */
+Napi::Value HllMerge(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    // Sketches are small (at most 256 KB), so they are simply copied
+    auto sketches = GetUint8ArrayListArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+
+    return QueueAsyncWork<HllResult>(
+        env,
+        [sketches](HllResult& res, std::string &err){
+            try {
+                auto fut = hpx_hll_merge(sketches);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, HllResult& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(HllResultToObject(env, res));
+        }
+    );
+}
+
+/**
+ * @brief Builds a mergeable KLL quantile sketch over an Int32Array in one parallel pass.
+ *
+ * Options (optional second argument): { k: number } accuracy parameter in [8, 65535] (default 200,
+ * roughly 1% rank error). Returns a Promise with the serialized sketch as a Uint8Array.
+ *
+ */
+Napi::Value QuantileSketch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    uint32_t k = 200;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        if (opts.Has("k")) k = opts.Get("k").ToNumber().Uint32Value();
+    }
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint8_t>>>(
+        env,
+        [dataPtr, dataSize, k](std::shared_ptr<std::vector<uint8_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_kll_build(dataPtr, dataSize, k);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint8_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Uint8Array arr = Napi::Uint8Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size());
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
+/**
+ * @brief Merges KLL quantile sketches (an Array of Uint8Arrays) built with the same k.
+ *
+ * Returns a Promise with the merged sketch as a Uint8Array.
+ *
+ */
+Napi::Value QuantileSketchMerge(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto sketches = GetUint8ArrayListArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint8_t>>>(
+        env,
+        [sketches](std::shared_ptr<std::vector<uint8_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_kll_merge(sketches);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint8_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Uint8Array arr = Napi::Uint8Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size());
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
+/**
+ * @brief Reads approximate quantiles from a serialized KLL sketch.
+ *
+ * Returns a Promise with a Float64Array holding one value per requested quantile.
+ *
+ */
+Napi::Value QuantileSketchQuery(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto sketchArr = GetUint8ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    auto quantiles = GetNumberListArgument(info, 1);
+    if (env.IsExceptionPending()) return env.Null();
+    const uint8_t* sketchPtr = sketchArr.Data();
+    size_t sketchSize = sketchArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<double>>>(
+        env,
+        [sketchPtr, sketchSize, quantiles](std::shared_ptr<std::vector<double>>& res, std::string &err){
+            try {
+                auto fut = hpx_kll_quantiles(sketchPtr, sketchSize, quantiles);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<double>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Float64Array arr = Napi::Float64Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size() * sizeof(double));
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
+// Reads { errorBound, timeBudgetMs, confidence } from an optional options object.
+// Without a stopping rule, the estimate aims for 1% relative error.
+static ApproxOptions GetApproxOptions(const Napi::CallbackInfo& info, size_t index) {
+    ApproxOptions options;
+    if (info.Length() > index && info[index].IsObject()) {
+        Napi::Object opts = info[index].As<Napi::Object>();
+        if (opts.Has("errorBound")) options.errorBound = opts.Get("errorBound").ToNumber().DoubleValue();
+        if (opts.Has("timeBudgetMs")) options.timeBudgetMs = opts.Get("timeBudgetMs").ToNumber().DoubleValue();
+        if (opts.Has("confidence")) options.confidence = opts.Get("confidence").ToNumber().DoubleValue();
+    }
+    if (options.errorBound <= 0.0 && options.timeBudgetMs <= 0.0) options.errorBound = 0.01;
+    return options;
+}
+
+// Converts an ApproxResult into the { estimate, lower, upper, confidence, sampled, exact } object returned to JS
+static Napi::Object ApproxResultToObject(Napi::Env env, const ApproxResult& res, double confidence, double scale = 1.0) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("estimate", Napi::Number::New(env, res.estimate * scale));
+    obj.Set("lower", Napi::Number::New(env, res.lower * scale));
+    obj.Set("upper", Napi::Number::New(env, res.upper * scale));
+    obj.Set("confidence", Napi::Number::New(env, confidence));
+    obj.Set("sampled", Napi::Number::New(env, static_cast<double>(res.sampled)));
+    obj.Set("exact", Napi::Boolean::New(env, res.exact));
+    return obj;
+}
+
+/**
+ * @brief Approximately counts the occurrences of a value by stratified block sampling.
+ *
+ * Options (optional third argument): { errorBound, timeBudgetMs, confidence } (see hpx_approx.hpp).
+ * Returns a Promise with { estimate, lower, upper, confidence, sampled, exact }.
+ *
+ */
+Napi::Value CountApprox(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    int32_t value = info[1].As<Napi::Number>().Int32Value();
+    ApproxOptions options = GetApproxOptions(info, 2);
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<ApproxResult>(
+        env,
+        [dataPtr, dataSize, value, options](ApproxResult& res, std::string &err){
+            try {
+                auto fut = hpx_count_approx(dataPtr, dataSize, value, options);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, options](Napi::Env env, Napi::Promise::Deferred& def, ApproxResult& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(ApproxResultToObject(env, res, options.confidence));
+        }
+    );
+}
+
+/**
+ * @brief Approximately counts the elements satisfying a JavaScript predicate.
+ *
+ * The predicate is called in batch mode (Int32Array in, Uint8Array mask out) once per sampling
+ * round, with the sampled blocks only. Options and result as for countApprox.
+ *
+ */
+Napi::Value CountIfApprox(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    if (info.Length() < 2 || !info[1].IsFunction()) {
+        Napi::TypeError::New(env, "Expected a predicate function at argument 1").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Function fn = info[1].As<Napi::Function>();
+    ApproxOptions options = GetApproxOptions(info, 2);
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    auto tsfn = Napi::ThreadSafeFunction::New(env, fn, "BatchPredicate", 0, 1);
+    auto tsfnPtr = std::make_shared<Napi::ThreadSafeFunction>(std::move(tsfn));
+
+    return QueueAsyncWork<ApproxResult>(
+        env,
+        [dataPtr, dataSize, options, tsfnPtr](ApproxResult& res, std::string &err){
+            try {
+                // Sampling and aggregation run on HPX; the predicate round trip of every round
+                // waits for the JS thread here, as in CountIf, rather than on an HPX worker
+                auto sampler = hpx_approx_sampler(dataSize, options).get();
+                while (!sampler->Done()) {
+                    auto batch = hpx_approx_gather(sampler, dataPtr).get();
+                    auto mask = GetPredicateMaskBatchUsingTSFN(*tsfnPtr, batch->data(), batch->size());
+                    hpx_approx_record_mask(sampler, mask).get();
+                }
+                res = approx_clamp_count(sampler->Result(), dataSize);
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, options, tsfnPtr](Napi::Env env, Napi::Promise::Deferred& def, ApproxResult& res, const std::string &err){
+            tsfnPtr->Abort();
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(ApproxResultToObject(env, res, options.confidence));
+        }
+    );
+}
+
+/**
+ * @brief Approximately sums (or averages) an Int32Array by stratified block sampling.
+ *
+ * Shared by sumApprox and meanApprox; the mean is the estimated sum scaled by 1 / length.
+ *
+ */
+static Napi::Value SumApproxImpl(const Napi::CallbackInfo& info, bool mean) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    ApproxOptions options = GetApproxOptions(info, 1);
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+    double scale = (mean && dataSize > 0) ? 1.0 / static_cast<double>(dataSize) : 1.0;
+
+    return QueueAsyncWork<ApproxResult>(
+        env,
+        [dataPtr, dataSize, options](ApproxResult& res, std::string &err){
+            try {
+                auto fut = hpx_sum_approx(dataPtr, dataSize, options);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, options, scale](Napi::Env env, Napi::Promise::Deferred& def, ApproxResult& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(ApproxResultToObject(env, res, options.confidence, scale));
+        }
+    );
+}
+
+/**
+ * @brief Approximately sums an Int32Array. Options and result as for countApprox.
+ *
+ */
+Napi::Value SumApprox(const Napi::CallbackInfo& info) {
+    return SumApproxImpl(info, false);
+}
+
+/**
+ * @brief Approximately averages an Int32Array. Options and result as for countApprox.
+ *
+ */
+Napi::Value MeanApprox(const Napi::CallbackInfo& info) {
+    return SumApproxImpl(info, true);
+}
+
+/**
+ * @brief Computes rolling aggregates over windows of a fixed length.
+ *
+ * Arguments: (Int32Array, window, ops?) where ops is an Array of "sum", "mean", "min", "max"
+ * (default: all four). Window i covers elements [i, i + window), so each output has
+ * length - window + 1 values. Returns a Promise with an object holding the requested outputs:
+ * sum and mean as Float64Array, min and max as Int32Array.
+ *
+ */
+Napi::Value Rolling(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    if (info.Length() < 2 || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected a window length at argument 1").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t window = static_cast<size_t>(info[1].As<Napi::Number>().Int64Value());
+    RollingOps ops{true, true, true, true};
+    if (info.Length() > 2 && info[2].IsArray()) {
+        ops = RollingOps{};
+        Napi::Array names = info[2].As<Napi::Array>();
+        for (uint32_t i = 0; i < names.Length(); i++) {
+            std::string name = names.Get(i).ToString().Utf8Value();
+            if (name == "sum") ops.sum = true;
+            else if (name == "mean") ops.mean = true;
+            else if (name == "min") ops.min = true;
+            else if (name == "max") ops.max = true;
+            else {
+                Napi::TypeError::New(env, "Unknown rolling op: " + name).ThrowAsJavaScriptException();
+                return env.Null();
+            }
+        }
+    }
+    const int32_t* dataPtr = inputArr.Data();
+    size_t dataSize = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<RollingResult>(
+        env,
+        [dataPtr, dataSize, window, ops](RollingResult& res, std::string &err){
+            try {
+                auto fut = hpx_rolling(dataPtr, dataSize, window, ops);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, RollingResult& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            Napi::Object obj = Napi::Object::New(env);
+            auto setDoubles = [&](const char* name, const std::shared_ptr<std::vector<double>>& v) {
+                if (!v) return;
+                Napi::Float64Array arr = Napi::Float64Array::New(env, v->size());
+                memcpy(arr.Data(), v->data(), v->size() * sizeof(double));
+                obj.Set(name, arr);
+            };
+            auto setInts = [&](const char* name, const std::shared_ptr<std::vector<int32_t>>& v) {
+                if (!v) return;
+                Napi::Int32Array arr = Napi::Int32Array::New(env, v->size());
+                memcpy(arr.Data(), v->data(), v->size() * sizeof(int32_t));
+                obj.Set(name, arr);
+            };
+            setDoubles("sum", res.sum);
+            setDoubles("mean", res.mean);
+            setInts("min", res.min);
+            setInts("max", res.max);
+            def.Resolve(obj);
+        }
+    );
+}
+
+// Typed array type of a Float32Array/Float64Array argument, or napi_int8_array if it is neither
+static napi_typedarray_type FloatArrayType(const Napi::Value& value) {
+    if (!value.IsTypedArray()) return napi_int8_array;
+    napi_typedarray_type type = value.As<Napi::TypedArray>().TypedArrayType();
+    return (type == napi_float32_array || type == napi_float64_array) ? type : napi_int8_array;
+}
+
+// Returns 'out' if it is a typed array of 'type' holding exactly 'length' elements, a new one
+// if 'out' is undefined, and throws a TypeError otherwise
+static Napi::TypedArray FloatOutputArray(Napi::Env env, const Napi::Value& out, napi_typedarray_type type, size_t length) {
+    if (out.IsUndefined()) {
+        if (type == napi_float32_array) return Napi::Float32Array::New(env, length);
+        return Napi::Float64Array::New(env, length);
+    }
+    if (FloatArrayType(out) != type || out.As<Napi::TypedArray>().ElementLength() != length) {
+        Napi::TypeError::New(env, "out must be a typed array of the input type with " + std::to_string(length) + " elements").ThrowAsJavaScriptException();
+        return Napi::TypedArray();
+    }
+    return out.As<Napi::TypedArray>();
+}
+
+// Queues hpx_convolve<T> writing into 'output' (already validated to hold the result)
+template <typename T>
+static Napi::Value QueueConvolve(const Napi::CallbackInfo& info, Napi::TypedArray output, ConvolveMode mode) {
+    Napi::Env env = info.Env();
+    auto signal = info[0].As<Napi::TypedArrayOf<T>>();
+    auto kernel = info[1].As<Napi::TypedArrayOf<T>>();
+    const T* signalPtr = signal.Data();
+    size_t signalSize = signal.ElementLength();
+    const T* kernelPtr = kernel.Data();
+    size_t kernelSize = kernel.ElementLength();
+    T* outPtr = output.As<Napi::TypedArrayOf<T>>().Data();
+    auto retained = RetainArguments(info, {0, 1});
+    auto outRef = std::make_shared<Napi::ObjectReference>(Napi::Persistent(output.As<Napi::Object>()));
+
+    return QueueAsyncWork(
+        env,
+        [signalPtr, signalSize, kernelPtr, kernelSize, mode, outPtr](std::string &err){
+            try {
+                hpx_convolve<T>(signalPtr, signalSize, kernelPtr, kernelSize, mode, outPtr).get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, outRef](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(outRef->Value());
+        }
+    );
+}
+
+/**
+ * @brief Convolves a Float32Array/Float64Array signal with a kernel of the same type.
+ *
+ * Options (optional third argument): { mode: "full" | "same" | "valid" (default "full"),
+ * out: typed array of the same type and exact output length }. The result is written into
+ * 'out' when given (no allocation; it must not overlap the signal or the kernel), otherwise into
+ * a new typed array. Returns a Promise with the output array.
+ *
+ */
+Napi::Value Convolve(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    napi_typedarray_type type = info.Length() > 1 ? FloatArrayType(info[0]) : napi_int8_array;
+    if (type == napi_int8_array || FloatArrayType(info[1]) != type) {
+        Napi::TypeError::New(env, "Expected signal and kernel as Float32Arrays or Float64Arrays of the same type").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    ConvolveMode mode = ConvolveMode::Full;
+    Napi::Value out = env.Undefined();
+    if (info.Length() > 2 && info[2].IsObject()) {
+        Napi::Object opts = info[2].As<Napi::Object>();
+        if (opts.Has("mode")) {
+            std::string name = opts.Get("mode").ToString().Utf8Value();
+            if (name == "same") mode = ConvolveMode::Same;
+            else if (name == "valid") mode = ConvolveMode::Valid;
+            else if (name != "full") {
+                Napi::TypeError::New(env, "mode must be 'full', 'same' or 'valid'").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+        }
+        if (opts.Has("out")) out = opts.Get("out");
+    }
+    size_t signalSize = info[0].As<Napi::TypedArray>().ElementLength();
+    size_t kernelSize = info[1].As<Napi::TypedArray>().ElementLength();
+    size_t length = (signalSize == 0 || kernelSize == 0) ? 0 : convolve_output_length(signalSize, kernelSize, mode);
+
+    Napi::TypedArray output = FloatOutputArray(env, out, type, length);
+    if (env.IsExceptionPending()) return env.Null();
+    if (TypedArraysOverlap(output, info[0].As<Napi::TypedArray>()) || TypedArraysOverlap(output, info[1].As<Napi::TypedArray>())) {
+        Napi::RangeError::New(env, "out must not overlap the signal or the kernel").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (type == napi_float32_array) return QueueConvolve<float>(info, output, mode);
+    return QueueConvolve<double>(info, output, mode);
+}
+
+// Reads a matrix dimension: a non-negative integer no larger than 'limit', the element count of
+// its matrix. Throws a RangeError otherwise, so huge or negative values cannot wrap size_t.
+static bool MatrixDimension(Napi::Env env, const Napi::Value& value, const char* name, size_t limit, size_t& dim) {
+    double d = value.ToNumber().DoubleValue();
+    if (env.IsExceptionPending()) return false;
+    if (!(d >= 0.0 && d <= static_cast<double>(limit)) || d != std::floor(d)) {
+        Napi::RangeError::New(env, std::string(name) + " must be an integer in [0, " + std::to_string(limit) + "]").ThrowAsJavaScriptException();
+        return false;
+    }
+    dim = static_cast<size_t>(d);
+    return true;
+}
+
+// True if a * b == expected, without overflowing
+static bool ProductEquals(size_t a, size_t b, size_t expected) {
+    if (a == 0 || b == 0) return expected == 0;
+    return b <= expected / a && a * b == expected;
+}
+
+// Queues hpx_matmul<T> (C = A * B) writing into 'output'
+template <typename T>
+static Napi::Value QueueMatmul(const Napi::CallbackInfo& info, Napi::TypedArray output, size_t m, size_t n, size_t k) {
+    Napi::Env env = info.Env();
+    const T* aPtr = info[0].As<Napi::TypedArrayOf<T>>().Data();
+    const T* bPtr = info[1].As<Napi::TypedArrayOf<T>>().Data();
+    T* cPtr = output.As<Napi::TypedArrayOf<T>>().Data();
+    auto retained = RetainArguments(info, {0, 1});
+    auto outRef = std::make_shared<Napi::ObjectReference>(Napi::Persistent(output.As<Napi::Object>()));
+
+    return QueueAsyncWork(
+        env,
+        [aPtr, bPtr, cPtr, m, n, k](std::string &err){
+            try {
+                hpx_matmul<T>(aPtr, bPtr, cPtr, m, n, k).get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, outRef](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(outRef->Value());
+        }
+    );
+}
+
+/**
+ * @brief Multiplies row-major matrices: C (m x n) = A (m x k) * B (k x n).
+ *
+ * A and B are Float32Arrays or Float64Arrays of the same type. Options (third argument, required):
+ * { m, n, k, out? }, where each dimension is an integer no larger than the length of the matrices
+ * it indexes. The result is written into 'out' when given (it must not overlap A or B), otherwise
+ * into a new typed array. Returns a Promise with C.
+ *
+ */
+Napi::Value Matmul(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    napi_typedarray_type type = info.Length() > 2 ? FloatArrayType(info[0]) : napi_int8_array;
+    if (type == napi_int8_array || FloatArrayType(info[1]) != type || !info[2].IsObject()) {
+        Napi::TypeError::New(env, "Expected (A, B, { m, n, k }) with A and B Float32Arrays or Float64Arrays of the same type").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Object opts = info[2].As<Napi::Object>();
+    if (!opts.Has("m") || !opts.Has("n") || !opts.Has("k")) {
+        Napi::TypeError::New(env, "Expected dimensions { m, n, k }").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t aSize = info[0].As<Napi::TypedArray>().ElementLength();
+    size_t bSize = info[1].As<Napi::TypedArray>().ElementLength();
+    size_t m, n, k;
+    if (!MatrixDimension(env, opts.Get("m"), "m", aSize, m) || !MatrixDimension(env, opts.Get("k"), "k", std::min(aSize, bSize), k) ||
+        !MatrixDimension(env, opts.Get("n"), "n", bSize, n)) {
+        return env.Null();
+    }
+    if (!ProductEquals(m, k, aSize) || !ProductEquals(k, n, bSize)) {
+        Napi::RangeError::New(env, "A must hold m * k and B k * n elements").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (n != 0 && m > SIZE_MAX / n) {
+        Napi::RangeError::New(env, "C would hold more than SIZE_MAX elements").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::TypedArray output = FloatOutputArray(env, opts.Has("out") ? opts.Get("out") : env.Undefined(), type, m * n);
+    if (env.IsExceptionPending()) return env.Null();
+    if (TypedArraysOverlap(output, info[0].As<Napi::TypedArray>()) || TypedArraysOverlap(output, info[1].As<Napi::TypedArray>())) {
+        Napi::RangeError::New(env, "out must not overlap A or B").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (type == napi_float32_array) return QueueMatmul<float>(info, output, m, n, k);
+    return QueueMatmul<double>(info, output, m, n, k);
+}
+
+// Queues hpx_transpose<T> writing into 'output'
+template <typename T>
+static Napi::Value QueueTranspose(const Napi::CallbackInfo& info, Napi::TypedArray output, size_t rows, size_t cols) {
+    Napi::Env env = info.Env();
+    const T* srcPtr = info[0].As<Napi::TypedArrayOf<T>>().Data();
+    T* dstPtr = output.As<Napi::TypedArrayOf<T>>().Data();
+    auto retained = RetainArguments(info, {0});
+    auto outRef = std::make_shared<Napi::ObjectReference>(Napi::Persistent(output.As<Napi::Object>()));
+
+    return QueueAsyncWork(
+        env,
+        [srcPtr, dstPtr, rows, cols](std::string &err){
+            try {
+                hpx_transpose<T>(srcPtr, dstPtr, rows, cols).get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, outRef](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(outRef->Value());
+        }
+    );
+}
+
+/**
+ * @brief Transposes a row-major rows x cols Float32Array/Float64Array matrix.
+ *
+ * rows and cols are integers no larger than A.length. Options (optional fourth argument): { out }
+ * typed array of the same type and size (must not overlap the input). Returns a Promise with the
+ * cols x rows result.
+ *
+ */
+Napi::Value Transpose(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    napi_typedarray_type type = FloatArrayType(info[0]);
+    if (type == napi_int8_array || info.Length() < 3 || !info[1].IsNumber() || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Expected (A, rows, cols) with A a Float32Array or Float64Array").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t size = info[0].As<Napi::TypedArray>().ElementLength();
+    size_t rows, cols;
+    if (!MatrixDimension(env, info[1], "rows", size, rows) || !MatrixDimension(env, info[2], "cols", size, cols)) return env.Null();
+    if (!ProductEquals(rows, cols, size)) {
+        Napi::RangeError::New(env, "A must hold rows * cols elements").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Value out = env.Undefined();
+    if (info.Length() > 3 && info[3].IsObject() && info[3].As<Napi::Object>().Has("out")) out = info[3].As<Napi::Object>().Get("out");
+    Napi::TypedArray output = FloatOutputArray(env, out, type, rows * cols);
+    if (env.IsExceptionPending()) return env.Null();
+    Napi::TypedArray input = info[0].As<Napi::TypedArray>();
+    if (TypedArraysOverlap(output, input)) {
+        Napi::RangeError::New(env, "out must not overlap the input").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (type == napi_float32_array) return QueueTranspose<float>(info, output, rows, cols);
+    return QueueTranspose<double>(info, output, rows, cols);
+}
+
+// Data of a Uint32Array or Int32Array index argument (Int32 values are reinterpreted as unsigned,
+// so negative indices fail the range checks), or nullptr if it is neither
+static const uint32_t* IndexArrayData(const Napi::Value& value, size_t& length) {
+    if (!value.IsTypedArray()) return nullptr;
+    Napi::TypedArray ta = value.As<Napi::TypedArray>();
+    length = ta.ElementLength();
+    if (ta.TypedArrayType() == napi_uint32_array) return ta.As<Napi::Uint32Array>().Data();
+    if (ta.TypedArrayType() == napi_int32_array) return reinterpret_cast<const uint32_t*>(ta.As<Napi::Int32Array>().Data());
+    return nullptr;
+}
+
+// Validates (rowOffsets, colIdx, values) and returns the number of rows, or throws a TypeError
+static bool GetCsrArguments(const Napi::CallbackInfo& info, const uint32_t*& offsets, size_t& rows,
+                            const uint32_t*& columns, size_t& nnz, napi_typedarray_type& type) {
+    Napi::Env env = info.Env();
+    size_t offsetsLength = 0, columnsLength = 0;
+    offsets = info.Length() > 2 ? IndexArrayData(info[0], offsetsLength) : nullptr;
+    columns = info.Length() > 2 ? IndexArrayData(info[1], columnsLength) : nullptr;
+    type = info.Length() > 2 ? FloatArrayType(info[2]) : napi_int8_array;
+    if (!offsets || !columns || type == napi_int8_array || offsetsLength == 0) {
+        Napi::TypeError::New(env, "Expected rowOffsets and colIdx as Uint32Arrays/Int32Arrays and values as a Float32Array/Float64Array").ThrowAsJavaScriptException();
+        return false;
+    }
+    nnz = info[2].As<Napi::TypedArray>().ElementLength();
+    if (columnsLength != nnz) {
+        Napi::RangeError::New(env, "colIdx and values must have the same length").ThrowAsJavaScriptException();
+        return false;
+    }
+    rows = offsetsLength - 1;
+    return true;
+}
+
+// Queues hpx_spmv<T> for the validated arguments of Spmv
+template <typename T>
+static Napi::Value QueueSpmv(const Napi::CallbackInfo& info, const uint32_t* offsets, size_t rows, const uint32_t* columns, size_t nnz) {
+    Napi::Env env = info.Env();
+    const T* valuesPtr = info[2].As<Napi::TypedArrayOf<T>>().Data();
+    auto x = info[3].As<Napi::TypedArrayOf<T>>();
+    const T* xPtr = x.Data();
+    size_t xSize = x.ElementLength();
+    T* yPtr = info[4].As<Napi::TypedArrayOf<T>>().Data();
+    auto retained = RetainArguments(info, {0, 1, 2, 3, 4});
+
+    return QueueAsyncWork(
+        env,
+        [offsets, rows, columns, valuesPtr, nnz, xPtr, xSize, yPtr](std::string &err){
+            try {
+                hpx_spmv<T>(offsets, rows, columns, valuesPtr, nnz, xPtr, xSize, yPtr).get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve((*retained)[4].Value());
+        }
+    );
+}
+
+/**
+ * @brief Sparse matrix-vector product y = A * x with A in CSR form.
+ *
+ * Arguments: (rowOffsets, colIdx, values, x, y). rowOffsets (rows + 1) and colIdx are Uint32Arrays
+ * or Int32Arrays; values, x and y share one float type and y holds 'rows' elements without
+ * overlapping x or values. The work is split by rows + non-zeros (merge path), so skewed row
+ * lengths stay balanced. Returns a Promise with y.
+ *
+ */
+Napi::Value Spmv(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const uint32_t* offsets;
+    const uint32_t* columns;
+    size_t rows, nnz;
+    napi_typedarray_type type;
+    if (!GetCsrArguments(info, offsets, rows, columns, nnz, type)) return env.Null();
+    if (info.Length() < 5 || FloatArrayType(info[3]) != type || FloatArrayType(info[4]) != type) {
+        Napi::TypeError::New(env, "x and y must be typed arrays of the values type").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (info[4].As<Napi::TypedArray>().ElementLength() != rows) {
+        Napi::RangeError::New(env, "y must hold rowOffsets.length - 1 elements").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::TypedArray y = info[4].As<Napi::TypedArray>();
+    if (TypedArraysOverlap(y, info[3].As<Napi::TypedArray>()) || TypedArraysOverlap(y, info[2].As<Napi::TypedArray>())) {
+        Napi::RangeError::New(env, "y must not overlap x or values").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (type == napi_float32_array) return QueueSpmv<float>(info, offsets, rows, columns, nnz);
+    return QueueSpmv<double>(info, offsets, rows, columns, nnz);
+}
+
+// Queues CsrMatrix<T>::Build for the validated arguments of CreateCsrMatrix
+template <typename T>
+static Napi::Value QueueCsrBuild(const Napi::CallbackInfo& info, const uint32_t* offsets, size_t rows, const uint32_t* columns, size_t nnz, size_t cols) {
+    Napi::Env env = info.Env();
+    const T* valuesPtr = info[2].As<Napi::TypedArrayOf<T>>().Data();
+    auto retained = RetainArguments(info, {0, 1, 2});
+
+    return QueueAsyncWork<std::shared_ptr<const CsrMatrix<T>>>(
+        env,
+        [offsets, rows, columns, valuesPtr, nnz, cols](std::shared_ptr<const CsrMatrix<T>>& res, std::string &err){
+            try {
+                auto fut = CsrMatrix<T>::Build(offsets, rows, columns, valuesPtr, nnz, cols);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<const CsrMatrix<T>>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            CsrMatrixHandle handle;
+            if constexpr (std::is_same<T, float>::value) handle.f32 = res;
+            else handle.f64 = res;
+            def.Resolve(CsrMatrixObject::NewInstance(env, handle));
+        }
+    );
+}
+
+/**
+ * @brief Validates and copies a CSR matrix into native memory for repeated products.
+ *
+ * Arguments: (rowOffsets, colIdx, values, { cols }?) with cols defaulting to the number of rows
+ * (square matrix). Returns a Promise with a CsrMatrix object (see csr_matrix_object.hpp).
+ *
+ */
+Napi::Value CreateCsrMatrix(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const uint32_t* offsets;
+    const uint32_t* columns;
+    size_t rows, nnz;
+    napi_typedarray_type type;
+    if (!GetCsrArguments(info, offsets, rows, columns, nnz, type)) return env.Null();
+    size_t cols = rows;
+    if (info.Length() > 3 && info[3].IsObject()) {
+        Napi::Object opts = info[3].As<Napi::Object>();
+        if (opts.Has("cols")) cols = static_cast<size_t>(opts.Get("cols").ToNumber().Int64Value());
+    }
+    if (type == napi_float32_array) return QueueCsrBuild<float>(info, offsets, rows, columns, nnz, cols);
+    return QueueCsrBuild<double>(info, offsets, rows, columns, nnz, cols);
+}
+
+// Reads (offsets, edges) Int32Array arguments into a CsrGraph view, or throws a TypeError.
+// Offsets and edges are validated by the graph kernels.
+static bool GetGraphArguments(const Napi::CallbackInfo& info, CsrGraph& graph) {
+    Napi::Env env = info.Env();
+    auto offsets = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return false;
+    auto edges = GetInt32ArrayArgument(info, 1);
+    if (env.IsExceptionPending()) return false;
+    if (offsets.ElementLength() == 0) {
+        Napi::TypeError::New(env, "offsets must hold vertices + 1 entries").ThrowAsJavaScriptException();
+        return false;
+    }
+    graph = CsrGraph{ offsets.Data(), offsets.ElementLength() - 1, edges.Data(), edges.ElementLength() };
+    return true;
+}
+
+// Resolves a graph kernel result as an Int32Array
+static void ResolveVertexArray(Napi::Env env, Napi::Promise::Deferred& def, const std::shared_ptr<std::vector<int32_t>>& res, const std::string& err) {
+    if (!err.empty()) {
+        def.Reject(Napi::String::New(env, err));
+        return;
+    }
+    Napi::Int32Array arr = Napi::Int32Array::New(env, res->size());
+    memcpy(arr.Data(), res->data(), res->size() * sizeof(int32_t));
+    def.Resolve(arr);
+}
+
+/**
+ * @brief Breadth-first search levels over a CSR graph.
+ *
+ * Arguments: (offsets, edges, source, { symmetric }?). offsets (vertices + 1) and edges are
+ * Int32Arrays; set symmetric when every edge is stored in both directions, which spares the
+ * transpose the bottom-up steps would otherwise build. Returns a Promise with an Int32Array of
+ * levels (-1 = unreachable).
+ *
+ */
+Napi::Value Bfs(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    CsrGraph graph;
+    if (!GetGraphArguments(info, graph)) return env.Null();
+    if (info.Length() < 3 || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Expected a source vertex at argument 2").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    int64_t source = info[2].As<Napi::Number>().Int64Value();
+    if (source < 0 || static_cast<size_t>(source) >= graph.vertices) {
+        Napi::RangeError::New(env, "source must be a vertex in [0, offsets.length - 1)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    bool symmetric = false;
+    if (info.Length() > 3 && info[3].IsObject()) {
+        Napi::Object opts = info[3].As<Napi::Object>();
+        if (opts.Has("symmetric")) symmetric = opts.Get("symmetric").ToBoolean().Value();
+    }
+    auto retained = RetainArguments(info, {0, 1});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<int32_t>>>(
+        env,
+        [graph, source, symmetric](std::shared_ptr<std::vector<int32_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_bfs(graph, static_cast<size_t>(source), symmetric);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<int32_t>>& res, const std::string &err){
+            ResolveVertexArray(env, def, res, err);
+        }
+    );
+}
+
+/**
+ * @brief Connected components of a CSR graph, with edges treated as undirected.
+ *
+ * Arguments: (offsets, edges) as for bfs. Returns a Promise with an Int32Array that labels
+ * every vertex with the smallest vertex id of its component.
+ *
+ */
+Napi::Value ConnectedComponents(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    CsrGraph graph;
+    if (!GetGraphArguments(info, graph)) return env.Null();
+    auto retained = RetainArguments(info, {0, 1});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<int32_t>>>(
+        env,
+        [graph](std::shared_ptr<std::vector<int32_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_connected_components(graph);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<int32_t>>& res, const std::string &err){
+            ResolveVertexArray(env, def, res, err);
+        }
+    );
+}
+
+// Queues hpx_kmeans<T> over the points at argument 0
+template <typename T>
+static Napi::Value QueueKMeans(const Napi::CallbackInfo& info, size_t dim, size_t k, KMeansOptions options) {
+    Napi::Env env = info.Env();
+    auto points = info[0].As<Napi::TypedArrayOf<T>>();
+    const T* pointsPtr = points.Data();
+    size_t count = points.ElementLength() / dim;
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<KMeansResult<T>>(
+        env,
+        [pointsPtr, count, dim, k, options](KMeansResult<T>& res, std::string &err){
+            try {
+                auto fut = hpx_kmeans<T>(pointsPtr, count, dim, k, options);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, KMeansResult<T>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            auto centroids = Napi::TypedArrayOf<T>::New(env, res.centroids->size());
+            memcpy(centroids.Data(), res.centroids->data(), res.centroids->size() * sizeof(T));
+            Napi::Int32Array assignments = Napi::Int32Array::New(env, res.assignments->size());
+            memcpy(assignments.Data(), res.assignments->data(), res.assignments->size() * sizeof(int32_t));
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("centroids", centroids);
+            obj.Set("assignments", assignments);
+            obj.Set("inertia", Napi::Number::New(env, res.inertia));
+            obj.Set("iterations", Napi::Number::New(env, static_cast<double>(res.iterations)));
+            obj.Set("converged", Napi::Boolean::New(env, res.converged));
+            def.Resolve(obj);
+        }
+    );
+}
+
+/**
+ * @brief k-means clustering of row-major points.
+ *
+ * Arguments: (points, dim, k, { iters, seed, init, tolerance }?). points is a Float32Array or
+ * Float64Array of n * dim values; init is "kmeans++" (default) or "random", iters caps the
+ * centroid updates (default 100) and tolerance is the relative inertia improvement below which
+ * iteration stops (default 1e-4). Returns a Promise with { centroids, assignments, inertia,
+ * iterations, converged }; centroids has the type of points.
+ *
+ */
+Napi::Value KMeans(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    napi_typedarray_type type = info.Length() > 0 ? FloatArrayType(info[0]) : napi_int8_array;
+    if (type == napi_int8_array || info.Length() < 3 || !info[1].IsNumber() || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Expected (points: Float32Array|Float64Array, dim, k)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    int64_t dim = info[1].As<Napi::Number>().Int64Value();
+    int64_t k = info[2].As<Napi::Number>().Int64Value();
+    size_t length = info[0].As<Napi::TypedArray>().ElementLength();
+    if (dim <= 0 || length % static_cast<size_t>(dim) != 0) {
+        Napi::RangeError::New(env, "points.length must be a positive multiple of dim").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (k <= 0 || static_cast<size_t>(k) > length / static_cast<size_t>(dim)) {
+        Napi::RangeError::New(env, "k must be in [1, number of points]").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    KMeansOptions options;
+    if (info.Length() > 3 && info[3].IsObject()) {
+        Napi::Object opts = info[3].As<Napi::Object>();
+        if (opts.Has("iters")) options.maxIterations = static_cast<size_t>(std::max<int64_t>(0, opts.Get("iters").ToNumber().Int64Value()));
+        if (opts.Has("seed")) options.seed = static_cast<uint64_t>(opts.Get("seed").ToNumber().Int64Value());
+        if (opts.Has("tolerance")) options.tolerance = opts.Get("tolerance").ToNumber().DoubleValue();
+        if (opts.Has("init")) {
+            std::string init = opts.Get("init").ToString().Utf8Value();
+            if (init == "kmeans++") options.init = KMeansInit::PlusPlus;
+            else if (init == "random") options.init = KMeansInit::Random;
+            else {
+                Napi::TypeError::New(env, "init must be 'kmeans++' or 'random'").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+        }
+    }
+    if (type == napi_float32_array) return QueueKMeans<float>(info, static_cast<size_t>(dim), static_cast<size_t>(k), options);
+    return QueueKMeans<double>(info, static_cast<size_t>(dim), static_cast<size_t>(k), options);
+}
+
+/**
+ * @brief Aggregates a time series into fixed-width time buckets.
+ *
+ * Arguments: (timestamps, values, { bucketMs, agg, start, end, out }). timestamps (ascending)
+ * and values are Float64Arrays of one length; agg is "mean" (default), "sum", "min", "max",
+ * "count", "first" or "last". Bucket i covers [start + i * bucketMs, start + (i + 1) * bucketMs);
+ * start defaults to the first timestamp rounded down to a multiple of bucketMs, and the buckets
+ * run up to 'end' (exclusive) or, by default, through the last timestamp. Returns a Promise with
+ * one Float64 value per bucket, written into 'out' if given (it must not overlap the inputs).
+ *
+ */
+Napi::Value Resample(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 3 || FloatArrayType(info[0]) != napi_float64_array || FloatArrayType(info[1]) != napi_float64_array || !info[2].IsObject()) {
+        Napi::TypeError::New(env, "Expected (timestamps: Float64Array, values: Float64Array, { bucketMs })").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto timestamps = info[0].As<Napi::Float64Array>();
+    auto values = info[1].As<Napi::Float64Array>();
+    size_t size = timestamps.ElementLength();
+    if (values.ElementLength() != size) {
+        Napi::RangeError::New(env, "timestamps and values must have the same length").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Object opts = info[2].As<Napi::Object>();
+    double bucketMs = opts.Has("bucketMs") ? opts.Get("bucketMs").ToNumber().DoubleValue() : 0.0;
+    if (!(bucketMs > 0.0) || !std::isfinite(bucketMs)) {
+        Napi::RangeError::New(env, "bucketMs must be a positive number").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    ResampleAgg agg = ResampleAgg::Mean;
+    if (opts.Has("agg")) {
+        std::string name = opts.Get("agg").ToString().Utf8Value();
+        if (name == "mean") agg = ResampleAgg::Mean;
+        else if (name == "sum") agg = ResampleAgg::Sum;
+        else if (name == "min") agg = ResampleAgg::Min;
+        else if (name == "max") agg = ResampleAgg::Max;
+        else if (name == "count") agg = ResampleAgg::Count;
+        else if (name == "first") agg = ResampleAgg::First;
+        else if (name == "last") agg = ResampleAgg::Last;
+        else {
+            Napi::TypeError::New(env, "Unknown resample agg: " + name).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+    }
+    const double* tsPtr = timestamps.Data();
+    double start = 0.0;
+    if (opts.Has("start")) start = opts.Get("start").ToNumber().DoubleValue();
+    else if (size > 0) start = std::floor(tsPtr[0] / bucketMs) * bucketMs;
+    double span = 0.0;
+    if (opts.Has("end")) span = std::ceil((opts.Get("end").ToNumber().DoubleValue() - start) / bucketMs);
+    else if (size > 0 && tsPtr[size - 1] >= start) span = std::floor((tsPtr[size - 1] - start) / bucketMs) + 1.0;
+    if (!std::isfinite(start) || !(span < 2147483648.0)) {
+        Napi::RangeError::New(env, "start/end must be finite and span fewer than 2^31 buckets").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t buckets = span > 0.0 ? static_cast<size_t>(span) : 0;
+    Napi::TypedArray output = FloatOutputArray(env, opts.Get("out"), napi_float64_array, buckets);
+    if (env.IsExceptionPending()) return env.Null();
+    if (TypedArraysOverlap(output, timestamps) || TypedArraysOverlap(output, values)) {
+        Napi::RangeError::New(env, "out must not overlap timestamps or values").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    double* outPtr = output.As<Napi::Float64Array>().Data();
+    const double* valuesPtr = values.Data();
+    auto retained = RetainArguments(info, {0, 1});
+    auto outRef = std::make_shared<Napi::ObjectReference>(Napi::Persistent(output.As<Napi::Object>()));
+
+    return QueueAsyncWork(
+        env,
+        [tsPtr, valuesPtr, size, start, bucketMs, agg, outPtr, buckets](std::string &err){
+            try {
+                hpx_resample(tsPtr, valuesPtr, size, start, bucketMs, agg, outPtr, buckets).get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, outRef](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(outRef->Value());
+        }
+    );
+}
+
+/**
+ * @brief Downsamples a series for plotting with Largest-Triangle-Three-Buckets.
+ *
+ * Arguments: (x, y, targetPoints, { out }?). x (ascending) and y are Float64Arrays of one length.
+ * Returns a Promise with a Uint32Array of min(targetPoints, length) ascending indices of the
+ * kept points (first and last included), written into 'out' if given.
+ *
+ */
+Napi::Value DownsampleLTTB(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 3 || FloatArrayType(info[0]) != napi_float64_array || FloatArrayType(info[1]) != napi_float64_array || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Expected (x: Float64Array, y: Float64Array, targetPoints)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto x = info[0].As<Napi::Float64Array>();
+    auto y = info[1].As<Napi::Float64Array>();
+    size_t size = x.ElementLength();
+    if (y.ElementLength() != size) {
+        Napi::RangeError::New(env, "x and y must have the same length").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    int64_t target = info[2].As<Napi::Number>().Int64Value();
+    if (target < 2) {
+        Napi::RangeError::New(env, "targetPoints must be at least 2").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t kept = std::min(size, static_cast<size_t>(target));
+    Napi::Value out = (info.Length() > 3 && info[3].IsObject()) ? info[3].As<Napi::Object>().Get("out") : env.Undefined();
+    Napi::Uint32Array output;
+    if (out.IsUndefined()) {
+        output = Napi::Uint32Array::New(env, kept);
+    } else if (out.IsTypedArray() && out.As<Napi::TypedArray>().TypedArrayType() == napi_uint32_array &&
+               out.As<Napi::TypedArray>().ElementLength() == kept) {
+        output = out.As<Napi::Uint32Array>();
+    } else {
+        Napi::TypeError::New(env, "out must be a Uint32Array with " + std::to_string(kept) + " elements").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    const double* xPtr = x.Data();
+    const double* yPtr = y.Data();
+    uint32_t* outPtr = output.Data();
+    auto retained = RetainArguments(info, {0, 1});
+    auto outRef = std::make_shared<Napi::ObjectReference>(Napi::Persistent(output.As<Napi::Object>()));
+
+    return QueueAsyncWork(
+        env,
+        [xPtr, yPtr, size, kept, outPtr](std::string &err){
+            try {
+                hpx_lttb(xPtr, yPtr, size, kept, outPtr).get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, outRef](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(outRef->Value());
+        }
+    );
+}
+
+/**
+ * @brief As-of join of two sorted time series.
+ *
+ * Arguments: (leftTs, rightTs, { tolerance, allowExactMatches, out }?) with ascending Float64Array
+ * timestamps. For every left timestamp, finds the last right timestamp <= it (< it when
+ * allowExactMatches is false) that lies within 'tolerance' (default: unlimited). Returns a
+ * Promise with an Int32Array of matched right indices (-1 = no match), written into 'out' if given.
+ *
+ */
+Napi::Value AsofJoin(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || FloatArrayType(info[0]) != napi_float64_array || FloatArrayType(info[1]) != napi_float64_array) {
+        Napi::TypeError::New(env, "Expected (leftTs: Float64Array, rightTs: Float64Array)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto left = info[0].As<Napi::Float64Array>();
+    auto right = info[1].As<Napi::Float64Array>();
+    double tolerance = std::numeric_limits<double>::infinity();
+    bool allowExact = true;
+    Napi::Value out = env.Undefined();
+    if (info.Length() > 2 && info[2].IsObject()) {
+        Napi::Object opts = info[2].As<Napi::Object>();
+        if (opts.Has("tolerance")) tolerance = opts.Get("tolerance").ToNumber().DoubleValue();
+        if (opts.Has("allowExactMatches")) allowExact = opts.Get("allowExactMatches").ToBoolean().Value();
+        out = opts.Get("out");
+    }
+    if (!(tolerance >= 0.0)) {
+        Napi::RangeError::New(env, "tolerance must be a non-negative number").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t leftSize = left.ElementLength();
+    Napi::Int32Array output;
+    if (out.IsUndefined()) {
+        output = Napi::Int32Array::New(env, leftSize);
+    } else if (out.IsTypedArray() && out.As<Napi::TypedArray>().TypedArrayType() == napi_int32_array &&
+               out.As<Napi::TypedArray>().ElementLength() == leftSize) {
+        output = out.As<Napi::Int32Array>();
+    } else {
+        Napi::TypeError::New(env, "out must be an Int32Array with " + std::to_string(leftSize) + " elements").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    const double* leftPtr = left.Data();
+    const double* rightPtr = right.Data();
+    size_t rightSize = right.ElementLength();
+    int32_t* outPtr = output.Data();
+    auto retained = RetainArguments(info, {0, 1});
+    auto outRef = std::make_shared<Napi::ObjectReference>(Napi::Persistent(output.As<Napi::Object>()));
+
+    return QueueAsyncWork(
+        env,
+        [leftPtr, leftSize, rightPtr, rightSize, tolerance, allowExact, outPtr](std::string &err){
+            try {
+                hpx_asof_join(leftPtr, leftSize, rightPtr, rightSize, tolerance, allowExact, outPtr).get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, outRef](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(outRef->Value());
+        }
+    );
+}
+
+// Queues hpx_parse_numbers<T> over the bytes at argument 0, or over the file it names
+template <typename T>
+static Napi::Value QueueParseNumbers(const Napi::CallbackInfo& info, ParseOptions options) {
+    Napi::Env env = info.Env();
+    std::string path;
+    const char* text = nullptr;
+    size_t size = 0;
+    if (info[0].IsString()) {
+        path = info[0].As<Napi::String>().Utf8Value();
+    } else {
+        auto bytes = info[0].As<Napi::Uint8Array>();
+        text = reinterpret_cast<const char*>(bytes.Data());
+        size = bytes.ElementLength();
+    }
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<T>>>(
+        env,
+        [path, text, size, options](std::shared_ptr<std::vector<T>>& res, std::string &err){
+            try {
+                auto fut = path.empty() ? hpx_parse_numbers<T>(text, size, options) : hpx_parse_numbers_file<T>(path, options);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<T>>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            auto arr = Napi::TypedArrayOf<T>::New(env, res->size());
+            memcpy(arr.Data(), res->data(), res->size() * sizeof(T));
+            def.Resolve(arr);
+        }
+    );
+}
+
+/**
+ * @brief Parses one numeric column of CSV/TSV text into a typed array.
+ *
+ * Arguments: (bufferOrPath, { delimiter, column, type, header }?). The text is a Uint8Array
+ * (e.g. a Buffer) or the path of a file, which is memory-mapped instead of being read into JS.
+ * delimiter is a single character (default ","), column a zero-based field index (default 0),
+ * type "int32" (default), "float32" or "float64", and header skips the first line. Returns a
+ * Promise with one value per non-empty line.
+ */
+Napi::Value ParseNumbers(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    bool isBytes = info.Length() > 0 && info[0].IsTypedArray() &&
+                   info[0].As<Napi::TypedArray>().TypedArrayType() == napi_uint8_array;
+    if (info.Length() < 1 || (!isBytes && !info[0].IsString())) {
+        Napi::TypeError::New(env, "Expected a Uint8Array/Buffer or a file path at argument 0").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (info[0].IsString() && info[0].As<Napi::String>().Utf8Value().empty()) {
+        Napi::TypeError::New(env, "File path must not be empty").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    ParseOptions options;
+    std::string type = "int32";
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        if (opts.Has("delimiter")) {
+            std::string delimiter = opts.Get("delimiter").ToString().Utf8Value();
+            if (delimiter.size() != 1 || delimiter[0] == '\n') {
+                Napi::TypeError::New(env, "delimiter must be a single character").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            options.delimiter = delimiter[0];
+        }
+        if (opts.Has("column")) {
+            int64_t column = opts.Get("column").ToNumber().Int64Value();
+            if (column < 0) {
+                Napi::RangeError::New(env, "column must be non-negative").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            options.column = static_cast<size_t>(column);
+        }
+        if (opts.Has("header")) options.header = opts.Get("header").ToBoolean().Value();
+        if (opts.Has("type")) type = opts.Get("type").ToString().Utf8Value();
+    }
+    if (type == "int32") return QueueParseNumbers<int32_t>(info, options);
+    if (type == "float32") return QueueParseNumbers<float>(info, options);
+    if (type == "float64") return QueueParseNumbers<double>(info, options);
+    Napi::TypeError::New(env, "type must be 'int32', 'float32' or 'float64'").ThrowAsJavaScriptException();
+    return env.Null();
+}
+
+static bool IsBytes(const Napi::Value& value) {
+    return value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() == napi_uint8_array;
+}
+
+// Runs a byte scan on HPX, keeping the scanned buffer alive, and resolves with its offsets
+template <typename Scan>
+static Napi::Value QueueByteScan(const Napi::CallbackInfo& info, Scan scan) {
+    Napi::Env env = info.Env();
+    auto retained = RetainArguments(info, {0});
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint32_t>>>(
+        env,
+        [scan](std::shared_ptr<std::vector<uint32_t>>& res, std::string &err){
+            try {
+                auto fut = scan();
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint32_t>>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            auto arr = Napi::Uint32Array::New(env, res->size());
+            memcpy(arr.Data(), res->data(), res->size() * sizeof(uint32_t));
+            def.Resolve(arr);
+        }
+    );
+}
+
+/**
+ * @brief Returns the offset of every '\n' in a Uint8Array/Buffer as an ascending Uint32Array.
+ */
+Napi::Value IndexLines(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !IsBytes(info[0])) {
+        Napi::TypeError::New(env, "Expected a Uint8Array/Buffer at argument 0").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto bytes = info[0].As<Napi::Uint8Array>();
+    const char* text = reinterpret_cast<const char*>(bytes.Data());
+    size_t size = bytes.ElementLength();
+    return QueueByteScan(info, [text, size]() { return hpx_index_lines(text, size); });
+}
+
+/**
+ * @brief Returns the offsets of all (possibly overlapping) occurrences of a pattern.
+ *
+ * Arguments: (bytes, pattern) where bytes is a Uint8Array/Buffer and pattern a non-empty string
+ * (matched as UTF-8) or Uint8Array. Resolves to an ascending Uint32Array.
+ */
+Napi::Value SearchBytes(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !IsBytes(info[0]) || (!info[1].IsString() && !IsBytes(info[1]))) {
+        Napi::TypeError::New(env, "Expected a Uint8Array/Buffer and a string or Uint8Array pattern").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    std::string pattern;
+    if (info[1].IsString()) {
+        pattern = info[1].As<Napi::String>().Utf8Value();
+    } else {
+        auto bytes = info[1].As<Napi::Uint8Array>();
+        pattern.assign(reinterpret_cast<const char*>(bytes.Data()), bytes.ElementLength());
+    }
+    if (pattern.empty()) {
+        Napi::RangeError::New(env, "Search pattern must not be empty").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto bytes = info[0].As<Napi::Uint8Array>();
+    const char* text = reinterpret_cast<const char*>(bytes.Data());
+    size_t size = bytes.ElementLength();
+    return QueueByteScan(info, [text, size, pattern]() { return hpx_search_bytes(text, size, pattern); });
+}
+
+/**
+ * @brief Writes resident buffers and value indexes to a snapshot file.
+ *
+ * Arguments: path, { buffers: { name: ResidentBuffer }, indexes: { name: ValueIndex } }.
+ * Resolves to true once the file has been synced and renamed into place.
+ */
+Napi::Value SaveSnapshot(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Expected a file path and an object with buffers and/or indexes").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    std::string path = info[0].As<Napi::String>().Utf8Value();
+    if (path.empty()) {
+        Napi::TypeError::New(env, "File path must not be empty").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Object opts = info[1].As<Napi::Object>();
+    Snapshot snapshot;
+    // Each group is a plain object mapping names to native handles of one class
+    auto collect = [&](const char* key, auto fromValue, auto& out) {
+        if (!opts.Has(key) || opts.Get(key).IsUndefined()) return true;
+        if (!opts.Get(key).IsObject()) {
+            Napi::TypeError::New(env, std::string(key) + " must be an object").ThrowAsJavaScriptException();
+            return false;
+        }
+        Napi::Object group = opts.Get(key).As<Napi::Object>();
+        Napi::Array names = group.GetPropertyNames();
+        for (uint32_t i = 0; i < names.Length(); ++i) {
+            std::string name = names.Get(i).ToString().Utf8Value();
+            auto handle = fromValue(group.Get(name));
+            if (!handle) {
+                Napi::TypeError::New(env, std::string(key) + "." + name + " has the wrong type").ThrowAsJavaScriptException();
+                return false;
+            }
+            out.emplace_back(name, handle);
+        }
+        return true;
+    };
+    if (!collect("buffers", ResidentBufferObject::FromValue, snapshot.buffers)) return env.Null();
+    if (!collect("indexes", ValueIndexObject::FromValue, snapshot.indexes)) return env.Null();
+
+    return QueueAsyncWork(
+        env,
+        [path, snapshot](std::string &err){
+            try {
+                auto fut = hpx_snapshot_save(path, snapshot);
+                fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(Napi::Boolean::New(env, true));
+        }
+    );
+}
+
+/**
+ * @brief Maps a snapshot file written by saveSnapshot.
+ *
+ * Arguments: path, optional { verify } (default false: only the header and entry table are
+ * checksummed, column pages are read on first use). Resolves to { buffers, indexes } holding
+ * new ResidentBuffer and ValueIndex objects backed by a copy-on-write mapping of the file.
+ */
+Napi::Value LoadSnapshot(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected a file path at argument 0").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    std::string path = info[0].As<Napi::String>().Utf8Value();
+    if (path.empty()) {
+        Napi::TypeError::New(env, "File path must not be empty").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    bool verify = false;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        if (opts.Has("verify")) verify = opts.Get("verify").ToBoolean().Value();
+    }
+
+    return QueueAsyncWork<Snapshot>(
+        env,
+        [path, verify](Snapshot& res, std::string &err){
+            try {
+                auto fut = hpx_snapshot_load(path, verify);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, Snapshot& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            Napi::Object buffers = Napi::Object::New(env);
+            for (auto& item : res.buffers) buffers.Set(item.first, ResidentBufferObject::NewInstance(env, item.second));
+            Napi::Object indexes = Napi::Object::New(env);
+            for (auto& item : res.indexes) indexes.Set(item.first, ValueIndexObject::NewInstance(env, item.second));
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("buffers", buffers);
+            result.Set("indexes", indexes);
+            def.Resolve(result);
+        }
+    );
+}
+
+/**
+ * @brief Dictionary-encodes strings into Int32 codes.
+ *
+ * Arguments: (bytes, offsets, { sorted }?) where string i is bytes[offsets[i], offsets[i + 1])
+ * and offsets is a Uint32Array/Int32Array with one entry more than there are strings. Resolves
+ * to { codes: Int32Array, dictionary: { bytes: Uint8Array, offsets: Int32Array } }, the dictionary
+ * holding code k's string at the same layout. Codes follow first appearance, or the byte-wise
+ * string order with sorted: true.
+ */
+Napi::Value DictEncode(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t offsetsLength = 0;
+    const uint32_t* offsets = info.Length() > 1 ? IndexArrayData(info[1], offsetsLength) : nullptr;
+    if (info.Length() < 2 || !IsBytes(info[0]) || !offsets) {
+        Napi::TypeError::New(env, "Expected a Uint8Array/Buffer and offsets as a Uint32Array/Int32Array").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (offsetsLength == 0) {
+        Napi::RangeError::New(env, "offsets must hold at least one entry").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    bool sorted = false;
+    if (info.Length() > 2 && info[2].IsObject()) {
+        Napi::Object opts = info[2].As<Napi::Object>();
+        if (opts.Has("sorted")) sorted = opts.Get("sorted").ToBoolean().Value();
+    }
+    auto bytes = info[0].As<Napi::Uint8Array>();
+    const char* text = reinterpret_cast<const char*>(bytes.Data());
+    size_t byteLength = bytes.ElementLength();
+    size_t count = offsetsLength - 1;
+    auto retained = RetainArguments(info, {0, 1});
+
+    return QueueAsyncWork<DictEncoding>(
+        env,
+        [text, byteLength, offsets, count, sorted](DictEncoding& res, std::string &err){
+            try {
+                auto fut = hpx_dict_encode(text, byteLength, offsets, count, sorted);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, DictEncoding& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            auto codes = Napi::Int32Array::New(env, res.codes->size());
+            memcpy(codes.Data(), res.codes->data(), res.codes->size() * sizeof(int32_t));
+            auto dictBytes = Napi::Uint8Array::New(env, res.bytes->size());
+            memcpy(dictBytes.Data(), res.bytes->data(), res.bytes->size());
+            auto dictOffsets = Napi::Int32Array::New(env, res.offsets->size());
+            memcpy(dictOffsets.Data(), res.offsets->data(), res.offsets->size() * sizeof(int32_t));
+            Napi::Object dictionary = Napi::Object::New(env);
+            dictionary.Set("bytes", dictBytes);
+            dictionary.Set("offsets", dictOffsets);
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("codes", codes);
+            result.Set("dictionary", dictionary);
+            def.Resolve(result);
+        }
+    );
+}
+
+/**
+ * @brief Compresses an Int32Array with frame-of-reference bit-packing.
+ *
+ * Arguments: (array, { delta }?). Blocks of 1024 values are packed at the bit width of their
+ * value range; with delta: true the differences between neighbours are packed, which suits
+ * sorted IDs and timestamps. Resolves to a Uint8Array in the format read by decodeBitpacked;
+ * it carries per-block headers (min, max, bit width, offset) so ranges decode block by block.
+ */
+Napi::Value EncodeBitpacked(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    bool delta = false;
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        if (opts.Has("delta")) delta = opts.Get("delta").ToBoolean().Value();
+    }
+    const int32_t* data = inputArr.Data();
+    size_t size = inputArr.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint8_t>>>(
+        env,
+        [data, size, delta](std::shared_ptr<std::vector<uint8_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_bitpack_encode(data, size, delta);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint8_t>>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            auto bytes = Napi::Uint8Array::New(env, res->size());
+            memcpy(bytes.Data(), res->data(), res->size());
+            def.Resolve(bytes);
+        }
+    );
+}
+
+/**
+ * @brief Decodes a column produced by encodeBitpacked.
+ *
+ * Arguments: (bytes, { begin, end }?). Only the blocks overlapping [begin, end) are unpacked,
+ * in parallel; end defaults to the column length. Resolves to an Int32Array, or rejects if the
+ * bytes are not a valid bit-packed column.
+ */
+Napi::Value DecodeBitpacked(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !IsBytes(info[0])) {
+        Napi::TypeError::New(env, "Expected bit-packed bytes as a Uint8Array").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t begin = 0, end = std::numeric_limits<size_t>::max();
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        // Clamped in the double domain before converting: NaN and negatives mean 0, and anything
+        // past 2^53 (including Infinity) is past every column, which hpx_bitpack_decode clamps to
+        auto position = [](double value) {
+            return value > 0.0 ? static_cast<size_t>(std::min(value, 9007199254740992.0)) : size_t(0);
+        };
+        if (opts.Has("begin") && opts.Get("begin").IsNumber()) begin = position(opts.Get("begin").As<Napi::Number>().DoubleValue());
+        if (opts.Has("end") && opts.Get("end").IsNumber()) end = position(opts.Get("end").As<Napi::Number>().DoubleValue());
+    }
+    auto bytes = info[0].As<Napi::Uint8Array>();
+    const uint8_t* data = bytes.Data();
+    size_t byteLength = bytes.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<int32_t>>>(
+        env,
+        [data, byteLength, begin, end](std::shared_ptr<std::vector<int32_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_bitpack_decode(BitpackedColumn::Parse(data, byteLength), begin, end);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<int32_t>>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            Napi::Int32Array arr = Napi::Int32Array::New(env, res->size());
+            memcpy(arr.Data(), res->data(), res->size()*sizeof(int32_t));
+            def.Resolve(arr);
+        }
+    );
+}
+
+// Shared by the bitpacked* queries: parses the column in argument 0 on the worker thread and
+// resolves run(column) as a Number; invalid bytes reject
+template <typename Run>
+static Napi::Value QueueBitpackedQuery(const Napi::CallbackInfo& info, Run run) {
+    Napi::Env env = info.Env();
+    const uint8_t* data = info[0].As<Napi::Uint8Array>().Data();
+    size_t byteLength = info[0].As<Napi::Uint8Array>().ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<int64_t>(
+        env,
+        [data, byteLength, run](int64_t &res, std::string &err){
+            try {
+                auto fut = run(BitpackedColumn::Parse(data, byteLength));
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, int64_t &res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(Napi::Number::New(env, (double)res));
+        }
+    );
+}
+
+// Checks (bytes, ...numbers) arguments of the bitpacked* queries; throws a TypeError for wrong
+// types and a RangeError for numbers that are not int32 (which Int32Value() would truncate)
+static bool CheckBitpackedQueryArguments(const Napi::CallbackInfo& info, size_t numbers) {
+    bool ok = info.Length() >= numbers + 1 && IsBytes(info[0]);
+    for (size_t i = 1; ok && i <= numbers; ++i) ok = info[i].IsNumber();
+    if (!ok) {
+        Napi::TypeError::New(info.Env(), numbers == 0 ? "Expected bit-packed bytes as a Uint8Array"
+            : "Expected bit-packed bytes as a Uint8Array followed by " + std::to_string(numbers) + " number(s)").ThrowAsJavaScriptException();
+        return false;
+    }
+    for (size_t i = 1; i <= numbers; ++i) {
+        double value = info[i].As<Napi::Number>().DoubleValue();
+        if (!(value >= INT32_MIN && value <= INT32_MAX) || value != std::floor(value)) {
+            Napi::RangeError::New(info.Env(), "Bit-packed query values must be int32 integers").ThrowAsJavaScriptException();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Counts occurrences of a value in a column produced by encodeBitpacked, without decoding it.
+ *
+ * Arguments: (bytes, value). Blocks whose header min/max exclude the value are skipped, constant
+ * blocks are counted from the header and only the remaining blocks are unpacked, one at a time
+ * into a small per-task buffer. Returns a Promise (Number).
+ */
+Napi::Value BitpackedCount(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!CheckBitpackedQueryArguments(info, 1)) return env.Null();
+    int32_t value = info[1].As<Napi::Number>().Int32Value();
+    return QueueBitpackedQuery(info, [value](BitpackedColumn column) { return hpx_bitpack_count(std::move(column), value); });
+}
+
+/**
+ * @brief Finds the first index of a value in a bit-packed column. Returns a Promise (Number), -1 if not found.
+ */
+Napi::Value BitpackedFind(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!CheckBitpackedQueryArguments(info, 1)) return env.Null();
+    int32_t value = info[1].As<Napi::Number>().Int32Value();
+    return QueueBitpackedQuery(info, [value](BitpackedColumn column) { return hpx_bitpack_find(std::move(column), value); });
+}
+
+/**
+ * @brief Counts values within [lo, hi] (inclusive) in a bit-packed column. Returns a Promise (Number).
+ *
+ * Blocks entirely inside the range are counted from their header without unpacking.
+ */
+Napi::Value BitpackedCountRange(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!CheckBitpackedQueryArguments(info, 2)) return env.Null();
+    int32_t lo = info[1].As<Napi::Number>().Int32Value();
+    int32_t hi = info[2].As<Napi::Number>().Int32Value();
+    return QueueBitpackedQuery(info, [lo, hi](BitpackedColumn column) { return hpx_bitpack_count_range(std::move(column), lo, hi); });
+}
+
+/**
+ * @brief Sums a bit-packed column. Returns a Promise (Number); exact while the sum stays within 2^53.
+ */
+Napi::Value BitpackedSum(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!CheckBitpackedQueryArguments(info, 0)) return env.Null();
+    return QueueBitpackedQuery(info, [](BitpackedColumn column) { return hpx_bitpack_sum(std::move(column)); });
+}
+
+/**
+ * @brief Imports an array exported through the Arrow C Data Interface.
+ *
+ * Arguments: (schemaAddress, arrayAddress) as BigInts pointing at producer-filled ArrowSchema
+ * and ArrowArray structs, e.g. from another native module. The structs are moved (marked
+ * released) and the buffers are used in place; they are released once the returned
+ * ArrowColumn and every result reading it are gone. Supports Int32 ("i") and Boolean ("b").
+ */
+Napi::Value ArrowImport(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    void* schema = info.Length() > 0 ? ArrowColumnObject::AddressFromValue(env, info[0]) : nullptr;
+    if (!schema) {
+        if (!env.IsExceptionPending()) Napi::TypeError::New(env, "Expected schema and array addresses").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    void* array = info.Length() > 1 ? ArrowColumnObject::AddressFromValue(env, info[1]) : nullptr;
+    if (!array) {
+        if (!env.IsExceptionPending()) Napi::TypeError::New(env, "Expected schema and array addresses").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    try {
+        auto column = hpx_arrow_import(static_cast<ArrowSchema*>(schema), static_cast<ArrowArray*>(array));
+        return ArrowColumnObject::NewInstance(env, std::move(column));
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * @brief Counts valid elements equal to a value in an Int32 Arrow array.
+ *
+ * Arguments: (array, value) where array is an ArrowColumn or an apache-arrow style
+ * { values: Int32Array, nullBitmap?, offset?, length? } object (read in place). Resolves to
+ * the count; nulls never match.
+ */
+Napi::Value ArrowCount(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto retained = RetainArguments(info, {0});
+    ArrowColumn column;
+    if (!ArrowColumnObject::FromArgument(info, 0, column, retained)) return env.Null();
+    if (info.Length() < 2 || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected an Arrow array and a number").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    int32_t value = info[1].As<Napi::Number>().Int32Value();
+
+    return QueueAsyncWork<int64_t>(
+        env,
+        [column, value](int64_t& res, std::string &err){
+            try {
+                auto fut = hpx_arrow_count(column, value);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, int64_t& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            def.Resolve(Napi::Number::New(env, (double)res));
+        }
+    );
+}
+
+/**
+ * @brief Sorts an Int32 Arrow array ascending, nulls last.
+ *
+ * Arguments: (array) as for arrowCount. Resolves to a new ArrowColumn.
+ */
+Napi::Value ArrowSort(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto retained = RetainArguments(info, {0});
+    ArrowColumn column;
+    if (!ArrowColumnObject::FromArgument(info, 0, column, retained)) return env.Null();
+
+    return QueueAsyncWork<std::shared_ptr<const ArrowColumn>>(
+        env,
+        [column](std::shared_ptr<const ArrowColumn>& res, std::string &err){
+            try {
+                auto fut = hpx_arrow_sort(column);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<const ArrowColumn>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            def.Resolve(ArrowColumnObject::NewInstance(env, res));
+        }
+    );
+}
+
+/**
+ * @brief Keeps the rows of an Int32 Arrow array selected by a Boolean Arrow mask.
+ *
+ * Arguments: (array, mask) where mask is a Boolean ArrowColumn or a { values: Uint8Array
+ * (bit-packed), nullBitmap?, offset?, length? } object of the same length. Rows whose mask entry
+ * is null or false are dropped; kept rows keep their nulls. Resolves to a new ArrowColumn.
+ */
+Napi::Value ArrowFilter(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto retained = RetainArguments(info, {0, 1});
+    ArrowColumn column, mask;
+    if (!ArrowColumnObject::FromArgument(info, 0, column, retained)) return env.Null();
+    if (!ArrowColumnObject::FromArgument(info, 1, mask, retained)) return env.Null();
+
+    return QueueAsyncWork<std::shared_ptr<const ArrowColumn>>(
+        env,
+        [column, mask](std::shared_ptr<const ArrowColumn>& res, std::string &err){
+            try {
+                auto fut = hpx_arrow_filter(column, mask);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<const ArrowColumn>& res, const std::string &err){
+            if(!err.empty()) { def.Reject(Napi::String::New(env, err)); return; }
+            def.Resolve(ArrowColumnObject::NewInstance(env, res));
+        }
+    );
+}
+
+/**
+ * @brief Loads a kernel plugin (shared library with the C ABI of hpx_kernel_plugin.h).
+ *
+ * Arguments: (path). Its kernels become usable by name in countIf/copyIf (predicates),
+ * sortComp/partialSortComp (comparators and key functions) and transform (maps), where they
+ * run on the HPX workers without calling back into JavaScript. Returns [{ name, kind }] with
+ * kind 'predicate', 'key', 'comparator' or 'map'; loading a library again is a no-op.
+ */
+Napi::Value LoadKernelPlugin(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected the path of a kernel plugin").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    std::vector<std::shared_ptr<const NativeKernel>> kernels;
+    try {
+        kernels = hpx_load_kernel_plugin(info[0].As<Napi::String>().Utf8Value());
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Array result = Napi::Array::New(env, kernels.size());
+    for (size_t i = 0; i < kernels.size(); ++i) {
+        const char* kind = kernels[i]->kind == HPX_KERNEL_PREDICATE ? "predicate"
+                         : kernels[i]->kind == HPX_KERNEL_KEY ? "key"
+                         : kernels[i]->kind == HPX_KERNEL_COMPARATOR ? "comparator" : "map";
+        Napi::Object entry = Napi::Object::New(env);
+        entry.Set("name", kernels[i]->name);
+        entry.Set("kind", kind);
+        result.Set(static_cast<uint32_t>(i), entry);
+    }
+    return result;
+}
+
+/**
+ * @brief Maps every element of an Int32Array through a plugin map kernel.
+ *
+ * Arguments: (array, kernelName). Resolves to a new Int32Array.
+ */
+Napi::Value Transform(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto inputArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    if (info.Length() < 2 || !info[1].IsString()) {
+        Napi::TypeError::New(env, "Expected an Int32Array and a kernel name").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto kernel = GetKernelArgument(info, 1, {HPX_KERNEL_MAP});
+    if (!kernel) return env.Null();
+    const int32_t* data = inputArr.Data();
+    size_t size = inputArr.ElementLength();
+    return QueueKernelArray(info, [data, size, kernel]() { return hpx_kernel_map(data, size, kernel); });
+}
+
+/**
+ * @brief Starts a pool of worker threads that evaluate one batch predicate for countIf/copyIf.
+ *
+ * Arguments: (source, { Worker, workers }?) where source is the text of a batch predicate
+ * (Int32Array -> Uint8Array, 1 = selected) or a self-contained function, which is sent as text
+ * and must not use closures. Worker is the class from node:worker_threads (the addon cannot
+ * load it itself); workers defaults to the number of hardware threads. Returns a PredicatePool
+ * to pass in place of the predicate; close() terminates the workers.
+ */
+Napi::Value CreatePredicatePool(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !(info[0].IsString() || info[0].IsFunction()) || !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Expected predicate source and { Worker, workers }").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Object opts = info[1].As<Napi::Object>();
+    Napi::Value workerClass = opts.Get("Worker");
+    if (!workerClass.IsFunction()) {
+        Napi::TypeError::New(env, "options.Worker must be the Worker class from node:worker_threads").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    size_t workers = std::max(1u, std::thread::hardware_concurrency());
+    if (opts.Has("workers") && !opts.Get("workers").IsUndefined()) {
+        double requested = opts.Get("workers").ToNumber().DoubleValue();
+        if (!(requested >= 1 && requested <= 1024)) {
+            Napi::RangeError::New(env, "options.workers must be between 1 and 1024").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        workers = static_cast<size_t>(requested);
+    }
+    std::string source = info[0].ToString().Utf8Value();
+    return PredicatePoolObject::NewInstance(env, workerClass.As<Napi::Function>(), source, workers);
+}
+
+/**
+ * @brief Builds a Bitmap from a Uint8Array mask (non-zero = set), e.g. the output of bloomQuery.
+ *
+ * Rows are grouped into containers of 65536; containers with more than 4096 rows set keep
+ * 8 KiB of bits, sparser ones a sorted array of their rows. Returns a Promise (Bitmap).
+ */
+Napi::Value BitmapFromMask(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !IsBytes(info[0])) {
+        Napi::TypeError::New(env, "Expected a Uint8Array mask").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto mask = info[0].As<Napi::Uint8Array>();
+    if (mask.ElementLength() > kBitmapMaxSize) {
+        Napi::RangeError::New(env, "Bitmap size exceeds 2^31 - 1 rows").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    const uint8_t* maskPtr = mask.Data();
+    size_t maskSize = mask.ElementLength();
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<const Bitmap>>(
+        env,
+        [maskPtr, maskSize](std::shared_ptr<const Bitmap>& res, std::string &err){
+            try {
+                auto fut = hpx_bitmap_from_mask(maskPtr, maskSize);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<const Bitmap>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(BitmapObject::NewInstance(env, res));
+        }
+    );
+}
+
+/**
+ * @brief Builds a Bitmap of 'size' rows from an Int32Array of row indices (any order, repeats allowed).
+ *
+ * Returns a Promise (Bitmap); rejects if an index is outside [0, size).
+ */
+Napi::Value BitmapFromIndices(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto indicesArr = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    if (info.Length() < 2 || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected the bitmap size as second argument").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    double size = info[1].As<Napi::Number>().DoubleValue();
+    if (!(size >= 0) || size > (double)kBitmapMaxSize || size != std::floor(size)) {
+        Napi::RangeError::New(env, "Bitmap size must be an integer in [0, 2^31 - 1]").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    const int32_t* indicesPtr = indicesArr.Data();
+    size_t indicesSize = indicesArr.ElementLength();
+    size_t bitmapSize = (size_t)size;
+    auto retained = RetainArguments(info, {0});
+
+    return QueueAsyncWork<std::shared_ptr<const Bitmap>>(
+        env,
+        [indicesPtr, indicesSize, bitmapSize](std::shared_ptr<const Bitmap>& res, std::string &err){
+            try {
+                auto fut = hpx_bitmap_from_indices(indicesPtr, indicesSize, bitmapSize);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<const Bitmap>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(BitmapObject::NewInstance(env, res));
+        }
+    );
+}
+
 Napi::Object InitAddon(Napi::Env env, Napi::Object exports) {
+    ValueIndexObject::Init(env);
+    ResidentBufferObject::Init(env);
+    CsrMatrixObject::Init(env);
+    ArrowColumnObject::Init(env);
+    PredicatePoolObject::Init(env);
+    BitmapObject::Init(env);
     exports.Set("initHPX", Napi::Function::New(env, InitHPX));
     exports.Set("finalizeHPX", Napi::Function::New(env, FinalizeHPX));
     exports.Set("sort", Napi::Function::New(env, Sort));
@@ -694,15 +3037,64 @@ Napi::Object InitAddon(Napi::Env env, Napi::Object exports) {
     exports.Set("copy", Napi::Function::New(env, Copy));
     exports.Set("endsWith", Napi::Function::New(env, EndsWith));
     exports.Set("equal", Napi::Function::New(env, Equal));
+    exports.Set("mismatch", Napi::Function::New(env, Mismatch));
+    exports.Set("diffPositions", Napi::Function::New(env, DiffPositions));
     exports.Set("find", Napi::Function::New(env, Find));
     exports.Set("merge", Napi::Function::New(env, Merge));
     exports.Set("partialSort", Napi::Function::New(env, PartialSort));
+    exports.Set("quantiles", Napi::Function::New(env, Quantiles));
     exports.Set("copyN", Napi::Function::New(env, CopyN));
     exports.Set("fill", Napi::Function::New(env, Fill));
     exports.Set("countIf", Napi::Function::New(env, CountIf));
     exports.Set("copyIf", Napi::Function::New(env, CopyIf));
     exports.Set("sortComp", Napi::Function::New(env, SortComp));
     exports.Set("partialSortComp", Napi::Function::New(env, PartialSortComp));
+    exports.Set("buildValueIndex", Napi::Function::New(env, BuildValueIndex));
+    exports.Set("createResidentBuffer", Napi::Function::New(env, CreateResidentBuffer));
+    exports.Set("bloomBuild", Napi::Function::New(env, BloomBuild));
+    exports.Set("bloomQuery", Napi::Function::New(env, BloomQuery));
+    exports.Set("distinctApprox", Napi::Function::New(env, DistinctApprox));
+    exports.Set("hllMerge", Napi::Function::New(env, HllMerge));
+    exports.Set("quantileSketch", Napi::Function::New(env, QuantileSketch));
+    exports.Set("quantileSketchMerge", Napi::Function::New(env, QuantileSketchMerge));
+    exports.Set("quantileSketchQuery", Napi::Function::New(env, QuantileSketchQuery));
+    exports.Set("countApprox", Napi::Function::New(env, CountApprox));
+    exports.Set("countIfApprox", Napi::Function::New(env, CountIfApprox));
+    exports.Set("sumApprox", Napi::Function::New(env, SumApprox));
+    exports.Set("meanApprox", Napi::Function::New(env, MeanApprox));
+    exports.Set("rolling", Napi::Function::New(env, Rolling));
+    exports.Set("convolve", Napi::Function::New(env, Convolve));
+    exports.Set("matmul", Napi::Function::New(env, Matmul));
+    exports.Set("transpose", Napi::Function::New(env, Transpose));
+    exports.Set("spmv", Napi::Function::New(env, Spmv));
+    exports.Set("createCsrMatrix", Napi::Function::New(env, CreateCsrMatrix));
+    exports.Set("bfs", Napi::Function::New(env, Bfs));
+    exports.Set("connectedComponents", Napi::Function::New(env, ConnectedComponents));
+    exports.Set("kmeans", Napi::Function::New(env, KMeans));
+    exports.Set("resample", Napi::Function::New(env, Resample));
+    exports.Set("downsampleLTTB", Napi::Function::New(env, DownsampleLTTB));
+    exports.Set("asofJoin", Napi::Function::New(env, AsofJoin));
+    exports.Set("parseNumbers", Napi::Function::New(env, ParseNumbers));
+    exports.Set("saveSnapshot", Napi::Function::New(env, SaveSnapshot));
+    exports.Set("loadSnapshot", Napi::Function::New(env, LoadSnapshot));
+    exports.Set("indexLines", Napi::Function::New(env, IndexLines));
+    exports.Set("searchBytes", Napi::Function::New(env, SearchBytes));
+    exports.Set("dictEncode", Napi::Function::New(env, DictEncode));
+    exports.Set("encodeBitpacked", Napi::Function::New(env, EncodeBitpacked));
+    exports.Set("decodeBitpacked", Napi::Function::New(env, DecodeBitpacked));
+    exports.Set("bitpackedCount", Napi::Function::New(env, BitpackedCount));
+    exports.Set("bitpackedFind", Napi::Function::New(env, BitpackedFind));
+    exports.Set("bitpackedCountRange", Napi::Function::New(env, BitpackedCountRange));
+    exports.Set("bitpackedSum", Napi::Function::New(env, BitpackedSum));
+    exports.Set("arrowImport", Napi::Function::New(env, ArrowImport));
+    exports.Set("arrowCount", Napi::Function::New(env, ArrowCount));
+    exports.Set("arrowSort", Napi::Function::New(env, ArrowSort));
+    exports.Set("arrowFilter", Napi::Function::New(env, ArrowFilter));
+    exports.Set("loadKernelPlugin", Napi::Function::New(env, LoadKernelPlugin));
+    exports.Set("transform", Napi::Function::New(env, Transform));
+    exports.Set("createPredicatePool", Napi::Function::New(env, CreatePredicatePool));
+    exports.Set("bitmapFromMask", Napi::Function::New(env, BitmapFromMask));
+    exports.Set("bitmapFromIndices", Napi::Function::New(env, BitmapFromIndices));
     return exports;
 }
 
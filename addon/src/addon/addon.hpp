@@ -13,9 +13,12 @@ Napi::Value Count(const Napi::CallbackInfo& info);
 Napi::Value Copy(const Napi::CallbackInfo& info);
 Napi::Value EndsWith(const Napi::CallbackInfo& info);
 Napi::Value Equal(const Napi::CallbackInfo& info);
+Napi::Value Mismatch(const Napi::CallbackInfo& info);
+Napi::Value DiffPositions(const Napi::CallbackInfo& info);
 Napi::Value Find(const Napi::CallbackInfo& info);
 Napi::Value Merge(const Napi::CallbackInfo& info);
 Napi::Value PartialSort(const Napi::CallbackInfo& info);
+Napi::Value Quantiles(const Napi::CallbackInfo& info);
 Napi::Value CopyN(const Napi::CallbackInfo& info);
 Napi::Value Fill(const Napi::CallbackInfo& info);
 Napi::Value CountIf(const Napi::CallbackInfo& info);
@@ -23,6 +26,82 @@ Napi::Value CopyIf(const Napi::CallbackInfo& info);
 Napi::Value SortComp(const Napi::CallbackInfo& info);
 Napi::Value PartialSortComp(const Napi::CallbackInfo& info);
 
+// Index builders
+Napi::Value BuildValueIndex(const Napi::CallbackInfo& info);
+
+// Sketches
+Napi::Value BloomBuild(const Napi::CallbackInfo& info);
+Napi::Value BloomQuery(const Napi::CallbackInfo& info);
+Napi::Value DistinctApprox(const Napi::CallbackInfo& info);
+Napi::Value HllMerge(const Napi::CallbackInfo& info);
+Napi::Value QuantileSketch(const Napi::CallbackInfo& info);
+Napi::Value QuantileSketchMerge(const Napi::CallbackInfo& info);
+Napi::Value QuantileSketchQuery(const Napi::CallbackInfo& info);
+
+// Approximate aggregates (block sampling)
+Napi::Value CountApprox(const Napi::CallbackInfo& info);
+Napi::Value CountIfApprox(const Napi::CallbackInfo& info);
+Napi::Value SumApprox(const Napi::CallbackInfo& info);
+Napi::Value MeanApprox(const Napi::CallbackInfo& info);
+
+// Time series
+Napi::Value Rolling(const Napi::CallbackInfo& info);
+Napi::Value Resample(const Napi::CallbackInfo& info);
+Napi::Value DownsampleLTTB(const Napi::CallbackInfo& info);
+Napi::Value AsofJoin(const Napi::CallbackInfo& info);
+
+// Numeric kernels (Float32/Float64)
+Napi::Value Convolve(const Napi::CallbackInfo& info);
+Napi::Value Matmul(const Napi::CallbackInfo& info);
+Napi::Value Transpose(const Napi::CallbackInfo& info);
+Napi::Value Spmv(const Napi::CallbackInfo& info);
+Napi::Value CreateCsrMatrix(const Napi::CallbackInfo& info);
+
+// Graph kernels
+Napi::Value Bfs(const Napi::CallbackInfo& info);
+Napi::Value ConnectedComponents(const Napi::CallbackInfo& info);
+
+// Clustering (Float32/Float64)
+Napi::Value KMeans(const Napi::CallbackInfo& info);
+
+// Ingestion
+Napi::Value ParseNumbers(const Napi::CallbackInfo& info);
+Napi::Value IndexLines(const Napi::CallbackInfo& info);
+Napi::Value SearchBytes(const Napi::CallbackInfo& info);
+
+// Resident (natively held) data
+Napi::Value CreateResidentBuffer(const Napi::CallbackInfo& info);
+
+// Snapshots of resident buffers and value indexes
+Napi::Value SaveSnapshot(const Napi::CallbackInfo& info);
+Napi::Value LoadSnapshot(const Napi::CallbackInfo& info);
+
+// Encoding
+Napi::Value DictEncode(const Napi::CallbackInfo& info);
+Napi::Value EncodeBitpacked(const Napi::CallbackInfo& info);
+Napi::Value DecodeBitpacked(const Napi::CallbackInfo& info);
+Napi::Value BitpackedCount(const Napi::CallbackInfo& info);
+Napi::Value BitpackedFind(const Napi::CallbackInfo& info);
+Napi::Value BitpackedCountRange(const Napi::CallbackInfo& info);
+Napi::Value BitpackedSum(const Napi::CallbackInfo& info);
+
+// Arrow interop
+Napi::Value ArrowImport(const Napi::CallbackInfo& info);
+Napi::Value ArrowCount(const Napi::CallbackInfo& info);
+Napi::Value ArrowSort(const Napi::CallbackInfo& info);
+Napi::Value ArrowFilter(const Napi::CallbackInfo& info);
+
+// Native kernel plugins
+Napi::Value LoadKernelPlugin(const Napi::CallbackInfo& info);
+Napi::Value Transform(const Napi::CallbackInfo& info);
+
+// Worker-thread predicate pools
+Napi::Value CreatePredicatePool(const Napi::CallbackInfo& info);
+
+// Bitmaps
+Napi::Value BitmapFromMask(const Napi::CallbackInfo& info);
+Napi::Value BitmapFromIndices(const Napi::CallbackInfo& info);
+
 // Initialization of the addon
 Napi::Object InitAddon(Napi::Env env, Napi::Object exports);
 
@@ -0,0 +1,33 @@
+#ifndef ADDON_DATA_HPP
+#define ADDON_DATA_HPP
+
+#include <napi.h>
+
+/**
+ * @brief Per-environment state of the addon, stored with Napi::Env::SetInstanceData.
+ *
+ * The addon can be loaded by several environments (the main thread and worker_threads), so the
+ * JS classes are registered per environment; the references are released with it.
+ */
+struct AddonData {
+    Napi::FunctionReference valueIndexConstructor;
+    Napi::FunctionReference residentBufferConstructor;
+    Napi::FunctionReference csrMatrixConstructor;
+    Napi::FunctionReference arrowColumnConstructor;
+    Napi::FunctionReference predicatePoolConstructor;
+    // FinalizationRegistry terminating the workers of pools collected without close()
+    Napi::ObjectReference predicatePoolRegistry;
+    Napi::FunctionReference bitmapConstructor;
+};
+
+// The state of 'env', created on first use
+inline AddonData& GetAddonData(Napi::Env env) {
+    AddonData* data = env.GetInstanceData<AddonData>();
+    if (!data) {
+        data = new AddonData();
+        env.SetInstanceData(data);   // deleted by the default finalizer at env teardown
+    }
+    return *data;
+}
+
+#endif // ADDON_DATA_HPP
@@ -0,0 +1,178 @@
+#include "arrow_column_object.hpp"
+#include "addon_data.hpp"
+#include "data_conversion.hpp"
+
+#include <napi.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring> // for memcpy
+
+void ArrowColumnObject::Init(Napi::Env env) {
+    Napi::Function cls = DefineClass(env, "ArrowColumn", {
+        InstanceAccessor("length", &ArrowColumnObject::GetLength, nullptr),
+        InstanceAccessor("nullCount", &ArrowColumnObject::GetNullCount, nullptr),
+        InstanceAccessor("type", &ArrowColumnObject::GetType, nullptr),
+        InstanceMethod("exportTo", &ArrowColumnObject::ExportTo),
+        InstanceMethod("toJS", &ArrowColumnObject::ToJS)
+    });
+    GetAddonData(env).arrowColumnConstructor = Napi::Persistent(cls);
+}
+
+Napi::Object ArrowColumnObject::NewInstance(Napi::Env env, std::shared_ptr<const ArrowColumn> column) {
+    // The constructor only accepts this External, so JS code cannot create empty columns
+    auto ext = Napi::External<std::shared_ptr<const ArrowColumn>>::New(env, &column);
+    return GetAddonData(env).arrowColumnConstructor.New({ ext });
+}
+
+bool ArrowColumnObject::FromArgument(const Napi::CallbackInfo& info, size_t index, ArrowColumn& column, RetainedArguments retained) {
+    Napi::Env env = info.Env();
+    if (info.Length() <= index || !info[index].IsObject()) {
+        Napi::TypeError::New(env, "Expected an Arrow array (ArrowColumn or { values, nullBitmap, offset, length }) at argument " +
+                             std::to_string(index)).ThrowAsJavaScriptException();
+        return false;
+    }
+    Napi::Object obj = info[index].As<Napi::Object>();
+    if (obj.InstanceOf(GetAddonData(obj.Env()).arrowColumnConstructor.Value())) {
+        column = *Unwrap(obj)->column_;
+        return true;
+    }
+
+    Napi::Value values = obj.Get("values");
+    napi_typedarray_type type = values.IsTypedArray() ? values.As<Napi::TypedArray>().TypedArrayType() : napi_float64_array;
+    if (type != napi_int32_array && type != napi_uint8_array) {
+        Napi::TypeError::New(env, "Arrow values must be an Int32Array or a bit-packed Uint8Array").ThrowAsJavaScriptException();
+        return false;
+    }
+    int64_t offset = obj.Has("offset") && obj.Get("offset").IsNumber() ? obj.Get("offset").As<Napi::Number>().Int64Value() : 0;
+    size_t elements = values.As<Napi::TypedArray>().ElementLength();
+    int64_t available = type == napi_int32_array ? static_cast<int64_t>(elements) : static_cast<int64_t>(elements) * 8 - offset;
+    int64_t length = obj.Has("length") && obj.Get("length").IsNumber() ? obj.Get("length").As<Napi::Number>().Int64Value() : available;
+    if (offset < 0 || length < 0 || length > available) {
+        Napi::RangeError::New(env, "Arrow offset/length exceed the values buffer").ThrowAsJavaScriptException();
+        return false;
+    }
+
+    column = ArrowColumn{};
+    column.length = static_cast<size_t>(length);
+    if (type == napi_int32_array) {
+        // apache-arrow JS slices fixed-width values to the array, but not the bitmaps
+        column.type = ArrowType::Int32;
+        column.data = values.As<Napi::Int32Array>().Data();
+    } else {
+        column.type = ArrowType::Boolean;
+        column.data = values.As<Napi::Uint8Array>().Data();
+        column.dataOffset = offset;
+    }
+    retained->push_back(Napi::Persistent(values.As<Napi::Object>()));
+
+    Napi::Value bitmap = obj.Get("nullBitmap");
+    if (bitmap.IsTypedArray() && bitmap.As<Napi::TypedArray>().TypedArrayType() == napi_uint8_array) {
+        auto bytes = bitmap.As<Napi::Uint8Array>();
+        // An empty bitmap means "no nulls"
+        if (bytes.ElementLength() > 0 && length > 0) {
+            if (static_cast<int64_t>(bytes.ElementLength()) * 8 < offset + length) {
+                Napi::RangeError::New(env, "Arrow nullBitmap is shorter than offset + length bits").ThrowAsJavaScriptException();
+                return false;
+            }
+            column.validity = bytes.Data();
+            column.validityOffset = offset;
+            retained->push_back(Napi::Persistent(bitmap.As<Napi::Object>()));
+        }
+    } else if (!bitmap.IsNull() && !bitmap.IsUndefined()) {
+        Napi::TypeError::New(env, "Arrow nullBitmap must be a Uint8Array").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+void* ArrowColumnObject::AddressFromValue(Napi::Env env, const Napi::Value& value) {
+    bool lossless = false;
+    uint64_t address = value.IsBigInt() ? value.As<Napi::BigInt>().Uint64Value(&lossless) : 0;
+    if (!lossless || address == 0) {
+        Napi::TypeError::New(env, "Expected a non-zero struct address as a BigInt").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(address));
+}
+
+ArrowColumnObject::ArrowColumnObject(const Napi::CallbackInfo& info) : Napi::ObjectWrap<ArrowColumnObject>(info) {
+    if (info.Length() < 1 || !info[0].IsExternal()) {
+        Napi::TypeError::New(info.Env(), "ArrowColumn cannot be constructed directly; use arrowImport()").ThrowAsJavaScriptException();
+        return;
+    }
+    column_ = *info[0].As<Napi::External<std::shared_ptr<const ArrowColumn>>>().Data();
+}
+
+Napi::Value ArrowColumnObject::GetLength(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)column_->length);
+}
+
+Napi::Value ArrowColumnObject::GetNullCount(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)column_->NullCount());
+}
+
+Napi::Value ArrowColumnObject::GetType(const Napi::CallbackInfo& info) {
+    return Napi::String::New(info.Env(), column_->type == ArrowType::Int32 ? "int32" : "bool");
+}
+
+/**
+ * @brief Exports the array into consumer-allocated ArrowSchema/ArrowArray structs.
+ *
+ * Arguments: (schemaAddress, arrayAddress) as BigInts. The consumer owns the exported copy and
+ * must call its release callback; the buffers stay alive until then.
+ */
+Napi::Value ArrowColumnObject::ExportTo(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    void* schema = info.Length() > 0 ? AddressFromValue(env, info[0]) : nullptr;
+    if (!schema) {
+        if (!env.IsExceptionPending()) Napi::TypeError::New(env, "Expected schema and array addresses").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    void* array = info.Length() > 1 ? AddressFromValue(env, info[1]) : nullptr;
+    if (!array) {
+        if (!env.IsExceptionPending()) Napi::TypeError::New(env, "Expected schema and array addresses").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    try {
+        hpx_arrow_export(column_, static_cast<ArrowSchema*>(schema), static_cast<ArrowArray*>(array));
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return env.Undefined();
+}
+
+/**
+ * @brief Copies the array out as { values, nullBitmap, offset: 0, length, nullCount }.
+ *
+ * values is an Int32Array (one element per row) or, for bool arrays, a bit-packed Uint8Array;
+ * nullBitmap is null when there are no nulls.
+ */
+Napi::Value ArrowColumnObject::ToJS(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const ArrowColumn& c = *column_;
+    auto pack = [&](auto bit) {
+        auto bytes = Napi::Uint8Array::New(env, (c.length + 7) / 8);
+        std::memset(bytes.Data(), 0, bytes.ElementLength());
+        for (size_t i = 0; i < c.length; ++i) {
+            if (bit(i)) bytes[i >> 3] = static_cast<uint8_t>(bytes[i >> 3] | (1u << (i & 7)));
+        }
+        return bytes;
+    };
+    Napi::Object result = Napi::Object::New(env);
+    if (c.type == ArrowType::Int32) {
+        auto values = Napi::Int32Array::New(env, c.length);
+        if (c.length > 0) memcpy(values.Data(), static_cast<const int32_t*>(c.data) + c.dataOffset, c.length * sizeof(int32_t));
+        result.Set("values", values);
+    } else {
+        result.Set("values", pack([&](size_t i) { return c.BoolAt(i); }));
+    }
+    int64_t nulls = c.NullCount();
+    if (nulls > 0) result.Set("nullBitmap", pack([&](size_t i) { return c.IsValid(i); }));
+    else result.Set("nullBitmap", env.Null());
+    result.Set("offset", Napi::Number::New(env, 0));
+    result.Set("length", Napi::Number::New(env, (double)c.length));
+    result.Set("nullCount", Napi::Number::New(env, (double)nulls));
+    return result;
+}
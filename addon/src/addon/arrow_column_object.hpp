@@ -0,0 +1,48 @@
+#ifndef ARROW_COLUMN_OBJECT_HPP
+#define ARROW_COLUMN_OBJECT_HPP
+
+#include "hpx_arrow.hpp"
+#include "data_conversion.hpp"
+#include <napi.h>
+#include <memory>
+
+/**
+ * @brief JavaScript handle for a native Arrow array (returned by arrowImport and the Arrow kernels).
+ *
+ * Buffers are either imported through the C Data Interface or owned natively; they are freed
+ * once the handle and every exported copy (see exportTo) have been released.
+ */
+class ArrowColumnObject : public Napi::ObjectWrap<ArrowColumnObject> {
+public:
+    // Defines the JS class for 'env'; must be called from InitAddon
+    static void Init(Napi::Env env);
+
+    // Wraps an existing column into a new JS object
+    static Napi::Object NewInstance(Napi::Env env, std::shared_ptr<const ArrowColumn> column);
+
+    /**
+     * @brief Reads an Arrow array argument: an ArrowColumn handle, or an apache-arrow style
+     * object { values, nullBitmap?, offset?, length?, nullCount? } read in place.
+     *
+     * Int32Array values give an Int32 column (values[i] is element i); Uint8Array values a
+     * Boolean one (bit offset + i). Bitmap bits start at 'offset'. The typed arrays are added to
+     * 'retained'. Throws a JS TypeError/RangeError and returns false on invalid input.
+     */
+    static bool FromArgument(const Napi::CallbackInfo& info, size_t index, ArrowColumn& column, RetainedArguments retained);
+
+    // Struct address passed as a BigInt, or nullptr after throwing a JS TypeError
+    static void* AddressFromValue(Napi::Env env, const Napi::Value& value);
+
+    explicit ArrowColumnObject(const Napi::CallbackInfo& info);
+
+private:
+    Napi::Value GetLength(const Napi::CallbackInfo& info);
+    Napi::Value GetNullCount(const Napi::CallbackInfo& info);
+    Napi::Value GetType(const Napi::CallbackInfo& info);
+    Napi::Value ExportTo(const Napi::CallbackInfo& info);
+    Napi::Value ToJS(const Napi::CallbackInfo& info);
+
+    std::shared_ptr<const ArrowColumn> column_;
+};
+
+#endif // ARROW_COLUMN_OBJECT_HPP
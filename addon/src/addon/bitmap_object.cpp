@@ -0,0 +1,158 @@
+#include "bitmap_object.hpp"
+#include "addon_data.hpp"
+#include "async_helpers.hpp"
+
+#include <napi.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring> // for memcpy
+
+void BitmapObject::Init(Napi::Env env) {
+    Napi::Function cls = DefineClass(env, "Bitmap", {
+        InstanceAccessor("size", &BitmapObject::GetSize, nullptr),
+        InstanceAccessor("cardinality", &BitmapObject::GetCardinality, nullptr),
+        InstanceMethod("and", &BitmapObject::And),
+        InstanceMethod("or", &BitmapObject::Or),
+        InstanceMethod("xor", &BitmapObject::Xor),
+        InstanceMethod("andNot", &BitmapObject::AndNot),
+        InstanceMethod("toIndices", &BitmapObject::ToIndices),
+        InstanceMethod("toMask", &BitmapObject::ToMask)
+    });
+    GetAddonData(env).bitmapConstructor = Napi::Persistent(cls);
+}
+
+Napi::Object BitmapObject::NewInstance(Napi::Env env, std::shared_ptr<const Bitmap> bitmap) {
+    // The constructor only accepts this External, so JS code cannot create empty bitmaps
+    auto ext = Napi::External<std::shared_ptr<const Bitmap>>::New(env, &bitmap);
+    return GetAddonData(env).bitmapConstructor.New({ ext });
+}
+
+std::shared_ptr<const Bitmap> BitmapObject::FromValue(Napi::Value value) {
+    if (!value.IsObject() || !value.As<Napi::Object>().InstanceOf(GetAddonData(value.Env()).bitmapConstructor.Value())) return nullptr;
+    return Unwrap(value.As<Napi::Object>())->bitmap_;
+}
+
+BitmapObject::BitmapObject(const Napi::CallbackInfo& info) : Napi::ObjectWrap<BitmapObject>(info) {
+    if (info.Length() < 1 || !info[0].IsExternal()) {
+        Napi::TypeError::New(info.Env(), "Bitmap cannot be constructed directly; use bitmapFromMask() or bitmapFromIndices()").ThrowAsJavaScriptException();
+        return;
+    }
+    bitmap_ = *info[0].As<Napi::External<std::shared_ptr<const Bitmap>>>().Data();
+}
+
+Napi::Value BitmapObject::GetSize(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)bitmap_->Size());
+}
+
+Napi::Value BitmapObject::GetCardinality(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)bitmap_->Cardinality());
+}
+
+Napi::Value BitmapObject::Combine(const Napi::CallbackInfo& info, BitmapOp op) {
+    Napi::Env env = info.Env();
+    auto other = info.Length() > 0 ? FromValue(info[0]) : nullptr;
+    if (!other) {
+        Napi::TypeError::New(env, "Expected a Bitmap").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (other->Size() != bitmap_->Size()) {
+        Napi::RangeError::New(env, "Bitmaps have different sizes").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto bitmap = bitmap_;
+
+    return QueueAsyncWork<std::shared_ptr<const Bitmap>>(
+        env,
+        [bitmap, other, op](std::shared_ptr<const Bitmap>& res, std::string &err){
+            try {
+                auto fut = hpx_bitmap_combine(bitmap, other, op);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<const Bitmap>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(BitmapObject::NewInstance(env, res));
+        }
+    );
+}
+
+/**
+ * @brief Rows set in both bitmaps. Returns a Promise (Bitmap).
+ */
+Napi::Value BitmapObject::And(const Napi::CallbackInfo& info) {
+    return Combine(info, BitmapOp::And);
+}
+
+/**
+ * @brief Rows set in either bitmap. Returns a Promise (Bitmap).
+ */
+Napi::Value BitmapObject::Or(const Napi::CallbackInfo& info) {
+    return Combine(info, BitmapOp::Or);
+}
+
+/**
+ * @brief Rows set in exactly one of the bitmaps. Returns a Promise (Bitmap).
+ */
+Napi::Value BitmapObject::Xor(const Napi::CallbackInfo& info) {
+    return Combine(info, BitmapOp::Xor);
+}
+
+/**
+ * @brief Rows set in this bitmap but not in the other. Returns a Promise (Bitmap).
+ */
+Napi::Value BitmapObject::AndNot(const Napi::CallbackInfo& info) {
+    return Combine(info, BitmapOp::AndNot);
+}
+
+/**
+ * @brief Lists the rows that are set. Returns a Promise with an ascending Int32Array.
+ */
+Napi::Value BitmapObject::ToIndices(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto bitmap = bitmap_;
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<int32_t>>>(
+        env,
+        [bitmap](std::shared_ptr<std::vector<int32_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_bitmap_to_indices(bitmap);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<int32_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Int32Array arr = Napi::Int32Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size()*sizeof(int32_t));
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
+/**
+ * @brief Expands the bitmap into a mask. Returns a Promise with a Uint8Array (1 = set).
+ */
+Napi::Value BitmapObject::ToMask(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto bitmap = bitmap_;
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint8_t>>>(
+        env,
+        [bitmap](std::shared_ptr<std::vector<uint8_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_bitmap_to_mask(bitmap);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint8_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Uint8Array arr = Napi::Uint8Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size());
+                def.Resolve(arr);
+            }
+        }
+    );
+}
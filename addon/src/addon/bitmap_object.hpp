@@ -0,0 +1,44 @@
+#ifndef BITMAP_OBJECT_HPP
+#define BITMAP_OBJECT_HPP
+
+#include "hpx_bitmap.hpp"
+#include <napi.h>
+#include <memory>
+
+/**
+ * @brief JavaScript handle for a native Bitmap (returned by bitmapFromMask/bitmapFromIndices).
+ *
+ * size and cardinality are answered synchronously. and/or/xor/andNot resolve to new Bitmap
+ * objects and toIndices/toMask copy the rows out, all on HPX; bitmaps are immutable, so pending
+ * operations never see a change.
+ */
+class BitmapObject : public Napi::ObjectWrap<BitmapObject> {
+public:
+    // Defines the JS class for 'env'; must be called from InitAddon
+    static void Init(Napi::Env env);
+
+    // Wraps an already built bitmap into a new JS object
+    static Napi::Object NewInstance(Napi::Env env, std::shared_ptr<const Bitmap> bitmap);
+
+    // The wrapped bitmap if 'value' is an instance of this class, nullptr otherwise
+    static std::shared_ptr<const Bitmap> FromValue(Napi::Value value);
+
+    explicit BitmapObject(const Napi::CallbackInfo& info);
+
+private:
+    Napi::Value GetSize(const Napi::CallbackInfo& info);
+    Napi::Value GetCardinality(const Napi::CallbackInfo& info);
+    Napi::Value And(const Napi::CallbackInfo& info);
+    Napi::Value Or(const Napi::CallbackInfo& info);
+    Napi::Value Xor(const Napi::CallbackInfo& info);
+    Napi::Value AndNot(const Napi::CallbackInfo& info);
+    Napi::Value ToIndices(const Napi::CallbackInfo& info);
+    Napi::Value ToMask(const Napi::CallbackInfo& info);
+
+    // Shared by and/or/xor/andNot
+    Napi::Value Combine(const Napi::CallbackInfo& info, BitmapOp op);
+
+    std::shared_ptr<const Bitmap> bitmap_;
+};
+
+#endif // BITMAP_OBJECT_HPP
@@ -0,0 +1,102 @@
+#include "csr_matrix_object.hpp"
+#include "addon_data.hpp"
+#include "async_helpers.hpp"
+#include "data_conversion.hpp"
+
+#include <napi.h>
+#include <memory>
+#include <string>
+
+void CsrMatrixObject::Init(Napi::Env env) {
+    Napi::Function cls = DefineClass(env, "CsrMatrix", {
+        InstanceAccessor("rows", &CsrMatrixObject::GetRows, nullptr),
+        InstanceAccessor("cols", &CsrMatrixObject::GetCols, nullptr),
+        InstanceAccessor("nnz", &CsrMatrixObject::GetNonZeros, nullptr),
+        InstanceMethod("multiply", &CsrMatrixObject::Multiply)
+    });
+    GetAddonData(env).csrMatrixConstructor = Napi::Persistent(cls);
+}
+
+Napi::Object CsrMatrixObject::NewInstance(Napi::Env env, CsrMatrixHandle matrix) {
+    // The constructor only accepts this External, so JS code cannot create empty matrices
+    auto ext = Napi::External<CsrMatrixHandle>::New(env, &matrix);
+    return GetAddonData(env).csrMatrixConstructor.New({ ext });
+}
+
+CsrMatrixObject::CsrMatrixObject(const Napi::CallbackInfo& info) : Napi::ObjectWrap<CsrMatrixObject>(info) {
+    if (info.Length() < 1 || !info[0].IsExternal()) {
+        Napi::TypeError::New(info.Env(), "CsrMatrix cannot be constructed directly; use createCsrMatrix()").ThrowAsJavaScriptException();
+        return;
+    }
+    matrix_ = *info[0].As<Napi::External<CsrMatrixHandle>>().Data();
+}
+
+Napi::Value CsrMatrixObject::GetRows(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)(matrix_.f32 ? matrix_.f32->Rows() : matrix_.f64->Rows()));
+}
+
+Napi::Value CsrMatrixObject::GetCols(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)(matrix_.f32 ? matrix_.f32->Cols() : matrix_.f64->Cols()));
+}
+
+Napi::Value CsrMatrixObject::GetNonZeros(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)(matrix_.f32 ? matrix_.f32->NonZeros() : matrix_.f64->NonZeros()));
+}
+
+// Queues y = A * x for a matrix of value type T; x and y are validated by the caller
+template <typename T>
+static Napi::Value QueueMultiply(const Napi::CallbackInfo& info, std::shared_ptr<const CsrMatrix<T>> matrix, Napi::TypedArray output) {
+    Napi::Env env = info.Env();
+    const T* xPtr = info[0].As<Napi::TypedArrayOf<T>>().Data();
+    T* yPtr = output.As<Napi::TypedArrayOf<T>>().Data();
+    auto retained = RetainArguments(info, {0});
+    auto outRef = std::make_shared<Napi::ObjectReference>(Napi::Persistent(output.As<Napi::Object>()));
+
+    return QueueAsyncWork(
+        env,
+        [matrix, xPtr, yPtr](std::string &err){
+            try {
+                hpx_csr_multiply<T>(matrix, xPtr, yPtr).get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained, outRef](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(outRef->Value());
+        }
+    );
+}
+
+/**
+ * @brief Computes y = A * x. x must match the matrix value type and hold 'cols' elements;
+ * y (optional) must match it too, hold 'rows' elements and not overlap x. Returns a Promise with y.
+ */
+Napi::Value CsrMatrixObject::Multiply(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    napi_typedarray_type type = matrix_.f32 ? napi_float32_array : napi_float64_array;
+    size_t rows = matrix_.f32 ? matrix_.f32->Rows() : matrix_.f64->Rows();
+    size_t cols = matrix_.f32 ? matrix_.f32->Cols() : matrix_.f64->Cols();
+    if (info.Length() < 1 || !info[0].IsTypedArray() || info[0].As<Napi::TypedArray>().TypedArrayType() != type ||
+        info[0].As<Napi::TypedArray>().ElementLength() != cols) {
+        Napi::TypeError::New(env, "x must be a typed array of the matrix value type with " + std::to_string(cols) + " elements").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::TypedArray output;
+    if (info.Length() > 1 && !info[1].IsUndefined()) {
+        if (!info[1].IsTypedArray() || info[1].As<Napi::TypedArray>().TypedArrayType() != type ||
+            info[1].As<Napi::TypedArray>().ElementLength() != rows) {
+            Napi::TypeError::New(env, "y must be a typed array of the matrix value type with " + std::to_string(rows) + " elements").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        output = info[1].As<Napi::TypedArray>();
+        if (TypedArraysOverlap(output, info[0].As<Napi::TypedArray>())) {
+            Napi::RangeError::New(env, "y must not overlap x").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+    } else if (matrix_.f32) {
+        output = Napi::Float32Array::New(env, rows);
+    } else {
+        output = Napi::Float64Array::New(env, rows);
+    }
+    if (matrix_.f32) return QueueMultiply<float>(info, matrix_.f32, output);
+    return QueueMultiply<double>(info, matrix_.f64, output);
+}
@@ -0,0 +1,41 @@
+#ifndef CSR_MATRIX_OBJECT_HPP
+#define CSR_MATRIX_OBJECT_HPP
+
+#include "hpx_numeric.hpp"
+#include <napi.h>
+#include <memory>
+
+/**
+ * @brief A resident CSR matrix of either value type; exactly one pointer is set.
+ */
+struct CsrMatrixHandle {
+    std::shared_ptr<const CsrMatrix<float>> f32;
+    std::shared_ptr<const CsrMatrix<double>> f64;
+};
+
+/**
+ * @brief JavaScript handle for a native CsrMatrix (returned by createCsrMatrix).
+ *
+ * The matrix is validated and copied once, so repeated products (e.g. power iterations)
+ * skip the argument checks and the transfer of the CSR arrays.
+ */
+class CsrMatrixObject : public Napi::ObjectWrap<CsrMatrixObject> {
+public:
+    // Defines the JS class for 'env'; must be called from InitAddon
+    static void Init(Napi::Env env);
+
+    // Wraps an existing matrix into a new JS object
+    static Napi::Object NewInstance(Napi::Env env, CsrMatrixHandle matrix);
+
+    explicit CsrMatrixObject(const Napi::CallbackInfo& info);
+
+private:
+    Napi::Value GetRows(const Napi::CallbackInfo& info);
+    Napi::Value GetCols(const Napi::CallbackInfo& info);
+    Napi::Value GetNonZeros(const Napi::CallbackInfo& info);
+    Napi::Value Multiply(const Napi::CallbackInfo& info);
+
+    CsrMatrixHandle matrix_;
+};
+
+#endif // CSR_MATRIX_OBJECT_HPP
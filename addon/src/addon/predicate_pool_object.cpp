@@ -0,0 +1,203 @@
+#include "predicate_pool_object.hpp"
+#include "addon_data.hpp"
+
+#include <napi.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring> // for memcpy
+
+namespace {
+
+// Smallest chunk worth a predicate call in a worker
+constexpr size_t kPoolMinChunk = 16384;
+// Bytes reserved for the first predicate error of a job
+constexpr size_t kPoolErrorCapacity = 1024;
+
+// Runs in every worker (CommonJS, eval: true). Chunks are claimed from the shared status words,
+// so busy workers never hold up idle ones; see MaskJobStatus for the layout.
+const char* kWorkerScript = R"JS(
+const { parentPort, workerData } = require('worker_threads');
+const predicate = (0, eval)('(' + workerData.source + ')');
+if (typeof predicate !== 'function') throw new TypeError('Predicate source must evaluate to a function');
+const encoder = new TextEncoder();
+parentPort.on('message', ({ input, mask, status, error, chunkSize }) => {
+  const chunks = Math.ceil(input.length / chunkSize);
+  for (let c = Atomics.add(status, 0, 1); c < chunks; c = Atomics.add(status, 0, 1)) {
+    if (Atomics.load(status, 2) === 0) {
+      const begin = c * chunkSize;
+      const end = Math.min(input.length, begin + chunkSize);
+      try {
+        const result = predicate(input.subarray(begin, end));
+        if (!(result instanceof Uint8Array) || result.length !== end - begin) {
+          throw new TypeError('Predicate must return a Uint8Array of same length.');
+        }
+        mask.set(result, begin);
+      } catch (e) {
+        if (Atomics.compareExchange(status, 2, 0, 1) === 0) {
+          const { written } = encoder.encodeInto(String(e && e.message !== undefined ? e.message : e), error);
+          Atomics.store(status, 3, written);
+        }
+      }
+    }
+    Atomics.add(status, 1, 1);
+  }
+});
+)JS";
+
+struct PoolSetup {
+    std::shared_ptr<PredicatePoolState> state;
+    Napi::Array workers;
+};
+
+void TerminateWorkers(Napi::Array workers) {
+    for (uint32_t i = 0; i < workers.Length(); ++i) {
+        Napi::Object worker = workers.Get(i).As<Napi::Object>();
+        worker.Get("terminate").As<Napi::Function>().Call(worker, {});
+    }
+}
+
+} // namespace
+
+void PredicatePoolObject::Init(Napi::Env env) {
+    Napi::Function cls = DefineClass(env, "PredicatePool", {
+        InstanceAccessor("size", &PredicatePoolObject::GetSize, nullptr),
+        InstanceMethod("close", &PredicatePoolObject::Close)
+    });
+    GetAddonData(env).predicatePoolConstructor = Napi::Persistent(cls);
+
+    // Finalizers of wrapped objects must not call into JS, so pools dropped without close() are
+    // cleaned up by a FinalizationRegistry holding their worker arrays; its callback runs on the
+    // JS thread
+    auto cleanup = Napi::Function::New(env, [](const Napi::CallbackInfo& info) {
+        if (info.Length() > 0 && info[0].IsArray()) TerminateWorkers(info[0].As<Napi::Array>());
+    });
+    Napi::Object registry = env.Global().Get("FinalizationRegistry").As<Napi::Function>().New({ cleanup });
+    GetAddonData(env).predicatePoolRegistry = Napi::Persistent(registry);
+}
+
+Napi::Object PredicatePoolObject::NewInstance(Napi::Env env, Napi::Function workerClass, const std::string& source, size_t size) {
+    auto state = std::make_shared<PredicatePoolState>();
+    Napi::Array workers = Napi::Array::New(env, size);
+    // A worker that fails (e.g. on a syntax error in the source) or exits breaks the pool
+    auto onError = Napi::Function::New(env, [state](const Napi::CallbackInfo& info) {
+        std::string message = info.Length() > 0 && info[0].IsObject()
+            ? info[0].As<Napi::Object>().Get("message").ToString().Utf8Value() : "unknown error";
+        state->Fail("Predicate pool worker failed: " + message);
+    });
+    auto onExit = Napi::Function::New(env, [state](const Napi::CallbackInfo&) {
+        state->Fail("Predicate pool worker exited");
+    });
+
+    Napi::Object workerData = Napi::Object::New(env);
+    workerData.Set("source", source);
+    Napi::Object options = Napi::Object::New(env);
+    options.Set("eval", true);
+    options.Set("workerData", workerData);
+    for (size_t i = 0; i < size; ++i) {
+        Napi::Object worker = workerClass.New({ Napi::String::New(env, kWorkerScript), options });
+        Napi::Function on = worker.Get("on").As<Napi::Function>();
+        on.Call(worker, { Napi::String::New(env, "error"), onError });
+        on.Call(worker, { Napi::String::New(env, "exit"), onExit });
+        // Idle workers must not keep the process alive
+        worker.Get("unref").As<Napi::Function>().Call(worker, {});
+        workers.Set(static_cast<uint32_t>(i), worker);
+    }
+
+    PoolSetup setup{ state, workers };
+    auto ext = Napi::External<PoolSetup>::New(env, &setup);
+    Napi::Object pool = GetAddonData(env).predicatePoolConstructor.New({ ext });
+    // The pool is also the unregister token, so close() can drop the entry
+    Napi::Object registry = GetAddonData(env).predicatePoolRegistry.Value();
+    registry.Get("register").As<Napi::Function>().Call(registry, { pool, workers, pool });
+    return pool;
+}
+
+PredicatePoolObject* PredicatePoolObject::FromValue(Napi::Value value) {
+    if (!value.IsObject() || !value.As<Napi::Object>().InstanceOf(GetAddonData(value.Env()).predicatePoolConstructor.Value())) return nullptr;
+    return Unwrap(value.As<Napi::Object>());
+}
+
+PredicatePoolObject::PredicatePoolObject(const Napi::CallbackInfo& info) : Napi::ObjectWrap<PredicatePoolObject>(info) {
+    if (info.Length() < 1 || !info[0].IsExternal()) {
+        Napi::TypeError::New(info.Env(), "PredicatePool cannot be constructed directly; use createPredicatePool()").ThrowAsJavaScriptException();
+        return;
+    }
+    PoolSetup* setup = info[0].As<Napi::External<PoolSetup>>().Data();
+    state_ = setup->state;
+    workers_ = Napi::Persistent(static_cast<Napi::Object>(setup->workers));
+    size_ = setup->workers.Length();
+}
+
+bool PredicatePoolObject::Dispatch(Napi::Env env, Napi::Int32Array input, MaskJob& job, const int32_t*& data, RetainedArguments retained) {
+    if (state_->Broken()) {
+        Napi::Error::New(env, state_->Error()).ThrowAsJavaScriptException();
+        return false;
+    }
+    size_t n = input.ElementLength();
+    Napi::Object global = env.Global();
+    Napi::Function sharedArrayBuffer = global.Get("SharedArrayBuffer").As<Napi::Function>();
+    // Typed arrays over new SharedArrayBuffers (zero-filled), created through the JS constructors
+    auto shared = [&](const char* type, size_t length, size_t elementSize) {
+        Napi::Object buffer = sharedArrayBuffer.New({ Napi::Number::New(env, (double)(length * elementSize)) });
+        return global.Get(type).As<Napi::Function>().New({ buffer }).As<Napi::TypedArray>();
+    };
+
+    Napi::Int32Array sharedInput = input;
+    if (!input.Get("buffer").As<Napi::Object>().InstanceOf(sharedArrayBuffer)) {
+        sharedInput = shared("Int32Array", n, sizeof(int32_t)).As<Napi::Int32Array>();
+        if (n > 0) memcpy(sharedInput.Data(), input.Data(), n * sizeof(int32_t));
+    }
+    auto mask = shared("Uint8Array", n, 1).As<Napi::Uint8Array>();
+    auto status = shared("Int32Array", kMaskJobStatusWords, sizeof(int32_t)).As<Napi::Int32Array>();
+    auto error = shared("Uint8Array", kPoolErrorCapacity, 1).As<Napi::Uint8Array>();
+
+    size_t chunks = n == 0 ? 0 : std::max<size_t>(1, std::min(size_ * 4, (n + kPoolMinChunk - 1) / kPoolMinChunk));
+    size_t chunkSize = chunks == 0 ? 1 : (n + chunks - 1) / chunks;
+    chunks = n == 0 ? 0 : (n + chunkSize - 1) / chunkSize;
+    if (chunks > 0) {
+        Napi::Object message = Napi::Object::New(env);
+        message.Set("input", sharedInput);
+        message.Set("mask", mask);
+        message.Set("status", status);
+        message.Set("error", error);
+        message.Set("chunkSize", Napi::Number::New(env, (double)chunkSize));
+        Napi::Array workers = workers_.Value().As<Napi::Array>();
+        for (uint32_t i = 0; i < workers.Length(); ++i) {
+            Napi::Object worker = workers.Get(i).As<Napi::Object>();
+            worker.Get("postMessage").As<Napi::Function>().Call(worker, { message });
+        }
+    }
+
+    job.status = status.Data();
+    job.errorText = error.Data();
+    job.errorCapacity = kPoolErrorCapacity;
+    job.mask = mask.Data();
+    job.chunks = chunks;
+    job.pool = state_;
+    data = sharedInput.Data();
+    for (Napi::Object array : { static_cast<Napi::Object>(sharedInput), static_cast<Napi::Object>(mask),
+                                static_cast<Napi::Object>(status), static_cast<Napi::Object>(error) }) {
+        retained->push_back(Napi::Persistent(array));
+    }
+    return true;
+}
+
+Napi::Value PredicatePoolObject::GetSize(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)size_);
+}
+
+/**
+ * @brief Terminates the workers. Jobs still running fail; later calls using the pool throw.
+ *
+ * Pools that are never closed have their workers terminated once they are garbage collected.
+ */
+Napi::Value PredicatePoolObject::Close(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    state_->Fail("Predicate pool is closed");
+    Napi::Object registry = GetAddonData(env).predicatePoolRegistry.Value();
+    registry.Get("unregister").As<Napi::Function>().Call(registry, { info.This() });
+    TerminateWorkers(workers_.Value().As<Napi::Array>());
+    return env.Undefined();
+}
@@ -0,0 +1,49 @@
+#ifndef PREDICATE_POOL_OBJECT_HPP
+#define PREDICATE_POOL_OBJECT_HPP
+
+#include "hpx_pool.hpp"
+#include "data_conversion.hpp"
+#include <napi.h>
+#include <memory>
+#include <string>
+
+/**
+ * @brief JavaScript handle for a pool of worker threads evaluating one batch predicate
+ * (returned by createPredicatePool).
+ *
+ * countIf/copyIf split their input into chunks that the workers claim from shared memory and
+ * evaluate concurrently, writing the mask into a SharedArrayBuffer. The JS thread only posts
+ * the job; the native side waits for the chunks and gathers the mask on HPX.
+ */
+class PredicatePoolObject : public Napi::ObjectWrap<PredicatePoolObject> {
+public:
+    // Defines the JS class for 'env'; must be called from InitAddon
+    static void Init(Napi::Env env);
+
+    // Starts 'size' workers (instances of workerClass) evaluating 'source'
+    static Napi::Object NewInstance(Napi::Env env, Napi::Function workerClass, const std::string& source, size_t size);
+
+    // The pool wrapped by 'value', or nullptr if it is not a PredicatePool
+    static PredicatePoolObject* FromValue(Napi::Value value);
+
+    /**
+     * @brief Posts a predicate job over 'input' to every worker.
+     *
+     * The input is shared as is when it is backed by a SharedArrayBuffer and copied into one
+     * otherwise. Fills 'job' and 'data' (the shared input) and adds the shared arrays to
+     * 'retained'. Throws a JS Error and returns false if the pool is broken or closed.
+     */
+    bool Dispatch(Napi::Env env, Napi::Int32Array input, MaskJob& job, const int32_t*& data, RetainedArguments retained);
+
+    explicit PredicatePoolObject(const Napi::CallbackInfo& info);
+
+private:
+    Napi::Value GetSize(const Napi::CallbackInfo& info);
+    Napi::Value Close(const Napi::CallbackInfo& info);
+
+    std::shared_ptr<PredicatePoolState> state_;
+    Napi::ObjectReference workers_;
+    size_t size_ = 0;
+};
+
+#endif // PREDICATE_POOL_OBJECT_HPP
@@ -0,0 +1,182 @@
+#include "resident_buffer_object.hpp"
+#include "addon_data.hpp"
+#include "async_helpers.hpp"
+#include "data_conversion.hpp"
+
+#include <napi.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <limits>
+#include <cstring> // for memcpy
+
+void ResidentBufferObject::Init(Napi::Env env) {
+    Napi::Function cls = DefineClass(env, "ResidentBuffer", {
+        InstanceAccessor("length", &ResidentBufferObject::GetLength, nullptr),
+        InstanceAccessor("hasZoneMap", &ResidentBufferObject::GetHasZoneMap, nullptr),
+        InstanceMethod("count", &ResidentBufferObject::Count),
+        InstanceMethod("find", &ResidentBufferObject::Find),
+        InstanceMethod("countRange", &ResidentBufferObject::CountRange),
+        InstanceMethod("write", &ResidentBufferObject::Write),
+        InstanceMethod("read", &ResidentBufferObject::Read)
+    });
+    GetAddonData(env).residentBufferConstructor = Napi::Persistent(cls);
+}
+
+Napi::Object ResidentBufferObject::NewInstance(Napi::Env env, std::shared_ptr<ResidentBuffer> buffer) {
+    // The constructor only accepts this External, so JS code cannot create empty buffers
+    auto ext = Napi::External<std::shared_ptr<ResidentBuffer>>::New(env, &buffer);
+    return GetAddonData(env).residentBufferConstructor.New({ ext });
+}
+
+std::shared_ptr<ResidentBuffer> ResidentBufferObject::FromValue(Napi::Value value) {
+    if (!value.IsObject() || !value.As<Napi::Object>().InstanceOf(GetAddonData(value.Env()).residentBufferConstructor.Value())) return nullptr;
+    return Unwrap(value.As<Napi::Object>())->buffer_;
+}
+
+ResidentBufferObject::ResidentBufferObject(const Napi::CallbackInfo& info) : Napi::ObjectWrap<ResidentBufferObject>(info) {
+    if (info.Length() < 1 || !info[0].IsExternal()) {
+        Napi::TypeError::New(info.Env(), "ResidentBuffer cannot be constructed directly; use createResidentBuffer()").ThrowAsJavaScriptException();
+        return;
+    }
+    buffer_ = *info[0].As<Napi::External<std::shared_ptr<ResidentBuffer>>>().Data();
+}
+
+Napi::Value ResidentBufferObject::GetLength(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)buffer_->Size());
+}
+
+Napi::Value ResidentBufferObject::GetHasZoneMap(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), buffer_->HasZoneMap());
+}
+
+/**
+ * @brief Counts how many elements equal a given value. Returns a Promise (Number).
+ */
+Napi::Value ResidentBufferObject::Count(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    int32_t value = info[0].As<Napi::Number>().Int32Value();
+    std::shared_ptr<const ResidentBuffer> buffer = buffer_;
+
+    return QueueAsyncWork<int64_t>(
+        env,
+        [buffer, value](int64_t &res, std::string &err){
+            try {
+                auto fut = hpx_resident_count(buffer, value);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, int64_t &res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(Napi::Number::New(env, (double)res));
+        }
+    );
+}
+
+/**
+ * @brief Finds the first index of a given value. Returns a Promise (Number), -1 if not found.
+ */
+Napi::Value ResidentBufferObject::Find(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    int32_t value = info[0].As<Napi::Number>().Int32Value();
+    std::shared_ptr<const ResidentBuffer> buffer = buffer_;
+
+    return QueueAsyncWork<int64_t>(
+        env,
+        [buffer, value](int64_t &res, std::string &err){
+            try {
+                auto fut = hpx_resident_find(buffer, value);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, int64_t &res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(Napi::Number::New(env, (double)res));
+        }
+    );
+}
+
+/**
+ * @brief Counts elements within [lo, hi] (inclusive). Returns a Promise (Number).
+ */
+Napi::Value ResidentBufferObject::CountRange(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    int32_t lo = info[0].As<Napi::Number>().Int32Value();
+    int32_t hi = info[1].As<Napi::Number>().Int32Value();
+    std::shared_ptr<const ResidentBuffer> buffer = buffer_;
+
+    return QueueAsyncWork<int64_t>(
+        env,
+        [buffer, lo, hi](int64_t &res, std::string &err){
+            try {
+                auto fut = hpx_resident_count_range(buffer, lo, hi);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, int64_t &res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(Napi::Number::New(env, (double)res));
+        }
+    );
+}
+
+/**
+ * @brief Overwrites elements starting at 'offset' with the given Int32Array.
+ *
+ * The zone map (if any) is updated as part of the write. Returns a Promise resolved to true
+ * once the write is visible to subsequent queries.
+ */
+Napi::Value ResidentBufferObject::Write(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t offset = info[0].As<Napi::Number>().Uint32Value();
+    auto values = GetInt32ArrayArgument(info, 1);
+    if (env.IsExceptionPending()) return env.Null();
+    const int32_t* valuesPtr = values.Data();
+    size_t valuesSize = values.ElementLength();
+    auto retained = RetainArguments(info, {1});
+    auto buffer = buffer_;
+
+    return QueueAsyncWork(
+        env,
+        [buffer, offset, valuesPtr, valuesSize](std::string &err){
+            try {
+                auto fut = hpx_resident_write(buffer, offset, valuesPtr, valuesSize);
+                fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else def.Resolve(Napi::Boolean::New(env, true));
+        }
+    );
+}
+
+/**
+ * @brief Copies elements out of the buffer as a new Int32Array.
+ *
+ * Optional arguments: offset (default 0) and count (default: up to the end).
+ */
+Napi::Value ResidentBufferObject::Read(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    size_t offset = info.Length() > 0 && info[0].IsNumber() ? info[0].As<Napi::Number>().Uint32Value() : 0;
+    size_t count = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Uint32Value() : std::numeric_limits<size_t>::max();
+    std::shared_ptr<const ResidentBuffer> buffer = buffer_;
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<int32_t>>>(
+        env,
+        [buffer, offset, count](std::shared_ptr<std::vector<int32_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_resident_read(buffer, offset, count);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<int32_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Int32Array arr = Napi::Int32Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size()*sizeof(int32_t));
+                def.Resolve(arr);
+            }
+        }
+    );
+}
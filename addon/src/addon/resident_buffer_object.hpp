@@ -0,0 +1,38 @@
+#ifndef RESIDENT_BUFFER_OBJECT_HPP
+#define RESIDENT_BUFFER_OBJECT_HPP
+
+#include "hpx_resident.hpp"
+#include <napi.h>
+#include <memory>
+
+/**
+ * @brief JavaScript handle for a native ResidentBuffer (returned by createResidentBuffer).
+ *
+ * All queries and writes run on HPX and return Promises.
+ */
+class ResidentBufferObject : public Napi::ObjectWrap<ResidentBufferObject> {
+public:
+    // Defines the JS class for 'env'; must be called from InitAddon
+    static void Init(Napi::Env env);
+
+    // Wraps an existing buffer into a new JS object
+    static Napi::Object NewInstance(Napi::Env env, std::shared_ptr<ResidentBuffer> buffer);
+
+    // The wrapped buffer if 'value' is an instance of this class, nullptr otherwise
+    static std::shared_ptr<ResidentBuffer> FromValue(Napi::Value value);
+
+    explicit ResidentBufferObject(const Napi::CallbackInfo& info);
+
+private:
+    Napi::Value GetLength(const Napi::CallbackInfo& info);
+    Napi::Value GetHasZoneMap(const Napi::CallbackInfo& info);
+    Napi::Value Count(const Napi::CallbackInfo& info);
+    Napi::Value Find(const Napi::CallbackInfo& info);
+    Napi::Value CountRange(const Napi::CallbackInfo& info);
+    Napi::Value Write(const Napi::CallbackInfo& info);
+    Napi::Value Read(const Napi::CallbackInfo& info);
+
+    std::shared_ptr<ResidentBuffer> buffer_;
+};
+
+#endif // RESIDENT_BUFFER_OBJECT_HPP
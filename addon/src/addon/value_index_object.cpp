@@ -0,0 +1,144 @@
+#include "value_index_object.hpp"
+#include "addon_data.hpp"
+#include "async_helpers.hpp"
+#include "data_conversion.hpp"
+
+#include <napi.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring> // for memcpy
+
+void ValueIndexObject::Init(Napi::Env env) {
+    Napi::Function cls = DefineClass(env, "ValueIndex", {
+        InstanceAccessor("length", &ValueIndexObject::GetLength, nullptr),
+        InstanceAccessor("distinct", &ValueIndexObject::GetDistinct, nullptr),
+        InstanceMethod("count", &ValueIndexObject::Count),
+        InstanceMethod("find", &ValueIndexObject::Find),
+        InstanceMethod("findAll", &ValueIndexObject::FindAll),
+        InstanceMethod("countBatch", &ValueIndexObject::CountBatch),
+        InstanceMethod("findBatch", &ValueIndexObject::FindBatch)
+    });
+    GetAddonData(env).valueIndexConstructor = Napi::Persistent(cls);
+}
+
+Napi::Object ValueIndexObject::NewInstance(Napi::Env env, std::shared_ptr<const ValueIndex> index) {
+    // The constructor only accepts this External, so JS code cannot create empty indexes
+    auto ext = Napi::External<std::shared_ptr<const ValueIndex>>::New(env, &index);
+    return GetAddonData(env).valueIndexConstructor.New({ ext });
+}
+
+std::shared_ptr<const ValueIndex> ValueIndexObject::FromValue(Napi::Value value) {
+    if (!value.IsObject() || !value.As<Napi::Object>().InstanceOf(GetAddonData(value.Env()).valueIndexConstructor.Value())) return nullptr;
+    return Unwrap(value.As<Napi::Object>())->index_;
+}
+
+ValueIndexObject::ValueIndexObject(const Napi::CallbackInfo& info) : Napi::ObjectWrap<ValueIndexObject>(info) {
+    if (info.Length() < 1 || !info[0].IsExternal()) {
+        Napi::TypeError::New(info.Env(), "ValueIndex cannot be constructed directly; use buildValueIndex()").ThrowAsJavaScriptException();
+        return;
+    }
+    index_ = *info[0].As<Napi::External<std::shared_ptr<const ValueIndex>>>().Data();
+}
+
+Napi::Value ValueIndexObject::GetLength(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)index_->Size());
+}
+
+Napi::Value ValueIndexObject::GetDistinct(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)index_->DistinctCount());
+}
+
+/**
+ * @brief Returns how many times a value occurs in the indexed array.
+ */
+Napi::Value ValueIndexObject::Count(const Napi::CallbackInfo& info) {
+    int32_t value = info[0].As<Napi::Number>().Int32Value();
+    return Napi::Number::New(info.Env(), (double)index_->Count(value));
+}
+
+/**
+ * @brief Returns the first position of a value in the indexed array, or -1.
+ */
+Napi::Value ValueIndexObject::Find(const Napi::CallbackInfo& info) {
+    int32_t value = info[0].As<Napi::Number>().Int32Value();
+    return Napi::Number::New(info.Env(), (double)index_->Find(value));
+}
+
+/**
+ * @brief Returns all positions of a value as an ascending Uint32Array.
+ */
+Napi::Value ValueIndexObject::FindAll(const Napi::CallbackInfo& info) {
+    int32_t value = info[0].As<Napi::Number>().Int32Value();
+    auto range = index_->FindAll(value);
+    size_t n = (size_t)(range.second - range.first);
+    Napi::Uint32Array arr = Napi::Uint32Array::New(info.Env(), n);
+    if (n > 0) memcpy(arr.Data(), range.first, n*sizeof(uint32_t));
+    return arr;
+}
+
+/**
+ * @brief Counts every value of an Int32Array against the index on HPX.
+ *
+ * Returns a Promise with a Uint32Array holding one count per queried value.
+ */
+Napi::Value ValueIndexObject::CountBatch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto values = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    const int32_t* valuesPtr = values.Data();
+    size_t valuesSize = values.ElementLength();
+    auto retained = RetainArguments(info, {0});
+    auto index = index_;
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<uint32_t>>>(
+        env,
+        [index, valuesPtr, valuesSize](std::shared_ptr<std::vector<uint32_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_value_index_count_batch(index, valuesPtr, valuesSize);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<uint32_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Uint32Array arr = Napi::Uint32Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size()*sizeof(uint32_t));
+                def.Resolve(arr);
+            }
+        }
+    );
+}
+
+/**
+ * @brief Looks up the first position of every value of an Int32Array on HPX.
+ *
+ * Returns a Promise with an Int32Array holding one position per queried value (-1 if absent).
+ */
+Napi::Value ValueIndexObject::FindBatch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto values = GetInt32ArrayArgument(info, 0);
+    if (env.IsExceptionPending()) return env.Null();
+    const int32_t* valuesPtr = values.Data();
+    size_t valuesSize = values.ElementLength();
+    auto retained = RetainArguments(info, {0});
+    auto index = index_;
+
+    return QueueAsyncWork<std::shared_ptr<std::vector<int32_t>>>(
+        env,
+        [index, valuesPtr, valuesSize](std::shared_ptr<std::vector<int32_t>>& res, std::string &err){
+            try {
+                auto fut = hpx_value_index_find_batch(index, valuesPtr, valuesSize);
+                res = fut.get();
+            } catch(const std::exception &e){ err = e.what(); }
+        },
+        [retained](Napi::Env env, Napi::Promise::Deferred& def, std::shared_ptr<std::vector<int32_t>>& res, const std::string &err){
+            if(!err.empty()) def.Reject(Napi::String::New(env, err));
+            else {
+                Napi::Int32Array arr = Napi::Int32Array::New(env, res->size());
+                memcpy(arr.Data(), res->data(), res->size()*sizeof(int32_t));
+                def.Resolve(arr);
+            }
+        }
+    );
+}
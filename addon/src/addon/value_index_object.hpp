@@ -0,0 +1,40 @@
+#ifndef VALUE_INDEX_OBJECT_HPP
+#define VALUE_INDEX_OBJECT_HPP
+
+#include "hpx_index.hpp"
+#include <napi.h>
+#include <memory>
+
+/**
+ * @brief JavaScript handle for a native ValueIndex (returned by buildValueIndex).
+ *
+ * Single-value lookups (count, find, findAll) are answered synchronously, since a binary search
+ * is far cheaper than an async round trip. Batch lookups (countBatch, findBatch) run on HPX and
+ * return Promises, like the rest of the addon.
+ */
+class ValueIndexObject : public Napi::ObjectWrap<ValueIndexObject> {
+public:
+    // Defines the JS class for 'env'; must be called from InitAddon
+    static void Init(Napi::Env env);
+
+    // Wraps an already built index into a new JS object
+    static Napi::Object NewInstance(Napi::Env env, std::shared_ptr<const ValueIndex> index);
+
+    // The wrapped index if 'value' is an instance of this class, nullptr otherwise
+    static std::shared_ptr<const ValueIndex> FromValue(Napi::Value value);
+
+    explicit ValueIndexObject(const Napi::CallbackInfo& info);
+
+private:
+    Napi::Value GetLength(const Napi::CallbackInfo& info);
+    Napi::Value GetDistinct(const Napi::CallbackInfo& info);
+    Napi::Value Count(const Napi::CallbackInfo& info);
+    Napi::Value Find(const Napi::CallbackInfo& info);
+    Napi::Value FindAll(const Napi::CallbackInfo& info);
+    Napi::Value CountBatch(const Napi::CallbackInfo& info);
+    Napi::Value FindBatch(const Napi::CallbackInfo& info);
+
+    std::shared_ptr<const ValueIndex> index_;
+};
+
+#endif // VALUE_INDEX_OBJECT_HPP
@@ -0,0 +1,237 @@
+#include "hpx_approx.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+// Strata are contiguous runs of blocks, so every region of the array is represented
+constexpr size_t kMaxStrata = 64;
+
+// Blocks sampled per stratum in the first round; doubled every round
+constexpr size_t kFirstRoundBlocks = 2;
+
+// Fixed seed: the same input and options always sample the same blocks
+constexpr uint64_t kSampleSeed = 0x9E3779B97F4A7C15ULL;
+
+// Inverse of the standard normal CDF (Acklam's rational approximation, |error| < 1.2e-9)
+double normal_quantile(double p) {
+    static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+    static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                6.680131188771972e+01, -1.328068155288572e+01 };
+    static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+    static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                3.754408661907416e+00 };
+    const double low = 0.02425;
+    if (p < low) {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - low) return -normal_quantile(1 - p);
+    double q = p - 0.5, r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+size_t block_length(size_t size, size_t block) {
+    return std::min(size, (block + 1) * kApproxBlockSize) - block * kApproxBlockSize;
+}
+
+// Runs 'per_block' over the blocks of one round in parallel
+template <typename F>
+std::vector<double> parallel_block_totals(const std::vector<size_t>& blocks, F per_block) {
+    std::vector<double> out(blocks.size());
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), blocks.size(), [&](size_t i) {
+            out[i] = per_block(blocks[i]);
+        });
+    }, blocks.size() * kApproxBlockSize);
+    return out;
+}
+
+} // namespace
+
+ApproxSampler::ApproxSampler(size_t size, const ApproxOptions& options)
+    : size_(size), options_(options), start_(std::chrono::steady_clock::now()) {
+    if (!(options.confidence > 0.0 && options.confidence < 1.0)) {
+        throw std::runtime_error("confidence must be in (0, 1)");
+    }
+    if (size == 0) {
+        result_.exact = true;
+        done_ = true;
+        return;
+    }
+    z_ = normal_quantile(0.5 + options.confidence / 2.0);
+
+    blocks_ = (size + kApproxBlockSize - 1) / kApproxBlockSize;
+    size_t strata_count = std::min(kMaxStrata, blocks_);
+    order_.resize(blocks_);
+    std::iota(order_.begin(), order_.end(), size_t(0));
+    std::mt19937_64 rng(kSampleSeed);
+    strata_.resize(strata_count);
+    for (size_t h = 0; h < strata_count; ++h) {
+        strata_[h].begin = h * blocks_ / strata_count;
+        strata_[h].blocks = (h + 1) * blocks_ / strata_count - strata_[h].begin;
+        std::shuffle(order_.begin() + strata_[h].begin, order_.begin() + strata_[h].begin + strata_[h].blocks, rng);
+    }
+    per_stratum_ = kFirstRoundBlocks;
+    PlanRound();
+}
+
+void ApproxSampler::PlanRound() {
+    round_.clear();
+    owner_.clear();
+    for (size_t h = 0; h < strata_.size(); ++h) {
+        const Stratum& s = strata_[h];
+        size_t take = std::min(per_stratum_, s.blocks - s.taken);
+        for (size_t i = 0; i < take; ++i) {
+            round_.push_back(order_[s.begin + s.taken + i]);
+            owner_.push_back(h);
+        }
+    }
+}
+
+void ApproxSampler::Record(const std::vector<double>& totals) {
+    if (done_) throw std::runtime_error("Sampling has already stopped");
+    if (totals.size() != round_.size()) throw std::runtime_error("Block aggregation returned the wrong number of totals");
+    for (size_t i = 0; i < round_.size(); ++i) {
+        Stratum& s = strata_[owner_[i]];
+        s.sum += totals[i];
+        s.sumsq += totals[i] * totals[i];
+        s.taken++;
+        result_.sampled += block_length(size_, round_[i]);
+    }
+    visited_ += round_.size();
+
+    // Stratified estimate of the total; the finite population correction makes fully
+    // sampled strata contribute no variance
+    double estimate = 0.0, variance = 0.0;
+    bool complete = true;
+    for (const Stratum& s : strata_) {
+        double N = static_cast<double>(s.blocks), n = static_cast<double>(s.taken);
+        double mean = s.sum / n;
+        estimate += N * mean;
+        if (s.taken == s.blocks) continue;
+        complete = false;
+        double s2 = std::max(0.0, (s.sumsq - n * mean * mean) / (n - 1.0));
+        variance += N * N * (1.0 - n / N) * s2 / n;
+    }
+    double half = z_ * std::sqrt(variance);
+    result_.estimate = estimate;
+    result_.lower = estimate - half;
+    result_.upper = estimate + half;
+    size_t round = rounds_++;
+    done_ = true;
+    round_.clear();
+    if (complete) {
+        result_.exact = true;
+        return;
+    }
+    // A zero-variance first round (e.g. no match in any sampled block) is not trusted alone
+    if (options_.errorBound > 0.0 && round > 0 && half <= options_.errorBound * std::abs(estimate)) return;
+
+    per_stratum_ *= 2;
+    if (options_.timeBudgetMs > 0.0) {
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+        double remaining = options_.timeBudgetMs - elapsed;
+        if (remaining <= 0.0) return;
+        // Shrink the next round to what the measured throughput allows within the budget
+        double per_block = elapsed / static_cast<double>(visited_);
+        if (per_block > 0.0) {
+            double affordable = remaining / per_block / static_cast<double>(strata_.size());
+            if (affordable < 1.0) return;
+            per_stratum_ = std::min(per_stratum_, static_cast<size_t>(std::min(affordable, static_cast<double>(blocks_))));
+        }
+    }
+    done_ = false;
+    PlanRound();
+}
+
+ApproxResult approx_block_sum(size_t size, const ApproxBlockTotals& totals, const ApproxOptions& options) {
+    ApproxSampler sampler(size, options);
+    while (!sampler.Done()) sampler.Record(totals(sampler.Round()));
+    return sampler.Result();
+}
+
+ApproxResult approx_clamp_count(ApproxResult result, size_t size) {
+    result.lower = std::max(0.0, result.lower);
+    result.upper = std::min(static_cast<double>(size), result.upper);
+    return result;
+}
+
+hpx::future<ApproxResult> hpx_count_approx(const int32_t* src, size_t size, int32_t value, ApproxOptions options) {
+    return hpx::async([src, size, value, options]() {
+        ApproxResult r = approx_block_sum(size, [&](const std::vector<size_t>& blocks) {
+            return parallel_block_totals(blocks, [&](size_t b) {
+                size_t begin = b * kApproxBlockSize, end = begin + block_length(size, b);
+                int64_t n = 0;
+                for (size_t i = begin; i < end; ++i) n += (src[i] == value);
+                return static_cast<double>(n);
+            });
+        }, options);
+        return approx_clamp_count(r, size);
+    });
+}
+
+hpx::future<ApproxResult> hpx_sum_approx(const int32_t* src, size_t size, ApproxOptions options) {
+    return hpx::async([src, size, options]() {
+        return approx_block_sum(size, [&](const std::vector<size_t>& blocks) {
+            return parallel_block_totals(blocks, [&](size_t b) {
+                size_t begin = b * kApproxBlockSize, end = begin + block_length(size, b);
+                int64_t sum = 0;
+                for (size_t i = begin; i < end; ++i) sum += src[i];
+                return static_cast<double>(sum);
+            });
+        }, options);
+    });
+}
+
+hpx::future<std::shared_ptr<ApproxSampler>> hpx_approx_sampler(size_t size, ApproxOptions options) {
+    return hpx::async([size, options]() { return std::make_shared<ApproxSampler>(size, options); });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_approx_gather(std::shared_ptr<const ApproxSampler> sampler, const int32_t* src) {
+    return hpx::async([sampler, src]() {
+        // The round's blocks go into one contiguous batch so the predicate runs once per round
+        const std::vector<size_t>& blocks = sampler->Round();
+        size_t size = sampler->Size();
+        std::vector<size_t> offsets(blocks.size() + 1, 0);
+        for (size_t i = 0; i < blocks.size(); ++i) offsets[i + 1] = offsets[i] + block_length(size, blocks[i]);
+        auto gathered = std::make_shared<std::vector<int32_t>>(offsets.back());
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), blocks.size(), [&](size_t i) {
+                const int32_t* block = src + blocks[i] * kApproxBlockSize;
+                std::copy(block, block + (offsets[i + 1] - offsets[i]), gathered->begin() + offsets[i]);
+            });
+        }, gathered->size());
+        return gathered;
+    });
+}
+
+hpx::future<void> hpx_approx_record_mask(std::shared_ptr<ApproxSampler> sampler, std::shared_ptr<std::vector<uint8_t>> mask) {
+    return hpx::async([sampler, mask]() {
+        const std::vector<size_t>& blocks = sampler->Round();
+        size_t size = sampler->Size();
+        std::vector<size_t> offsets(blocks.size() + 1, 0);
+        for (size_t i = 0; i < blocks.size(); ++i) offsets[i + 1] = offsets[i] + block_length(size, blocks[i]);
+        if (!mask || mask->size() != offsets.back()) throw std::runtime_error("Predicate mask has the wrong length");
+        std::vector<double> totals(blocks.size());
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), blocks.size(), [&](size_t i) {
+                size_t n = 0;
+                for (size_t j = offsets[i]; j < offsets[i + 1]; ++j) n += ((*mask)[j] == 1);
+                totals[i] = static_cast<double>(n);
+            });
+        }, mask->size());
+        sampler->Record(totals);
+    });
+}
@@ -0,0 +1,175 @@
+#ifndef HPX_APPROX_HPP
+#define HPX_APPROX_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * Sampling-based approximate aggregates over Int32 arrays.
+ *
+ * The array is cut into fixed-size blocks and the blocks into contiguous strata. Every round
+ * samples more blocks from every stratum (without replacement), aggregates them in parallel and
+ * updates a stratified estimate of the total with its confidence interval. Sampling stops as soon
+ * as the interval is tight enough, the time budget is used up, or every block has been visited
+ * (the answer is then exact).
+ */
+
+/**
+ * @brief Stopping rules and confidence level of an approximate aggregate.
+ *
+ * At least one of errorBound and timeBudgetMs should be positive; with neither, sampling runs
+ * until the result is exact.
+ */
+struct ApproxOptions {
+    double errorBound = 0.0;    // relative half-width of the interval to reach (0.01 = 1%)
+    double timeBudgetMs = 0.0;  // wall clock budget for sampling
+    double confidence = 0.95;   // confidence level of the interval, in (0, 1)
+};
+
+/**
+ * @brief An approximate aggregate with its confidence interval.
+ */
+struct ApproxResult {
+    double estimate = 0.0;
+    double lower = 0.0;
+    double upper = 0.0;
+    size_t sampled = 0;         // number of elements examined
+    bool exact = false;         // true if every element was examined
+};
+
+/**
+ * @brief Aggregates a batch of sampled blocks.
+ *
+ * Receives the block indices of one round and returns the total of every block (same order).
+ * Block b covers elements [b * kApproxBlockSize, min(size, (b + 1) * kApproxBlockSize)).
+ */
+using ApproxBlockTotals = std::function<std::vector<double>(const std::vector<size_t>& blocks)>;
+
+constexpr size_t kApproxBlockSize = 4096;
+
+/**
+ * @brief Round-by-round state of a sampled aggregate.
+ *
+ * Round() lists the blocks to aggregate next; Record() takes their totals, updates the estimate
+ * and either plans the next round or stops. Lets callers aggregate each round elsewhere, e.g.
+ * evaluate a JavaScript predicate on the uv thread between HPX steps.
+ */
+class ApproxSampler {
+public:
+    // Throws std::runtime_error if the confidence is not in (0, 1)
+    ApproxSampler(size_t size, const ApproxOptions& options);
+
+    size_t Size() const { return size_; }
+    bool Done() const { return done_; }
+
+    // Block indices of the current round; empty once Done()
+    const std::vector<size_t>& Round() const { return round_; }
+
+    // Records the totals of Round(), in the same order
+    void Record(const std::vector<double>& totals);
+
+    // The estimate after the rounds recorded so far
+    const ApproxResult& Result() const { return result_; }
+
+private:
+    struct Stratum {
+        size_t begin = 0;   // first slot in the shuffled block order
+        size_t blocks = 0;  // number of blocks in the stratum
+        size_t taken = 0;   // number of blocks sampled so far
+        double sum = 0.0;   // sum of sampled block totals
+        double sumsq = 0.0; // sum of squared sampled block totals
+    };
+
+    void PlanRound();
+
+    size_t size_ = 0;
+    ApproxOptions options_;
+    std::chrono::steady_clock::time_point start_;
+    double z_ = 0.0;
+    size_t blocks_ = 0;
+    std::vector<size_t> order_;
+    std::vector<Stratum> strata_;
+    size_t per_stratum_ = 0;
+    size_t visited_ = 0;
+    size_t rounds_ = 0;
+    std::vector<size_t> round_;
+    std::vector<size_t> owner_;
+    ApproxResult result_;
+    bool done_ = false;
+};
+
+/**
+ * @brief Estimates the sum of per-block totals over an array of 'size' elements by sampling.
+ *
+ * Runs on the calling thread; block totals are computed by 'totals', once per round.
+ *
+ * @param size Number of elements in the array.
+ * @param totals Callback aggregating the sampled blocks of one round.
+ * @param options Stopping rules and confidence level.
+ * @return The estimate and its confidence interval.
+ */
+ApproxResult approx_block_sum(size_t size, const ApproxBlockTotals& totals, const ApproxOptions& options);
+
+// Narrows the interval of an estimated count to [0, size]
+ApproxResult approx_clamp_count(ApproxResult result, size_t size);
+
+/**
+ * @brief Approximately counts the occurrences of 'value'.
+ *
+ * @param src Pointer to the input array (read in place).
+ * @param size Number of elements in the input array.
+ * @param value The value to count.
+ * @param options Stopping rules and confidence level.
+ * @return A future that, when ready, returns the estimated count with its confidence interval.
+ */
+hpx::future<ApproxResult> hpx_count_approx(const int32_t* src, size_t size, int32_t value, ApproxOptions options);
+
+/**
+ * @brief Approximately sums the array.
+ *
+ * @param src Pointer to the input array (read in place).
+ * @param size Number of elements in the input array.
+ * @param options Stopping rules and confidence level.
+ * @return A future that, when ready, returns the estimated sum with its confidence interval.
+ */
+hpx::future<ApproxResult> hpx_sum_approx(const int32_t* src, size_t size, ApproxOptions options);
+
+/**
+ * @brief Creates the sampler of an approximate predicate count (see hpx_approx_gather).
+ *
+ * A predicate count alternates between HPX and the thread that evaluates the predicate:
+ * hpx_approx_gather collects the sampled blocks of a round, the caller evaluates the predicate
+ * on them, and hpx_approx_record_mask turns the mask into block totals, until Done(). Unsampled
+ * elements are never evaluated; approx_clamp_count bounds the final Result().
+ *
+ * @param size Number of elements in the input array.
+ * @param options Stopping rules and confidence level.
+ * @return A future that, when ready, returns the sampler with its first round planned.
+ */
+hpx::future<std::shared_ptr<ApproxSampler>> hpx_approx_sampler(size_t size, ApproxOptions options);
+
+/**
+ * @brief Copies the blocks of the sampler's current round into one contiguous batch.
+ *
+ * @param sampler The sampler.
+ * @param src Pointer to the input array (read in place).
+ * @return A future that, when ready, returns the batch.
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_approx_gather(std::shared_ptr<const ApproxSampler> sampler, const int32_t* src);
+
+/**
+ * @brief Records a 0/1 predicate mask over the current round's batch and plans the next round.
+ *
+ * @param sampler The sampler.
+ * @param mask Mask over the batch returned by hpx_approx_gather (std::runtime_error if its length differs).
+ * @return A future that becomes ready once the round is recorded.
+ */
+hpx::future<void> hpx_approx_record_mask(std::shared_ptr<ApproxSampler> sampler, std::shared_ptr<std::vector<uint8_t>> mask);
+
+#endif // HPX_APPROX_HPP
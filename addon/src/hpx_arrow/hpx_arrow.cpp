@@ -0,0 +1,248 @@
+#include "hpx_arrow.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Buffers of a column produced by the kernels
+struct OwnedColumn {
+    std::vector<int32_t> values;
+    std::vector<uint8_t> validity;
+};
+
+// Kept alive by an exported array until the consumer releases it
+struct ExportedArray {
+    std::shared_ptr<const ArrowColumn> column;
+    const void* buffers[2];
+};
+
+void release_exported_array(ArrowArray* array) {
+    delete static_cast<ExportedArray*>(array->private_data);
+    array->release = nullptr;
+}
+
+void release_exported_schema(ArrowSchema* schema) {
+    schema->release = nullptr;
+}
+
+std::shared_ptr<const ArrowColumn> make_owned_column(std::shared_ptr<OwnedColumn> owned, int64_t nullCount) {
+    auto column = std::make_shared<ArrowColumn>();
+    column->type = ArrowType::Int32;
+    column->length = owned->values.size();
+    column->data = owned->values.data();
+    column->validity = nullCount > 0 ? owned->validity.data() : nullptr;
+    column->nullCount = nullCount;
+    column->owner = std::move(owned);
+    return column;
+}
+
+void require_int32(const ArrowColumn& column) {
+    if (column.type != ArrowType::Int32) throw std::runtime_error("Expected an Int32 Arrow array");
+}
+
+// Sums per-chunk counts into exclusive starts; returns the total
+size_t prefix_sum(std::vector<size_t>& counts) {
+    size_t total = 0;
+    for (size_t& c : counts) {
+        size_t n = c;
+        c = total;
+        total += n;
+    }
+    return total;
+}
+
+} // namespace
+
+int64_t ArrowColumn::NullCount() const {
+    if (nullCount >= 0) return nullCount;
+    if (!validity) return 0;
+    int64_t nulls = 0;
+    for (size_t i = 0; i < length; ++i) nulls += !IsValid(i);
+    return nulls;
+}
+
+std::shared_ptr<const ArrowColumn> hpx_arrow_import(ArrowSchema* schema, ArrowArray* array) {
+    if (!schema || !array || !schema->release || !array->release) {
+        throw std::runtime_error("Arrow schema or array is missing or already released");
+    }
+    // Move both structs first, so every path below releases them
+    std::shared_ptr<ArrowArray> moved(new ArrowArray(*array), [](ArrowArray* a) {
+        if (a->release) a->release(a);
+        delete a;
+    });
+    array->release = nullptr;
+    ArrowSchema movedSchema = *schema;
+    schema->release = nullptr;
+    std::string format = movedSchema.format ? movedSchema.format : "";
+    bool nested = movedSchema.n_children != 0 || movedSchema.dictionary != nullptr;
+    movedSchema.release(&movedSchema);
+
+    auto column = std::make_shared<ArrowColumn>();
+    if (format == "i") column->type = ArrowType::Int32;
+    else if (format == "b") column->type = ArrowType::Boolean;
+    else throw std::runtime_error("Unsupported Arrow format '" + format + "' (expected 'i' or 'b')");
+    if (nested || moved->n_children != 0 || moved->dictionary != nullptr || moved->n_buffers != 2 || !moved->buffers) {
+        throw std::runtime_error("Expected a primitive Arrow array with two buffers");
+    }
+    if (moved->length < 0 || moved->offset < 0) throw std::runtime_error("Invalid Arrow array length or offset");
+    if (moved->length > 0 && !moved->buffers[1]) throw std::runtime_error("Arrow array has no data buffer");
+    if (!moved->buffers[0] && moved->null_count > 0) throw std::runtime_error("Arrow array has nulls but no validity buffer");
+
+    column->length = static_cast<size_t>(moved->length);
+    column->validity = static_cast<const uint8_t*>(moved->buffers[0]);
+    column->validityOffset = moved->offset;
+    column->data = moved->buffers[1];
+    column->dataOffset = moved->offset;
+    column->nullCount = moved->null_count;
+    column->owner = std::move(moved);
+    return column;
+}
+
+void hpx_arrow_export(std::shared_ptr<const ArrowColumn> column, ArrowSchema* schema, ArrowArray* array) {
+    if (column->validity && column->validityOffset != column->dataOffset) {
+        throw std::runtime_error("Column cannot be exported: validity and data offsets differ");
+    }
+    auto exported = new ExportedArray{ column, { column->validity, column->data } };
+    *schema = ArrowSchema{};
+    schema->format = column->type == ArrowType::Int32 ? "i" : "b";
+    schema->name = "";
+    schema->flags = ARROW_FLAG_NULLABLE;
+    schema->release = release_exported_schema;
+
+    *array = ArrowArray{};
+    array->length = static_cast<int64_t>(column->length);
+    array->null_count = column->NullCount();
+    array->offset = column->dataOffset;
+    array->n_buffers = 2;
+    array->buffers = exported->buffers;
+    array->release = release_exported_array;
+    array->private_data = exported;
+}
+
+hpx::future<int64_t> hpx_arrow_count(ArrowColumn column, int32_t value) {
+    return hpx::async([column, value]() {
+        require_int32(column);
+        size_t n = column.length;
+        size_t chunks = chunk_count(n);
+        size_t chunk_size = (n + chunks - 1) / chunks;
+        std::vector<int64_t> counts(chunks, 0);
+        const int32_t* data = static_cast<const int32_t*>(column.data) + column.dataOffset;
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(n, c * chunk_size);
+                size_t end = std::min(n, begin + chunk_size);
+                int64_t count = 0;
+                if (!column.validity) {
+                    for (size_t i = begin; i < end; ++i) count += data[i] == value;
+                } else {
+                    for (size_t i = begin; i < end; ++i) count += (data[i] == value) & column.IsValid(i);
+                }
+                counts[c] = count;
+            });
+        }, n);
+        int64_t total = 0;
+        for (int64_t count : counts) total += count;
+        return total;
+    });
+}
+
+hpx::future<std::shared_ptr<const ArrowColumn>> hpx_arrow_sort(ArrowColumn column) {
+    return hpx::async([column]() {
+        require_int32(column);
+        size_t n = column.length;
+        auto owned = std::make_shared<OwnedColumn>();
+        owned->values.assign(n, 0);
+        size_t valid = n;
+        run_with_policy([&](auto policy) {
+            const int32_t* data = static_cast<const int32_t*>(column.data) + column.dataOffset;
+            if (!column.validity) {
+                hpx::copy(policy, data, data + n, owned->values.begin());
+            } else {
+                // Compact the valid values to the front, in chunk order
+                size_t chunks = chunk_count(n);
+                size_t chunk_size = (n + chunks - 1) / chunks;
+                std::vector<size_t> starts(chunks, 0);
+                hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                    size_t begin = std::min(n, c * chunk_size);
+                    size_t end = std::min(n, begin + chunk_size);
+                    for (size_t i = begin; i < end; ++i) starts[c] += column.IsValid(i);
+                });
+                valid = prefix_sum(starts);
+                hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                    size_t begin = std::min(n, c * chunk_size);
+                    size_t end = std::min(n, begin + chunk_size);
+                    size_t out = starts[c];
+                    for (size_t i = begin; i < end; ++i) {
+                        if (column.IsValid(i)) owned->values[out++] = data[i];
+                    }
+                });
+            }
+            hpx::sort(policy, owned->values.begin(), owned->values.begin() + valid);
+        }, n);
+        if (valid < n) {
+            // Valid rows come first, so the bitmap is a run of ones
+            owned->validity.assign((n + 7) / 8, 0);
+            std::fill(owned->validity.begin(), owned->validity.begin() + valid / 8, uint8_t(0xFF));
+            if (valid % 8) owned->validity[valid / 8] = static_cast<uint8_t>((1u << (valid % 8)) - 1);
+        }
+        return make_owned_column(std::move(owned), static_cast<int64_t>(n - valid));
+    });
+}
+
+hpx::future<std::shared_ptr<const ArrowColumn>> hpx_arrow_filter(ArrowColumn column, ArrowColumn mask) {
+    return hpx::async([column, mask]() {
+        require_int32(column);
+        if (mask.type != ArrowType::Boolean) throw std::runtime_error("Expected a Boolean Arrow array as mask");
+        if (mask.length != column.length) throw std::runtime_error("Mask length must match the array length");
+        size_t n = column.length;
+        size_t chunks = chunk_count(n);
+        size_t chunk_size = (n + chunks - 1) / chunks;
+        std::vector<size_t> starts(chunks, 0);
+        std::vector<int64_t> nulls(chunks, 0);
+        const int32_t* data = static_cast<const int32_t*>(column.data) + column.dataOffset;
+        auto keep = [&](size_t i) { return mask.IsValid(i) && mask.BoolAt(i); };
+        auto owned = std::make_shared<OwnedColumn>();
+        std::vector<uint8_t> kept_valid;
+        int64_t null_total = 0;
+
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(n, c * chunk_size);
+                size_t end = std::min(n, begin + chunk_size);
+                for (size_t i = begin; i < end; ++i) starts[c] += keep(i);
+            });
+            size_t total = prefix_sum(starts);
+            owned->values.resize(total);
+            if (column.validity) kept_valid.resize(total);
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(n, c * chunk_size);
+                size_t end = std::min(n, begin + chunk_size);
+                size_t out = starts[c];
+                for (size_t i = begin; i < end; ++i) {
+                    if (!keep(i)) continue;
+                    bool valid = column.IsValid(i);
+                    owned->values[out] = valid ? data[i] : 0;
+                    if (column.validity) {
+                        kept_valid[out] = valid;
+                        nulls[c] += !valid;
+                    }
+                    ++out;
+                }
+            });
+            for (int64_t count : nulls) null_total += count;
+            if (null_total > 0) {
+                owned->validity.resize((total + 7) / 8);
+                hpx::experimental::for_loop(policy, size_t(0), owned->validity.size(), [&](size_t b) {
+                    uint8_t bits = 0;
+                    for (size_t j = 0; j < 8 && b * 8 + j < total; ++j) bits |= static_cast<uint8_t>(kept_valid[b * 8 + j] << j);
+                    owned->validity[b] = bits;
+                });
+            }
+        }, n);
+        return make_owned_column(std::move(owned), null_total);
+    });
+}
@@ -0,0 +1,154 @@
+#ifndef HPX_ARROW_HPP
+#define HPX_ARROW_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+// Apache Arrow C Data Interface (https://arrow.apache.org/docs/format/CDataInterface.html),
+// copied verbatim as the specification asks, so other producers/consumers share the definitions
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+/**
+ * @brief Element types supported by the Arrow kernels.
+ */
+enum class ArrowType {
+    Int32,      // format "i"
+    Boolean     // format "b", bit-packed values
+};
+
+/**
+ * @brief Read-only view of a primitive Arrow array (no children, no dictionary).
+ *
+ * Element i is valid if 'validity' is null or its bit validityOffset + i is set. Its value is
+ * data[dataOffset + i] for Int32, and bit dataOffset + i of 'data' for Boolean. Arrow uses one
+ * offset for both buffers; apache-arrow JS slices Int32 values but not bitmaps, so the two
+ * offsets are kept apart. 'owner' keeps the buffers alive.
+ */
+struct ArrowColumn {
+    ArrowType type = ArrowType::Int32;
+    size_t length = 0;
+    const uint8_t* validity = nullptr;
+    int64_t validityOffset = 0;
+    const void* data = nullptr;
+    int64_t dataOffset = 0;
+    int64_t nullCount = -1;     // -1 if unknown
+    std::shared_ptr<void> owner;
+
+    bool IsValid(size_t i) const {
+        if (!validity) return true;
+        int64_t bit = validityOffset + static_cast<int64_t>(i);
+        return (validity[bit >> 3] >> (bit & 7)) & 1;
+    }
+
+    int32_t Int32At(size_t i) const {
+        return static_cast<const int32_t*>(data)[dataOffset + static_cast<int64_t>(i)];
+    }
+
+    bool BoolAt(size_t i) const {
+        int64_t bit = dataOffset + static_cast<int64_t>(i);
+        return (static_cast<const uint8_t*>(data)[bit >> 3] >> (bit & 7)) & 1;
+    }
+
+    // Number of null elements (counted if unknown)
+    int64_t NullCount() const;
+};
+
+/**
+ * @brief Moves an exported array into a column that releases it once the last user is gone.
+ *
+ * Takes ownership of both structs (they are marked released). Only Int32 ("i") and Boolean
+ * ("b") arrays are accepted; throws std::runtime_error otherwise, in which case the schema and
+ * array have been released as well.
+ *
+ * @param schema Producer-filled schema.
+ * @param array Producer-filled array.
+ * @return The imported column.
+ */
+std::shared_ptr<const ArrowColumn> hpx_arrow_import(ArrowSchema* schema, ArrowArray* array);
+
+/**
+ * @brief Exports a column into consumer-allocated structs.
+ *
+ * The buffers stay valid until the consumer calls array->release, independent of other users
+ * of the column. Columns whose validity and data offsets differ cannot be exported.
+ *
+ * @param column Column to export.
+ * @param schema Receives the schema.
+ * @param array Receives the array.
+ */
+void hpx_arrow_export(std::shared_ptr<const ArrowColumn> column, ArrowSchema* schema, ArrowArray* array);
+
+/**
+ * @brief Counts valid elements equal to 'value' in an Int32 column.
+ *
+ * @param column Column to scan (read in place).
+ * @param value Value to count.
+ * @return A future that, when ready, returns the count (nulls never match).
+ */
+hpx::future<int64_t> hpx_arrow_count(ArrowColumn column, int32_t value);
+
+/**
+ * @brief Sorts an Int32 column ascending, nulls last.
+ *
+ * @param column Column to sort (read in place).
+ * @return A future that, when ready, returns a new natively owned column.
+ */
+hpx::future<std::shared_ptr<const ArrowColumn>> hpx_arrow_sort(ArrowColumn column);
+
+/**
+ * @brief Keeps the rows of an Int32 column whose Boolean mask entry is valid and true.
+ *
+ * Kept rows keep their nulls. Rows are counted per chunk, placed through a prefix sum and
+ * copied in parallel; the output validity bitmap is packed byte by byte.
+ *
+ * @param column Int32 column (read in place).
+ * @param mask Boolean column of the same length (read in place).
+ * @return A future that, when ready, returns a new natively owned column.
+ */
+hpx::future<std::shared_ptr<const ArrowColumn>> hpx_arrow_filter(ArrowColumn column, ArrowColumn mask);
+
+#endif // HPX_ARROW_HPP
@@ -0,0 +1,302 @@
+/*
+ * Arrow C Data Interface producer and consumer used by the addon tests, built as the
+ * hpx_test_arrow target. Structs live in a fixed table of slots that outlive them, so the tests
+ * can check afterwards what the addon did: whether it moved the producer's structs and how often
+ * their release callbacks ran.
+ *
+ *   produce(format, values, valid?)  Int32Array values for "i" (or any unsupported format),
+ *                                    Uint8Array 0/1 values for "b"; valid: Uint8Array, 0 = null.
+ *                                    Returns { slot, schema, array } with BigInt addresses.
+ *   releases(slot)                   { schema, array }: release callback calls so far.
+ *   moved(slot)                      True if both producer structs are marked released.
+ *   consumer()                       Empty structs to export into: { slot, schema, array }.
+ *   consume(slot)                    Reads an exported Int32 array: { format, length, nullCount,
+ *                                    offset, values: Int32Array, valid: Uint8Array }.
+ *   release(slot)                    Calls the exported release callbacks; true if both marked
+ *                                    the structs released.
+ */
+
+#include <node_api.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+#define SLOT_COUNT 64
+
+typedef struct slot {
+    struct ArrowSchema schema;
+    struct ArrowArray array;
+    char format[8];
+    const void* buffers[2];
+    // Release callbacks may run on any thread that drops the last reference
+    atomic_int schema_releases;
+    atomic_int array_releases;
+} slot;
+
+static slot slots[SLOT_COUNT];
+static int slots_used = 0;
+
+#define CHECK(call) do { if ((call) != napi_ok) return NULL; } while (0)
+
+static napi_value throw_error(napi_env env, const char* message) {
+    napi_throw_error(env, NULL, message);
+    return NULL;
+}
+
+static slot* new_slot(napi_env env) {
+    if (slots_used == SLOT_COUNT) {
+        throw_error(env, "No free test Arrow slots");
+        return NULL;
+    }
+    slot* s = &slots[slots_used++];
+    memset(&s->schema, 0, sizeof(s->schema));
+    memset(&s->array, 0, sizeof(s->array));
+    atomic_store(&s->schema_releases, 0);
+    atomic_store(&s->array_releases, 0);
+    return s;
+}
+
+static slot* get_slot(napi_env env, napi_value value) {
+    int32_t index = -1;
+    if (napi_get_value_int32(env, value, &index) != napi_ok || index < 0 || index >= slots_used) {
+        throw_error(env, "Unknown test Arrow slot");
+        return NULL;
+    }
+    return &slots[index];
+}
+
+// { slot, schema, array } for 's'
+static napi_value describe_slot(napi_env env, slot* s) {
+    napi_value result, index, schema, array;
+    CHECK(napi_create_object(env, &result));
+    CHECK(napi_create_int32(env, (int32_t)(s - slots), &index));
+    CHECK(napi_create_bigint_uint64(env, (uint64_t)(uintptr_t)&s->schema, &schema));
+    CHECK(napi_create_bigint_uint64(env, (uint64_t)(uintptr_t)&s->array, &array));
+    CHECK(napi_set_named_property(env, result, "slot", index));
+    CHECK(napi_set_named_property(env, result, "schema", schema));
+    CHECK(napi_set_named_property(env, result, "array", array));
+    return result;
+}
+
+static void release_schema(struct ArrowSchema* schema) {
+    atomic_fetch_add(&((slot*)schema->private_data)->schema_releases, 1);
+    schema->release = NULL;
+}
+
+static void release_array(struct ArrowArray* array) {
+    slot* s = (slot*)array->private_data;
+    free((void*)s->buffers[0]);
+    free((void*)s->buffers[1]);
+    s->buffers[0] = s->buffers[1] = NULL;
+    atomic_fetch_add(&s->array_releases, 1);
+    array->release = NULL;
+}
+
+static napi_value typed_array_data(napi_env env, napi_value value, napi_typedarray_type expected, void** data, size_t* length) {
+    bool is_typed_array = false;
+    napi_typedarray_type type;
+    if (napi_is_typedarray(env, value, &is_typed_array) != napi_ok || !is_typed_array ||
+        napi_get_typedarray_info(env, value, &type, length, data, NULL, NULL) != napi_ok || type != expected) {
+        return throw_error(env, "Unexpected typed array argument");
+    }
+    return value;
+}
+
+static napi_value produce(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    CHECK(napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+    if (argc < 2) return throw_error(env, "Expected (format, values, valid?)");
+    slot* s = new_slot(env);
+    if (!s) return NULL;
+    size_t format_length = 0;
+    CHECK(napi_get_value_string_utf8(env, args[0], s->format, sizeof(s->format), &format_length));
+    int boolean = strcmp(s->format, "b") == 0;
+
+    void* values = NULL;
+    size_t length = 0;
+    if (!typed_array_data(env, args[1], boolean ? napi_uint8_array : napi_int32_array, &values, &length)) return NULL;
+    uint8_t* valid = NULL;
+    size_t valid_length = 0;
+    if (argc > 2 && !typed_array_data(env, args[2], napi_uint8_array, (void**)&valid, &valid_length)) return NULL;
+    if (valid && valid_length != length) return throw_error(env, "valid must have one entry per value");
+
+    int64_t null_count = 0;
+    uint8_t* validity = NULL;
+    if (valid) {
+        validity = calloc((length + 7) / 8 + 1, 1);
+        for (size_t i = 0; i < length; ++i) {
+            if (valid[i]) validity[i >> 3] |= (uint8_t)(1u << (i & 7));
+            else ++null_count;
+        }
+    }
+    void* data;
+    if (boolean) {
+        uint8_t* bits = calloc((length + 7) / 8 + 1, 1);
+        for (size_t i = 0; i < length; ++i) {
+            if (((uint8_t*)values)[i]) bits[i >> 3] |= (uint8_t)(1u << (i & 7));
+        }
+        data = bits;
+    } else {
+        data = malloc(length * sizeof(int32_t) + 1);
+        memcpy(data, values, length * sizeof(int32_t));
+    }
+    s->buffers[0] = validity;
+    s->buffers[1] = data;
+
+    s->schema.format = s->format;
+    s->schema.name = "";
+    s->schema.flags = ARROW_FLAG_NULLABLE;
+    s->schema.release = release_schema;
+    s->schema.private_data = s;
+    s->array.length = (int64_t)length;
+    s->array.null_count = null_count;
+    s->array.n_buffers = 2;
+    s->array.buffers = s->buffers;
+    s->array.release = release_array;
+    s->array.private_data = s;
+    return describe_slot(env, s);
+}
+
+static napi_value releases(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value arg, result, schema, array;
+    CHECK(napi_get_cb_info(env, info, &argc, &arg, NULL, NULL));
+    slot* s = get_slot(env, arg);
+    if (!s) return NULL;
+    CHECK(napi_create_object(env, &result));
+    CHECK(napi_create_int32(env, atomic_load(&s->schema_releases), &schema));
+    CHECK(napi_create_int32(env, atomic_load(&s->array_releases), &array));
+    CHECK(napi_set_named_property(env, result, "schema", schema));
+    CHECK(napi_set_named_property(env, result, "array", array));
+    return result;
+}
+
+static napi_value moved(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value arg, result;
+    CHECK(napi_get_cb_info(env, info, &argc, &arg, NULL, NULL));
+    slot* s = get_slot(env, arg);
+    if (!s) return NULL;
+    CHECK(napi_get_boolean(env, s->schema.release == NULL && s->array.release == NULL, &result));
+    return result;
+}
+
+static napi_value consumer(napi_env env, napi_callback_info info) {
+    (void)info;
+    slot* s = new_slot(env);
+    if (!s) return NULL;
+    return describe_slot(env, s);
+}
+
+static napi_value consume(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value arg, result, value;
+    CHECK(napi_get_cb_info(env, info, &argc, &arg, NULL, NULL));
+    slot* s = get_slot(env, arg);
+    if (!s) return NULL;
+    const struct ArrowSchema* schema = &s->schema;
+    const struct ArrowArray* array = &s->array;
+    if (!schema->release || !array->release) return throw_error(env, "Nothing exported into this slot");
+    if (strcmp(schema->format, "i") != 0 || array->n_buffers != 2) return throw_error(env, "Expected an exported Int32 array");
+
+    size_t length = (size_t)array->length;
+    const uint8_t* validity = (const uint8_t*)array->buffers[0];
+    const int32_t* data = (const int32_t*)array->buffers[1] + array->offset;
+    napi_value values_buffer, valid_buffer, values, valid;
+    void* values_data;
+    void* valid_data;
+    CHECK(napi_create_arraybuffer(env, length * sizeof(int32_t), &values_data, &values_buffer));
+    CHECK(napi_create_typedarray(env, napi_int32_array, length, values_buffer, 0, &values));
+    CHECK(napi_create_arraybuffer(env, length, &valid_data, &valid_buffer));
+    CHECK(napi_create_typedarray(env, napi_uint8_array, length, valid_buffer, 0, &valid));
+    if (length > 0) memcpy(values_data, data, length * sizeof(int32_t));
+    for (size_t i = 0; i < length; ++i) {
+        int64_t bit = array->offset + (int64_t)i;
+        ((uint8_t*)valid_data)[i] = validity ? (validity[bit >> 3] >> (bit & 7)) & 1 : 1;
+    }
+
+    CHECK(napi_create_object(env, &result));
+    CHECK(napi_create_string_utf8(env, schema->format, NAPI_AUTO_LENGTH, &value));
+    CHECK(napi_set_named_property(env, result, "format", value));
+    CHECK(napi_create_int64(env, array->length, &value));
+    CHECK(napi_set_named_property(env, result, "length", value));
+    CHECK(napi_create_int64(env, array->null_count, &value));
+    CHECK(napi_set_named_property(env, result, "nullCount", value));
+    CHECK(napi_create_int64(env, array->offset, &value));
+    CHECK(napi_set_named_property(env, result, "offset", value));
+    CHECK(napi_set_named_property(env, result, "values", values));
+    CHECK(napi_set_named_property(env, result, "valid", valid));
+    return result;
+}
+
+static napi_value release(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value arg, result;
+    CHECK(napi_get_cb_info(env, info, &argc, &arg, NULL, NULL));
+    slot* s = get_slot(env, arg);
+    if (!s) return NULL;
+    if (!s->schema.release || !s->array.release) return throw_error(env, "Nothing exported into this slot");
+    s->schema.release(&s->schema);
+    s->array.release(&s->array);
+    CHECK(napi_get_boolean(env, s->schema.release == NULL && s->array.release == NULL, &result));
+    return result;
+}
+
+static napi_value init(napi_env env, napi_value exports) {
+    napi_property_descriptor properties[] = {
+        { "produce", NULL, produce, NULL, NULL, NULL, napi_default, NULL },
+        { "releases", NULL, releases, NULL, NULL, NULL, napi_default, NULL },
+        { "moved", NULL, moved, NULL, NULL, NULL, napi_default, NULL },
+        { "consumer", NULL, consumer, NULL, NULL, NULL, napi_default, NULL },
+        { "consume", NULL, consume, NULL, NULL, NULL, napi_default, NULL },
+        { "release", NULL, release, NULL, NULL, NULL, napi_default, NULL }
+    };
+    CHECK(napi_define_properties(env, exports, sizeof(properties) / sizeof(properties[0]), properties));
+    return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, init)
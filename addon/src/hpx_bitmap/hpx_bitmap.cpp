@@ -0,0 +1,227 @@
+#include "hpx_bitmap.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+size_t container_count(size_t size) {
+    return (size + kBitmapContainerBits - 1) / kBitmapContainerBits;
+}
+
+void check_size(size_t size) {
+    if (size > kBitmapMaxSize) throw std::length_error("Bitmap size exceeds 2^31 - 1 rows");
+}
+
+bool test_bit(const uint64_t* words, uint16_t low) {
+    return (words[low >> 6] >> (low & 63)) & 1;
+}
+
+uint32_t popcount(const uint64_t* words) {
+    uint32_t n = 0;
+    for (size_t i = 0; i < kBitmapContainerWords; ++i) n += static_cast<uint32_t>(__builtin_popcountll(words[i]));
+    return n;
+}
+
+// Calls f(low) for every set bit, ascending
+template <typename F>
+void for_each_bit(const uint64_t* words, F&& f) {
+    for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+        for (uint64_t w = words[i]; w != 0; w &= w - 1) {
+            f(static_cast<uint16_t>(i * 64 + __builtin_ctzll(w)));
+        }
+    }
+}
+
+// Switches 'container' to the smaller representation for its cardinality
+void normalize(BitmapContainer& container) {
+    if (container.Dense() && container.cardinality <= kBitmapArrayLimit) {
+        std::vector<uint16_t> values;
+        values.reserve(container.cardinality);
+        for_each_bit(container.words.data(), [&](uint16_t low) { values.push_back(low); });
+        container.values = std::move(values);
+        container.words = std::vector<uint64_t>();
+    } else if (!container.Dense() && container.cardinality > kBitmapArrayLimit) {
+        container.words.assign(kBitmapContainerWords, 0);
+        for (uint16_t low : container.values) container.words[low >> 6] |= uint64_t(1) << (low & 63);
+        container.values = std::vector<uint16_t>();
+    }
+}
+
+// The container's bits; sparse containers are expanded into 'scratch'
+const uint64_t* dense_words(const BitmapContainer& container, std::vector<uint64_t>& scratch) {
+    if (container.Dense()) return container.words.data();
+    scratch.assign(kBitmapContainerWords, 0);
+    for (uint16_t low : container.values) scratch[low >> 6] |= uint64_t(1) << (low & 63);
+    return scratch.data();
+}
+
+template <typename Op>
+BitmapContainer combine_words(const uint64_t* a, const uint64_t* b, Op op) {
+    BitmapContainer out;
+    out.words.resize(kBitmapContainerWords);
+    for (size_t i = 0; i < kBitmapContainerWords; ++i) out.words[i] = op(a[i], b[i]);
+    out.cardinality = popcount(out.words.data());
+    return out;
+}
+
+BitmapContainer combine(const BitmapContainer& a, const BitmapContainer& b, BitmapOp op) {
+    BitmapContainer out;
+    if (!a.Dense() && !b.Dense()) {
+        auto dst = std::back_inserter(out.values);
+        const auto &x = a.values, &y = b.values;
+        switch (op) {
+            case BitmapOp::And: std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), dst); break;
+            case BitmapOp::Or: std::set_union(x.begin(), x.end(), y.begin(), y.end(), dst); break;
+            case BitmapOp::Xor: std::set_symmetric_difference(x.begin(), x.end(), y.begin(), y.end(), dst); break;
+            case BitmapOp::AndNot: std::set_difference(x.begin(), x.end(), y.begin(), y.end(), dst); break;
+        }
+        out.cardinality = static_cast<uint32_t>(out.values.size());
+    } else if ((op == BitmapOp::And && (!a.Dense() || !b.Dense())) || (op == BitmapOp::AndNot && !a.Dense())) {
+        // The result is a subset of the array: test its rows against the bits
+        const BitmapContainer& array = a.Dense() ? b : a;
+        const uint64_t* bits = a.Dense() ? a.words.data() : b.words.data();
+        bool keep = op == BitmapOp::And;
+        for (uint16_t low : array.values) {
+            if (test_bit(bits, low) == keep) out.values.push_back(low);
+        }
+        out.cardinality = static_cast<uint32_t>(out.values.size());
+    } else {
+        std::vector<uint64_t> scratchA, scratchB;
+        const uint64_t* x = dense_words(a, scratchA);
+        const uint64_t* y = dense_words(b, scratchB);
+        switch (op) {
+            case BitmapOp::And: out = combine_words(x, y, [](uint64_t p, uint64_t q) { return p & q; }); break;
+            case BitmapOp::Or: out = combine_words(x, y, [](uint64_t p, uint64_t q) { return p | q; }); break;
+            case BitmapOp::Xor: out = combine_words(x, y, [](uint64_t p, uint64_t q) { return p ^ q; }); break;
+            case BitmapOp::AndNot: out = combine_words(x, y, [](uint64_t p, uint64_t q) { return p & ~q; }); break;
+        }
+    }
+    normalize(out);
+    return out;
+}
+
+} // namespace
+
+Bitmap::Bitmap(size_t size, std::vector<BitmapContainer> containers)
+    : size_(size), containers_(std::move(containers)) {
+    if (containers_.size() != container_count(size_)) throw std::invalid_argument("Bitmap container count does not match its size");
+    for (const BitmapContainer& container : containers_) cardinality_ += container.cardinality;
+}
+
+hpx::future<std::shared_ptr<const Bitmap>> hpx_bitmap_from_mask(const uint8_t* mask, size_t size) {
+    return hpx::async([mask, size]() {
+        check_size(size);
+        std::vector<BitmapContainer> containers(container_count(size));
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), containers.size(), [&](size_t c) {
+                const uint8_t* rows = mask + c * kBitmapContainerBits;
+                size_t length = std::min(kBitmapContainerBits, size - c * kBitmapContainerBits);
+                BitmapContainer& container = containers[c];
+                container.words.assign(kBitmapContainerWords, 0);
+                // Whole words are gathered in a register, which the compiler vectorizes
+                for (size_t w = 0; w < length / 64; ++w) {
+                    uint64_t bits = 0;
+                    for (size_t j = 0; j < 64; ++j) bits |= uint64_t(rows[w * 64 + j] != 0) << j;
+                    container.words[w] = bits;
+                }
+                for (size_t i = length / 64 * 64; i < length; ++i) {
+                    container.words[i >> 6] |= uint64_t(rows[i] != 0) << (i & 63);
+                }
+                container.cardinality = popcount(container.words.data());
+                normalize(container);
+            });
+        }, size);
+        return std::shared_ptr<const Bitmap>(std::make_shared<Bitmap>(size, std::move(containers)));
+    });
+}
+
+hpx::future<std::shared_ptr<const Bitmap>> hpx_bitmap_from_indices(const int32_t* indices, size_t count, size_t size) {
+    return hpx::async([indices, count, size]() {
+        check_size(size);
+        std::vector<int32_t> sorted(indices, indices + count);
+        std::vector<BitmapContainer> containers(container_count(size));
+        run_with_policy([&](auto policy) {
+            bool outside = hpx::any_of(policy, sorted.begin(), sorted.end(), [size](int32_t row) {
+                return row < 0 || static_cast<size_t>(row) >= size;
+            });
+            if (outside) throw std::out_of_range("Bitmap index out of range");
+            hpx::sort(policy, sorted.begin(), sorted.end());
+            hpx::experimental::for_loop(policy, size_t(0), containers.size(), [&](size_t c) {
+                int32_t base = static_cast<int32_t>(c * kBitmapContainerBits);
+                auto begin = std::lower_bound(sorted.begin(), sorted.end(), base);
+                auto end = std::lower_bound(begin, sorted.end(), static_cast<int64_t>(base) + int64_t(kBitmapContainerBits));
+                BitmapContainer& container = containers[c];
+                for (auto it = begin; it != end; ++it) {
+                    uint16_t low = static_cast<uint16_t>(*it - base);
+                    if (container.values.empty() || container.values.back() != low) container.values.push_back(low);
+                }
+                container.cardinality = static_cast<uint32_t>(container.values.size());
+                normalize(container);
+            });
+        }, count);
+        return std::shared_ptr<const Bitmap>(std::make_shared<Bitmap>(size, std::move(containers)));
+    });
+}
+
+hpx::future<std::shared_ptr<const Bitmap>> hpx_bitmap_combine(std::shared_ptr<const Bitmap> a, std::shared_ptr<const Bitmap> b, BitmapOp op) {
+    return hpx::async([a, b, op]() {
+        if (a->Size() != b->Size()) throw std::invalid_argument("Bitmaps have different sizes");
+        std::vector<BitmapContainer> containers(a->ContainerCount());
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), containers.size(), [&](size_t c) {
+                containers[c] = combine(a->Container(c), b->Container(c), op);
+            });
+        }, a->Size());
+        return std::shared_ptr<const Bitmap>(std::make_shared<Bitmap>(a->Size(), std::move(containers)));
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_bitmap_to_indices(std::shared_ptr<const Bitmap> bitmap) {
+    return hpx::async([bitmap]() {
+        size_t containers = bitmap->ContainerCount();
+        std::vector<size_t> starts(containers, 0);
+        size_t total = 0;
+        for (size_t c = 0; c < containers; ++c) {
+            starts[c] = total;
+            total += bitmap->Container(c).cardinality;
+        }
+        auto out = std::make_shared<std::vector<int32_t>>(total);
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), containers, [&](size_t c) {
+                const BitmapContainer& container = bitmap->Container(c);
+                int32_t base = static_cast<int32_t>(c * kBitmapContainerBits);
+                int32_t* dst = out->data() + starts[c];
+                if (container.Dense()) {
+                    for_each_bit(container.words.data(), [&](uint16_t low) { *dst++ = base + low; });
+                } else {
+                    for (uint16_t low : container.values) *dst++ = base + low;
+                }
+            });
+        }, bitmap->Size());
+        return out;
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_bitmap_to_mask(std::shared_ptr<const Bitmap> bitmap) {
+    return hpx::async([bitmap]() {
+        size_t size = bitmap->Size();
+        auto out = std::make_shared<std::vector<uint8_t>>(size, 0);
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), bitmap->ContainerCount(), [&](size_t c) {
+                const BitmapContainer& container = bitmap->Container(c);
+                uint8_t* rows = out->data() + c * kBitmapContainerBits;
+                if (container.Dense()) {
+                    size_t length = std::min(kBitmapContainerBits, size - c * kBitmapContainerBits);
+                    for (size_t i = 0; i < length; ++i) rows[i] = static_cast<uint8_t>((container.words[i >> 6] >> (i & 63)) & 1);
+                } else {
+                    for (uint16_t low : container.values) rows[low] = 1;
+                }
+            });
+        }, size);
+        return out;
+    });
+}
@@ -0,0 +1,111 @@
+#ifndef HPX_BITMAP_HPP
+#define HPX_BITMAP_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+// Rows per container; a row's container is its index >> 16
+constexpr size_t kBitmapContainerBits = 65536;
+constexpr size_t kBitmapContainerWords = kBitmapContainerBits / 64;
+// Containers with more rows set than this store bits (8 KiB), fewer store a sorted array
+constexpr size_t kBitmapArrayLimit = 4096;
+// Row indices are exposed as Int32, so bitmaps have at most 2^31 - 1 rows
+constexpr size_t kBitmapMaxSize = 2147483647;
+
+/**
+ * @brief The rows of one 65536-row slice of a Bitmap that are set.
+ *
+ * Dense containers hold kBitmapContainerWords words of bits, sparse ones the sorted low 16 bits
+ * of their rows (as in Roaring bitmaps). Exactly one of 'words' and 'values' is in use; empty
+ * containers are sparse and allocate nothing.
+ */
+struct BitmapContainer {
+    uint32_t cardinality = 0;
+    std::vector<uint64_t> words;
+    std::vector<uint16_t> values;
+
+    bool Dense() const { return !words.empty(); }
+};
+
+enum class BitmapOp { And, Or, Xor, AndNot };
+
+/**
+ * @brief Immutable set of rows in [0, size), split into containers of kBitmapContainerBits rows.
+ *
+ * Containers are independent, so every operation runs one task per container.
+ */
+class Bitmap {
+public:
+    Bitmap(size_t size, std::vector<BitmapContainer> containers);
+
+    size_t Size() const { return size_; }
+    int64_t Cardinality() const { return cardinality_; }
+    size_t ContainerCount() const { return containers_.size(); }
+    const BitmapContainer& Container(size_t c) const { return containers_[c]; }
+
+private:
+    size_t size_ = 0;
+    int64_t cardinality_ = 0;
+    std::vector<BitmapContainer> containers_;
+};
+
+/**
+ * @brief Builds a bitmap from a byte mask (non-zero = set), one container per task.
+ *
+ * @param mask Pointer to the mask (read in place).
+ * @param size Number of rows, at most kBitmapMaxSize.
+ * @return A future that, when ready, returns the bitmap.
+ */
+hpx::future<std::shared_ptr<const Bitmap>> hpx_bitmap_from_mask(const uint8_t* mask, size_t size);
+
+/**
+ * @brief Builds a bitmap from row indices, in any order and possibly repeated.
+ *
+ * The indices are sorted in parallel and split at container boundaries. Throws
+ * std::out_of_range if an index is negative or not below 'size'.
+ *
+ * @param indices Pointer to the indices (read in place).
+ * @param count Number of indices.
+ * @param size Number of rows, at most kBitmapMaxSize.
+ * @return A future that, when ready, returns the bitmap.
+ */
+hpx::future<std::shared_ptr<const Bitmap>> hpx_bitmap_from_indices(const int32_t* indices, size_t count, size_t size);
+
+/**
+ * @brief Combines two bitmaps of the same size container by container.
+ *
+ * Two arrays are merged, an array against bits is answered by bit tests where the result is a
+ * subset of the array (and, andNot), and everything else runs on words; each result container
+ * takes the smaller representation.
+ *
+ * @param a Left operand.
+ * @param b Right operand; must have the size of 'a' (std::invalid_argument otherwise).
+ * @param op Operation; AndNot keeps the rows of 'a' that are not in 'b'.
+ * @return A future that, when ready, returns the new bitmap.
+ */
+hpx::future<std::shared_ptr<const Bitmap>> hpx_bitmap_combine(std::shared_ptr<const Bitmap> a, std::shared_ptr<const Bitmap> b, BitmapOp op);
+
+/**
+ * @brief Lists the rows that are set, ascending.
+ *
+ * A prefix sum over the container cardinalities gives every container its output slice, which
+ * are then filled in parallel.
+ *
+ * @param bitmap The bitmap.
+ * @return A future that, when ready, returns the row indices.
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_bitmap_to_indices(std::shared_ptr<const Bitmap> bitmap);
+
+/**
+ * @brief Expands a bitmap into a byte mask (1 = set).
+ *
+ * @param bitmap The bitmap.
+ * @return A future that, when ready, returns Size() bytes.
+ */
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_bitmap_to_mask(std::shared_ptr<const Bitmap> bitmap);
+
+#endif // HPX_BITMAP_HPP
@@ -0,0 +1,224 @@
+#include "hpx_cluster.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace {
+
+// Independent partial sums per distance; lets the compiler vectorize the inner loop without
+// reassociating a single floating-point accumulator
+constexpr size_t kLanes = 8;
+
+// Points per assignment chunk
+constexpr size_t kPointsMinChunk = 1024;
+
+// Upper bound for the per-partition centroid accumulators (bytes)
+constexpr size_t kAccumulatorBudget = size_t(64) << 20;
+
+template <typename T>
+inline T squared_distance(const T* a, const T* b, size_t dim) {
+    T acc[kLanes] = {};
+    size_t j = 0;
+    for (; j + kLanes <= dim; j += kLanes) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            T d = a[j + l] - b[j + l];
+            acc[l] += d * d;
+        }
+    }
+    T sum = 0;
+    for (; j < dim; ++j) {
+        T d = a[j] - b[j];
+        sum += d * d;
+    }
+    for (size_t l = 0; l < kLanes; ++l) sum += acc[l];
+    return sum;
+}
+
+template <typename T>
+inline void nearest_centroid(const T* point, const T* centroids, size_t k, size_t dim, int32_t& best, T& best_distance) {
+    best = 0;
+    best_distance = squared_distance(point, centroids, dim);
+    for (size_t c = 1; c < k; ++c) {
+        T d = squared_distance(point, centroids + c * dim, dim);
+        if (d < best_distance) {
+            best_distance = d;
+            best = static_cast<int32_t>(c);
+        }
+    }
+}
+
+// k-means++ seeding. d2 holds each point's squared distance to its nearest chosen centroid;
+// the next centroid is found by drawing r in [0, sum(d2)) and walking the chunk sums first.
+template <typename Policy, typename T>
+void seed_plus_plus(Policy policy, const T* points, size_t count, size_t dim, size_t k, std::mt19937_64& rng, T* centroids) {
+    size_t chunks = chunk_count(count, kPointsMinChunk);
+    size_t chunk_size = (count + chunks - 1) / chunks;
+    std::vector<double> d2(count);
+    std::vector<double> sums(chunks);
+
+    size_t pick = std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+    std::copy(points + pick * dim, points + (pick + 1) * dim, centroids);
+    for (size_t c = 1; c < k; ++c) {
+        const T* center = centroids + (c - 1) * dim;
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t ch) {
+            size_t begin = std::min(count, ch * chunk_size);
+            size_t end = std::min(count, begin + chunk_size);
+            double sum = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                double d = static_cast<double>(squared_distance(points + i * dim, center, dim));
+                if (c == 1 || d < d2[i]) d2[i] = d;
+                sum += d2[i];
+            }
+            sums[ch] = sum;
+        });
+        double total = 0.0;
+        for (double s : sums) total += s;
+        if (!(total > 0.0)) {
+            // Every point coincides with a centroid; duplicates are unavoidable
+            pick = std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+        } else {
+            double r = std::uniform_real_distribution<double>(0.0, total)(rng);
+            size_t last = chunks - 1;
+            while (!(sums[last] > 0.0)) --last;
+            size_t ch = 0;
+            while (ch < last && r >= sums[ch]) r -= sums[ch++];
+            size_t begin = std::min(count, ch * chunk_size);
+            size_t end = std::min(count, begin + chunk_size);
+            pick = begin;
+            for (size_t i = begin; i < end; ++i) {
+                if (d2[i] > 0.0) pick = i;
+                if (r < d2[i]) break;
+                r -= d2[i];
+            }
+        }
+        std::copy(points + pick * dim, points + (pick + 1) * dim, centroids + c * dim);
+    }
+}
+
+// k distinct points drawn uniformly (Floyd's algorithm)
+template <typename T>
+void seed_random(const T* points, size_t count, size_t dim, size_t k, std::mt19937_64& rng, T* centroids) {
+    std::unordered_set<size_t> chosen;
+    size_t c = 0;
+    for (size_t j = count - k; j < count; ++j) {
+        size_t t = std::uniform_int_distribution<size_t>(0, j)(rng);
+        size_t pick = chosen.insert(t).second ? t : j;
+        if (pick == j) chosen.insert(j);
+        std::copy(points + pick * dim, points + (pick + 1) * dim, centroids + (c++) * dim);
+    }
+}
+
+} // namespace
+
+template <typename T>
+hpx::future<KMeansResult<T>> hpx_kmeans(const T* points, size_t count, size_t dim, size_t k, KMeansOptions options) {
+    if (dim == 0 || k == 0 || k > count) {
+        return hpx::make_exceptional_future<KMeansResult<T>>(std::runtime_error("k must be in [1, number of points] and dim > 0"));
+    }
+    if (count > static_cast<size_t>(std::numeric_limits<int32_t>::max()) ||
+        k > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        return hpx::make_exceptional_future<KMeansResult<T>>(std::runtime_error("Too many points for k-means"));
+    }
+    return hpx::async([points, count, dim, k, options]() {
+        KMeansResult<T> result;
+        result.centroids = std::make_shared<std::vector<T>>(k * dim);
+        result.assignments = std::make_shared<std::vector<int32_t>>(count, -1);
+        T* centroids = result.centroids->data();
+        int32_t* assignments = result.assignments->data();
+        std::mt19937_64 rng(options.seed);
+
+        run_with_policy([&](auto policy) {
+            if (options.init == KMeansInit::PlusPlus) seed_plus_plus(policy, points, count, dim, k, rng, centroids);
+            else seed_random(points, count, dim, k, rng, centroids);
+
+            size_t chunks = chunk_count(count, kPointsMinChunk);
+            size_t chunk_size = (count + chunks - 1) / chunks;
+            size_t per_part = k * dim * sizeof(double) + k * sizeof(int64_t);
+            size_t parts = std::max<size_t>(1, std::min(chunks, kAccumulatorBudget / per_part));
+            size_t part_size = (count + parts - 1) / parts;
+
+            std::vector<T> distances(count);
+            std::vector<double> chunk_inertia(chunks);
+            std::vector<size_t> chunk_changes(chunks);
+            std::vector<double> sums(parts * k * dim);
+            std::vector<int64_t> counts(parts * k);
+            double previous = 0.0;
+
+            for (size_t iteration = 0; ; ++iteration) {
+                // Assignment step
+                hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t ch) {
+                    size_t begin = std::min(count, ch * chunk_size);
+                    size_t end = std::min(count, begin + chunk_size);
+                    double inertia = 0.0;
+                    size_t changes = 0;
+                    for (size_t i = begin; i < end; ++i) {
+                        int32_t best;
+                        T d;
+                        nearest_centroid(points + i * dim, centroids, k, dim, best, d);
+                        changes += (assignments[i] != best);
+                        assignments[i] = best;
+                        distances[i] = d;
+                        inertia += static_cast<double>(d);
+                    }
+                    chunk_inertia[ch] = inertia;
+                    chunk_changes[ch] = changes;
+                });
+                double inertia = 0.0;
+                size_t changes = 0;
+                for (size_t ch = 0; ch < chunks; ++ch) {
+                    inertia += chunk_inertia[ch];
+                    changes += chunk_changes[ch];
+                }
+                result.inertia = inertia;
+                if (changes == 0 || (iteration > 0 && previous - inertia <= options.tolerance * previous)) {
+                    result.converged = true;
+                    break;
+                }
+                if (iteration == options.maxIterations) break;
+                previous = inertia;
+
+                // Update step: per-partition sums, merged per centroid coordinate
+                std::fill(sums.begin(), sums.end(), 0.0);
+                std::fill(counts.begin(), counts.end(), int64_t(0));
+                hpx::experimental::for_loop(policy, size_t(0), parts, [&](size_t p) {
+                    size_t begin = std::min(count, p * part_size);
+                    size_t end = std::min(count, begin + part_size);
+                    double* part_sums = sums.data() + p * k * dim;
+                    int64_t* part_counts = counts.data() + p * k;
+                    for (size_t i = begin; i < end; ++i) {
+                        size_t c = static_cast<size_t>(assignments[i]);
+                        ++part_counts[c];
+                        const T* point = points + i * dim;
+                        double* sum = part_sums + c * dim;
+                        for (size_t j = 0; j < dim; ++j) sum[j] += static_cast<double>(point[j]);
+                    }
+                });
+                hpx::experimental::for_loop(policy, size_t(0), k, [&](size_t c) {
+                    for (size_t p = 1; p < parts; ++p) counts[c] += counts[p * k + c];
+                });
+                hpx::experimental::for_loop(policy, size_t(0), k * dim, [&](size_t q) {
+                    size_t c = q / dim;
+                    if (counts[c] == 0) return;
+                    double sum = sums[q];
+                    for (size_t p = 1; p < parts; ++p) sum += sums[p * k * dim + q];
+                    centroids[q] = static_cast<T>(sum / static_cast<double>(counts[c]));
+                });
+                for (size_t c = 0; c < k; ++c) {
+                    if (counts[c] != 0) continue;
+                    size_t far = static_cast<size_t>(std::max_element(distances.begin(), distances.end()) - distances.begin());
+                    std::copy(points + far * dim, points + (far + 1) * dim, centroids + c * dim);
+                    distances[far] = 0;
+                }
+                result.iterations = iteration + 1;
+            }
+        }, count * dim);
+        return result;
+    });
+}
+
+template hpx::future<KMeansResult<float>> hpx_kmeans<float>(const float*, size_t, size_t, size_t, KMeansOptions);
+template hpx::future<KMeansResult<double>> hpx_kmeans<double>(const double*, size_t, size_t, size_t, KMeansOptions);
@@ -0,0 +1,62 @@
+#ifndef HPX_CLUSTER_HPP
+#define HPX_CLUSTER_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Centroid seeding used by hpx_kmeans.
+ */
+enum class KMeansInit {
+    PlusPlus,   // k-means++: each new centroid is drawn with probability proportional to D(x)^2
+    Random      // k distinct points drawn uniformly
+};
+
+/**
+ * @brief Options of hpx_kmeans.
+ */
+struct KMeansOptions {
+    size_t maxIterations = 100;
+    uint64_t seed = 0;
+    KMeansInit init = KMeansInit::PlusPlus;
+    // Stop once an iteration improves the inertia by at most this fraction
+    double tolerance = 1e-4;
+};
+
+/**
+ * @brief Result of hpx_kmeans. Assignments and inertia refer to the returned centroids.
+ */
+template <typename T>
+struct KMeansResult {
+    std::shared_ptr<std::vector<T>> centroids;          // k x dim, row-major
+    std::shared_ptr<std::vector<int32_t>> assignments;  // nearest centroid per point
+    double inertia = 0.0;                               // sum of squared distances to the nearest centroid
+    size_t iterations = 0;                              // centroid updates performed
+    bool converged = false;
+};
+
+/**
+ * @brief Lloyd's k-means over row-major points.
+ *
+ * Each iteration assigns every point to its nearest centroid in parallel chunks, then
+ * accumulates per-partition centroid sums (in double) that are merged into the new centroids.
+ * The number of accumulator partitions is capped so their memory stays bounded for large
+ * k * dim. Clusters that end up empty are reseeded with the point farthest from its centroid.
+ * Iteration stops when no assignment changes, the inertia improvement drops below the
+ * tolerance, or maxIterations updates were made.
+ *
+ * @param points Pointer to count x dim values (read in place).
+ * @param count Number of points.
+ * @param dim Dimensions per point (> 0).
+ * @param k Number of clusters, in [1, count].
+ * @param options Seeding, iteration limit and tolerance.
+ * @return A future that, when ready, returns centroids, assignments and inertia.
+ */
+template <typename T>
+hpx::future<KMeansResult<T>> hpx_kmeans(const T* points, size_t count, size_t dim, size_t k, KMeansOptions options);
+
+#endif // HPX_CLUSTER_HPP
@@ -0,0 +1,638 @@
+#include "hpx_encoding.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+// Strings per dictionary chunk
+constexpr size_t kDictMinChunk = 16384;
+
+constexpr uint64_t kEmptySlot = std::numeric_limits<uint64_t>::max();
+
+inline uint64_t fmix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t hash_string(const char* p, size_t n) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ (n * 0xC2B2AE3D27D4EB4FULL);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, p + i, 8);
+        h = (h ^ fmix64(v)) * 0x9E3779B97F4A7C15ULL;
+    }
+    if (i < n) {
+        uint64_t v = 0;
+        std::memcpy(&v, p + i, n - i);
+        h = (h ^ fmix64(v)) * 0x9E3779B97F4A7C15ULL;
+    }
+    return fmix64(h);
+}
+
+// Open-addressing set of caller-defined ids; the caller supplies hashes and equality. Slots keep
+// the upper hash half next to the id, so most mismatches are rejected without touching the keys.
+class IdTable {
+public:
+    explicit IdTable(size_t expected) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity *= 2;
+        slots_.assign(capacity, kEmptySlot);
+    }
+
+    // Returns the id of an equal entry already present, or inserts 'id' and returns it
+    template <typename Equal, typename HashOf>
+    uint32_t Insert(uint64_t hash, uint32_t id, Equal&& equal, HashOf&& hash_of) {
+        if ((count_ + 1) * 2 > slots_.size()) Grow(hash_of);
+        size_t mask = slots_.size() - 1;
+        for (size_t s = hash & mask; ; s = (s + 1) & mask) {
+            uint64_t slot = slots_[s];
+            if (slot == kEmptySlot) {
+                slots_[s] = (hash & kTagMask) | id;
+                ++count_;
+                return id;
+            }
+            uint32_t current = static_cast<uint32_t>(slot);
+            if ((slot & kTagMask) == (hash & kTagMask) && equal(current)) return current;
+        }
+    }
+
+private:
+    template <typename HashOf>
+    void Grow(HashOf& hash_of) {
+        std::vector<uint64_t> slots(slots_.size() * 2, kEmptySlot);
+        size_t mask = slots.size() - 1;
+        for (uint64_t slot : slots_) {
+            if (slot == kEmptySlot) continue;
+            size_t s = hash_of(static_cast<uint32_t>(slot)) & mask;
+            while (slots[s] != kEmptySlot) s = (s + 1) & mask;
+            slots[s] = slot;
+        }
+        slots_.swap(slots);
+    }
+
+    static constexpr uint64_t kTagMask = 0xFFFFFFFF00000000ULL;
+
+    std::vector<uint64_t> slots_;
+    size_t count_ = 0;
+};
+
+// Distinct strings of one chunk, in first-appearance order (local ids)
+struct ChunkDictionary {
+    std::vector<uint32_t> elements;       // first string index per local id
+    std::vector<uint64_t> hashes;         // hash per local id
+    std::vector<char> keys;               // copies of the distinct strings, compared instead of the input
+    std::vector<uint32_t> keyStarts;      // local id k owns keys[keyStarts[k], keyStarts[k + 1])
+    std::vector<uint32_t> byPartition;    // local ids grouped by merge partition
+    std::vector<size_t> partitionStarts;  // partition p owns byPartition[starts[p], starts[p + 1])
+    std::vector<uint64_t> owner;          // (chunk << 32 | local id) of the first global occurrence
+    std::vector<int32_t> codes;           // global code per local id
+};
+
+inline uint64_t pack(size_t chunk, uint32_t id) {
+    return (static_cast<uint64_t>(chunk) << 32) | id;
+}
+
+void validate_offsets(const uint32_t* offsets, size_t count, size_t byteLength) {
+    if (count > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        throw std::runtime_error("Too many strings for Int32 codes");
+    }
+    if (offsets[count] > byteLength) throw std::runtime_error("String offsets out of range");
+    std::atomic<bool> ok(true);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), count, [&](size_t i) {
+            if (offsets[i] > offsets[i + 1]) ok.store(false, std::memory_order_relaxed);
+        });
+    }, count);
+    if (!ok.load()) throw std::runtime_error("String offsets must be non-decreasing");
+}
+
+DictEncoding dict_encode(const char* bytes, size_t byteLength, const uint32_t* offsets, size_t count, bool sorted) {
+    validate_offsets(offsets, count, byteLength);
+    auto string_at = [&](uint32_t i) { return bytes + offsets[i]; };
+    auto length_at = [&](uint32_t i) { return static_cast<size_t>(offsets[i + 1] - offsets[i]); };
+    // Compares local id 'id' of 'd' with the n bytes at 'p'
+    auto same = [](const ChunkDictionary& d, uint32_t id, const char* p, size_t n) {
+        size_t begin = d.keyStarts[id];
+        return d.keyStarts[id + 1] - begin == n && (n == 0 || std::memcmp(d.keys.data() + begin, p, n) == 0);
+    };
+
+    DictEncoding result;
+    result.codes = std::make_shared<std::vector<int32_t>>(count);
+    result.bytes = std::make_shared<std::vector<char>>();
+    result.offsets = std::make_shared<std::vector<int32_t>>(1, 0);
+    int32_t* codes = result.codes->data();
+    size_t chunks = chunk_count(count, kDictMinChunk);
+    size_t chunk_size = (count + chunks - 1) / chunks;
+    size_t partitions = chunks;
+    std::vector<ChunkDictionary> dicts(chunks);
+
+    run_with_policy([&](auto policy) {
+        // Local dictionaries: codes[] temporarily holds local ids
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+            size_t begin = std::min(count, c * chunk_size);
+            size_t end = std::min(count, begin + chunk_size);
+            ChunkDictionary& d = dicts[c];
+            IdTable table(std::min<size_t>(end - begin, 1024));
+            auto hash_of = [&](uint32_t id) { return d.hashes[id]; };
+            d.keyStarts.push_back(0);
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t element = static_cast<uint32_t>(i);
+                const char* p = string_at(element);
+                size_t n = length_at(element);
+                uint64_t h = hash_string(p, n);
+                uint32_t next = static_cast<uint32_t>(d.elements.size());
+                uint32_t id = table.Insert(h, next, [&](uint32_t other) { return same(d, other, p, n); }, hash_of);
+                if (id == next) {
+                    d.elements.push_back(element);
+                    d.hashes.push_back(h);
+                    d.keys.insert(d.keys.end(), p, p + n);
+                    d.keyStarts.push_back(static_cast<uint32_t>(d.keys.size()));
+                }
+                codes[i] = static_cast<int32_t>(id);
+            }
+            // Group local ids by partition (counting sort keeps first-appearance order inside a group)
+            d.partitionStarts.assign(partitions + 1, 0);
+            for (uint64_t h : d.hashes) ++d.partitionStarts[(h >> 32) % partitions + 1];
+            for (size_t p = 0; p < partitions; ++p) d.partitionStarts[p + 1] += d.partitionStarts[p];
+            std::vector<size_t> cursor(d.partitionStarts.begin(), d.partitionStarts.end() - 1);
+            d.byPartition.resize(d.hashes.size());
+            for (uint32_t id = 0; id < d.hashes.size(); ++id) d.byPartition[cursor[(d.hashes[id] >> 32) % partitions]++] = id;
+            d.owner.resize(d.hashes.size());
+            d.codes.resize(d.hashes.size());
+        });
+
+        // Merge: each partition sees its strings chunk by chunk, so the first insert of a string
+        // is its first occurrence overall
+        hpx::experimental::for_loop(policy, size_t(0), partitions, [&](size_t p) {
+            std::vector<uint64_t> members;
+            size_t expected = 0;
+            for (const ChunkDictionary& d : dicts) expected += d.partitionStarts[p + 1] - d.partitionStarts[p];
+            IdTable table(expected);
+            auto hash_of = [&](uint32_t m) { return dicts[members[m] >> 32].hashes[static_cast<uint32_t>(members[m])]; };
+            for (size_t c = 0; c < chunks; ++c) {
+                ChunkDictionary& d = dicts[c];
+                for (size_t k = d.partitionStarts[p]; k < d.partitionStarts[p + 1]; ++k) {
+                    uint32_t id = d.byPartition[k];
+                    uint64_t h = d.hashes[id];
+                    uint32_t next = static_cast<uint32_t>(members.size());
+                    const char* key = d.keys.data() + d.keyStarts[id];
+                    size_t n = d.keyStarts[id + 1] - d.keyStarts[id];
+                    uint32_t m = table.Insert(h, next, [&](uint32_t other) {
+                        return same(dicts[members[other] >> 32], static_cast<uint32_t>(members[other]), key, n);
+                    }, hash_of);
+                    if (m == next) members.push_back(pack(c, id));
+                    d.owner[id] = members[m];
+                }
+            }
+        });
+
+        // Global codes in first-appearance order: first occurrences are numbered chunk by chunk
+        std::vector<size_t> firsts(chunks + 1, 0);
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+            size_t n = 0;
+            for (uint32_t id = 0; id < dicts[c].owner.size(); ++id) n += dicts[c].owner[id] == pack(c, id);
+            firsts[c + 1] = n;
+        });
+        for (size_t c = 0; c < chunks; ++c) firsts[c + 1] += firsts[c];
+        size_t distinct = firsts[chunks];
+        std::vector<uint32_t> dictionary(distinct);
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+            ChunkDictionary& d = dicts[c];
+            size_t code = firsts[c];
+            for (uint32_t id = 0; id < d.owner.size(); ++id) {
+                if (d.owner[id] != pack(c, id)) continue;
+                d.codes[id] = static_cast<int32_t>(code);
+                dictionary[code++] = d.elements[id];
+            }
+        });
+
+        // Sorted codes: rank the distinct strings byte-wise and renumber
+        std::vector<int32_t> rank;
+        if (sorted) {
+            std::vector<uint32_t> order(distinct);
+            std::iota(order.begin(), order.end(), 0u);
+            hpx::sort(policy, order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                uint32_t ea = dictionary[a], eb = dictionary[b];
+                size_t na = length_at(ea), nb = length_at(eb);
+                int cmp = std::min(na, nb) == 0 ? 0 : std::memcmp(string_at(ea), string_at(eb), std::min(na, nb));
+                return cmp < 0 || (cmp == 0 && na < nb);
+            });
+            rank.resize(distinct);
+            std::vector<uint32_t> ordered(distinct);
+            hpx::experimental::for_loop(policy, size_t(0), distinct, [&](size_t r) {
+                rank[order[r]] = static_cast<int32_t>(r);
+                ordered[r] = dictionary[order[r]];
+            });
+            dictionary.swap(ordered);
+        }
+
+        // Later occurrences take the code of their first occurrence
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+            ChunkDictionary& d = dicts[c];
+            for (uint32_t id = 0; id < d.owner.size(); ++id) {
+                uint64_t o = d.owner[id];
+                if (o != pack(c, id)) d.codes[id] = dicts[o >> 32].codes[static_cast<uint32_t>(o)];
+            }
+        });
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+            size_t begin = std::min(count, c * chunk_size);
+            size_t end = std::min(count, begin + chunk_size);
+            const std::vector<int32_t>& local = dicts[c].codes;
+            for (size_t i = begin; i < end; ++i) {
+                int32_t code = local[static_cast<size_t>(codes[i])];
+                codes[i] = sorted ? rank[static_cast<size_t>(code)] : code;
+            }
+        });
+
+        // Dictionary strings, concatenated in code order
+        std::vector<int32_t>& dict_offsets = *result.offsets;
+        dict_offsets.resize(distinct + 1);
+        uint64_t total = 0;
+        for (size_t k = 0; k < distinct; ++k) {
+            dict_offsets[k] = static_cast<int32_t>(total);
+            total += length_at(dictionary[k]);
+            if (total > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+                throw std::runtime_error("Dictionary too large for Int32 offsets");
+            }
+        }
+        dict_offsets[distinct] = static_cast<int32_t>(total);
+        result.bytes->resize(static_cast<size_t>(total));
+        char* out = result.bytes->data();
+        hpx::experimental::for_loop(policy, size_t(0), distinct, [&](size_t k) {
+            size_t n = length_at(dictionary[k]);
+            if (n > 0) std::memcpy(out + dict_offsets[k], string_at(dictionary[k]), n);
+        });
+    }, count);
+    return result;
+}
+
+} // namespace
+
+hpx::future<DictEncoding> hpx_dict_encode(const char* bytes, size_t byteLength, const uint32_t* offsets, size_t count, bool sorted) {
+    return hpx::async([bytes, byteLength, offsets, count, sorted]() {
+        return dict_encode(bytes, byteLength, offsets, count, sorted);
+    });
+}
+
+namespace {
+
+constexpr char kBitpackMagic[4] = { 'H', 'B', 'P', '1' };
+constexpr uint32_t kBitpackDeltaFlag = 1;
+constexpr size_t kBitpackHeaderSize = 16;
+constexpr size_t kBitpackPadding = 8;
+
+static_assert(sizeof(BitpackBlock) == 24, "BitpackBlock is part of the encoded format");
+
+inline uint64_t load64(const uint8_t* p) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+inline uint8_t bit_width(uint32_t range) {
+    uint8_t bits = 0;
+    while (range) {
+        ++bits;
+        range >>= 1;
+    }
+    return bits;
+}
+
+// Values packed in block b: all of them, or all but the first with delta coding
+inline size_t packed_count(size_t length, bool delta) {
+    return delta ? length - 1 : length;
+}
+
+inline size_t payload_bytes(size_t count, unsigned bits) {
+    return (count * bits + 7) / 8;
+}
+
+// Packs 'count' values LSB-first at 'bits' bits each
+void pack_bits(const uint32_t* in, size_t count, unsigned bits, uint8_t* out) {
+    if (bits == 0) return;
+    uint64_t acc = 0;
+    unsigned filled = 0;
+    for (size_t i = 0; i < count; ++i) {
+        acc |= static_cast<uint64_t>(in[i]) << filled;
+        filled += bits;
+        if (filled >= 32) {
+            uint32_t low = static_cast<uint32_t>(acc);
+            std::memcpy(out, &low, sizeof(low));
+            out += 4;
+            acc >>= 32;
+            filled -= 32;
+        }
+    }
+    for (; filled > 0; filled = filled > 8 ? filled - 8 : 0) {
+        *out++ = static_cast<uint8_t>(acc);
+        acc >>= 8;
+    }
+}
+
+// Eight values span exactly Bits bytes, so with Bits fixed every lane's byte offset and shift
+// are constants and the compiler unrolls and vectorizes the loop
+template <unsigned Bits>
+void unpack_bits(const uint8_t* in, size_t count, uint32_t* out) {
+    if constexpr (Bits == 0) {
+        std::fill_n(out, count, 0u);
+    } else {
+        constexpr uint64_t mask = (uint64_t(1) << Bits) - 1;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8, in += Bits) {
+            for (unsigned j = 0; j < 8; ++j) {
+                out[i + j] = static_cast<uint32_t>((load64(in + (j * Bits >> 3)) >> (j * Bits & 7)) & mask);
+            }
+        }
+        for (unsigned j = 0; i < count; ++i, ++j) {
+            out[i] = static_cast<uint32_t>((load64(in + (j * Bits >> 3)) >> (j * Bits & 7)) & mask);
+        }
+    }
+}
+
+using UnpackFn = void (*)(const uint8_t*, size_t, uint32_t*);
+
+template <size_t... Bits>
+constexpr std::array<UnpackFn, sizeof...(Bits)> make_unpackers(std::index_sequence<Bits...>) {
+    return {{ &unpack_bits<Bits>... }};
+}
+
+constexpr auto kUnpackers = make_unpackers(std::make_index_sequence<33>{});
+
+// Runs f(b, decode) over all blocks in parallel; decode() unpacks block b and returns its values.
+// Each task walks a run of blocks in order and reuses one block-sized scratch buffer (4 KiB at
+// the default block size), so decoded values are consumed while still in L1.
+template <typename F>
+void scan_blocks(const BitpackedColumn& column, F&& f) {
+    size_t blocks = column.BlockCount();
+    if (blocks == 0) return;
+    size_t chunks = std::min(blocks, chunk_count(column.Size()));
+    size_t chunk_size = (blocks + chunks - 1) / chunks;
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+            std::vector<int32_t> scratch;
+            size_t begin = std::min(blocks, c * chunk_size);
+            size_t end = std::min(blocks, begin + chunk_size);
+            for (size_t b = begin; b < end; ++b) {
+                f(b, [&]() -> const int32_t* {
+                    if (scratch.empty()) scratch.resize(column.BlockSize());
+                    column.DecodeBlock(b, scratch.data());
+                    return scratch.data();
+                });
+            }
+        });
+    }, column.Size());
+}
+
+} // namespace
+
+BitpackedColumn BitpackedColumn::Parse(const uint8_t* bytes, size_t byteLength) {
+    auto invalid = [](const std::string& what) { return std::runtime_error("Invalid bit-packed data: " + what); };
+    if (byteLength < kBitpackHeaderSize + kBitpackPadding || std::memcmp(bytes, kBitpackMagic, 4) != 0) {
+        throw invalid("missing header");
+    }
+    uint32_t header[3];
+    std::memcpy(header, bytes + 4, sizeof(header));
+    BitpackedColumn column;
+    column.delta_ = (header[0] & kBitpackDeltaFlag) != 0;
+    column.size_ = header[1];
+    column.blockSize_ = header[2];
+    if (header[0] & ~kBitpackDeltaFlag) throw invalid("unknown flags");
+    if (column.blockSize_ == 0 || column.blockSize_ > (size_t(1) << 20)) throw invalid("bad block size");
+
+    size_t blocks = (column.size_ + column.blockSize_ - 1) / column.blockSize_;
+    size_t headersEnd = kBitpackHeaderSize + blocks * sizeof(BitpackBlock);
+    if (headersEnd + kBitpackPadding > byteLength) throw invalid("truncated block headers");
+    column.blocks_.resize(blocks);
+    if (blocks > 0) std::memcpy(column.blocks_.data(), bytes + kBitpackHeaderSize, blocks * sizeof(BitpackBlock));
+    column.payload_ = bytes + headersEnd;
+    size_t payloadLimit = byteLength - headersEnd - kBitpackPadding;
+    for (size_t b = 0; b < blocks; ++b) {
+        const BitpackBlock& block = column.blocks_[b];
+        if (block.bits > 32) throw invalid("bit width above 32 in block " + std::to_string(b));
+        size_t bytesNeeded = payload_bytes(packed_count(column.BlockLength(b), column.delta_), block.bits);
+        if (block.offset > payloadLimit || bytesNeeded > payloadLimit - block.offset) {
+            throw invalid("payload of block " + std::to_string(b) + " out of range");
+        }
+    }
+    return column;
+}
+
+void BitpackedColumn::DecodeBlock(size_t b, int32_t* out) const {
+    const BitpackBlock& block = blocks_[b];
+    size_t length = BlockLength(b);
+    uint32_t reference = static_cast<uint32_t>(block.reference);
+    // int32 and uint32 may alias; all arithmetic wraps like the encoder's
+    uint32_t* values = reinterpret_cast<uint32_t*>(out);
+    if (!delta_) {
+        kUnpackers[block.bits](payload_ + block.offset, length, values);
+        for (size_t i = 0; i < length; ++i) values[i] += reference;
+        return;
+    }
+    kUnpackers[block.bits](payload_ + block.offset, length - 1, values + 1);
+    uint32_t running = static_cast<uint32_t>(block.first);
+    values[0] = running;
+    for (size_t i = 1; i < length; ++i) {
+        running += values[i] + reference;
+        values[i] = running;
+    }
+}
+
+int64_t BitpackedColumn::Count(int32_t value) const {
+    std::vector<int64_t> partial(BlockCount(), 0);
+    scan_blocks(*this, [&](size_t b, auto decode) {
+        const BitpackBlock& block = blocks_[b];
+        if (value < block.min || value > block.max) return;
+        size_t length = BlockLength(b);
+        if (block.min == block.max) {
+            partial[b] = static_cast<int64_t>(length);
+            return;
+        }
+        const int32_t* v = decode();
+        int64_t n = 0;
+        for (size_t i = 0; i < length; ++i) n += (v[i] == value);
+        partial[b] = n;
+    });
+    return std::accumulate(partial.begin(), partial.end(), int64_t(0));
+}
+
+int64_t BitpackedColumn::Find(int32_t value) const {
+    std::atomic<size_t> best(size_);
+    scan_blocks(*this, [&](size_t b, auto decode) {
+        const BitpackBlock& block = blocks_[b];
+        size_t begin = b * blockSize_;
+        if (begin >= best.load(std::memory_order_relaxed)) return;
+        if (value < block.min || value > block.max) return;
+        size_t pos = begin;
+        if (block.min != block.max) {
+            const int32_t* v = decode();
+            const int32_t* it = std::find(v, v + BlockLength(b), value);
+            if (it == v + BlockLength(b)) return;
+            pos += static_cast<size_t>(it - v);
+        }
+        size_t cur = best.load(std::memory_order_relaxed);
+        while (pos < cur && !best.compare_exchange_weak(cur, pos, std::memory_order_relaxed)) {}
+    });
+    size_t pos = best.load();
+    return pos == size_ ? static_cast<int64_t>(-1) : static_cast<int64_t>(pos);
+}
+
+int64_t BitpackedColumn::CountRange(int32_t lo, int32_t hi) const {
+    if (lo > hi) return 0;
+    // v in [lo, hi] <=> (v - lo) <= (hi - lo) modulo 2^32, as in ResidentBuffer::CountRange
+    uint32_t base = static_cast<uint32_t>(lo);
+    uint32_t width = static_cast<uint32_t>(hi) - base;
+    std::vector<int64_t> partial(BlockCount(), 0);
+    scan_blocks(*this, [&](size_t b, auto decode) {
+        const BitpackBlock& block = blocks_[b];
+        if (block.max < lo || block.min > hi) return;
+        size_t length = BlockLength(b);
+        if (block.min >= lo && block.max <= hi) {
+            partial[b] = static_cast<int64_t>(length);
+            return;
+        }
+        const int32_t* v = decode();
+        int64_t n = 0;
+        for (size_t i = 0; i < length; ++i) n += (static_cast<uint32_t>(v[i]) - base <= width);
+        partial[b] = n;
+    });
+    return std::accumulate(partial.begin(), partial.end(), int64_t(0));
+}
+
+int64_t BitpackedColumn::Sum() const {
+    std::vector<int64_t> partial(BlockCount(), 0);
+    scan_blocks(*this, [&](size_t b, auto decode) {
+        const BitpackBlock& block = blocks_[b];
+        size_t length = BlockLength(b);
+        if (block.min == block.max) {
+            partial[b] = static_cast<int64_t>(block.min) * static_cast<int64_t>(length);
+            return;
+        }
+        const int32_t* v = decode();
+        int64_t total = 0;
+        for (size_t i = 0; i < length; ++i) total += v[i];
+        partial[b] = total;
+    });
+    return std::accumulate(partial.begin(), partial.end(), int64_t(0));
+}
+
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_bitpack_encode(const int32_t* src, size_t size, bool delta) {
+    return hpx::async([src, size, delta]() {
+        if (size > std::numeric_limits<uint32_t>::max()) throw std::runtime_error("Too many values to bit-pack");
+        size_t blocks = (size + kBitpackBlockSize - 1) / kBitpackBlockSize;
+        std::vector<BitpackBlock> headers(blocks);
+        std::vector<size_t> offsets(blocks + 1, 0);
+        auto out = std::make_shared<std::vector<uint8_t>>();
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), blocks, [&](size_t b) {
+                const int32_t* v = src + b * kBitpackBlockSize;
+                size_t length = std::min(kBitpackBlockSize, size - b * kBitpackBlockSize);
+                BitpackBlock& block = headers[b];
+                block = BitpackBlock{};
+                block.first = v[0];
+                block.min = *std::min_element(v, v + length);
+                block.max = *std::max_element(v, v + length);
+                uint32_t range = static_cast<uint32_t>(block.max) - static_cast<uint32_t>(block.min);
+                block.reference = block.min;
+                if (delta) {
+                    int32_t lo = 0, hi = 0;
+                    for (size_t i = 1; i < length; ++i) {
+                        int32_t d = static_cast<int32_t>(static_cast<uint32_t>(v[i]) - static_cast<uint32_t>(v[i - 1]));
+                        if (i == 1 || d < lo) lo = d;
+                        if (i == 1 || d > hi) hi = d;
+                    }
+                    block.reference = lo;
+                    range = static_cast<uint32_t>(hi) - static_cast<uint32_t>(lo);
+                }
+                block.bits = bit_width(range);
+                offsets[b + 1] = payload_bytes(packed_count(length, delta), block.bits);
+            });
+            for (size_t b = 0; b < blocks; ++b) offsets[b + 1] += offsets[b];
+            if (offsets[blocks] > std::numeric_limits<uint32_t>::max()) throw std::runtime_error("Bit-packed payload exceeds 4 GiB");
+
+            size_t headersEnd = kBitpackHeaderSize + blocks * sizeof(BitpackBlock);
+            out->assign(headersEnd + offsets[blocks] + kBitpackPadding, 0);
+            uint8_t* bytes = out->data();
+            uint32_t header[3] = { delta ? kBitpackDeltaFlag : 0u, static_cast<uint32_t>(size), static_cast<uint32_t>(kBitpackBlockSize) };
+            std::memcpy(bytes, kBitpackMagic, 4);
+            std::memcpy(bytes + 4, header, sizeof(header));
+            uint8_t* payload = bytes + headersEnd;
+
+            hpx::experimental::for_loop(policy, size_t(0), blocks, [&](size_t b) {
+                const int32_t* v = src + b * kBitpackBlockSize;
+                size_t length = std::min(kBitpackBlockSize, size - b * kBitpackBlockSize);
+                BitpackBlock& block = headers[b];
+                block.offset = static_cast<uint32_t>(offsets[b]);
+                uint32_t reference = static_cast<uint32_t>(block.reference);
+                uint32_t scratch[kBitpackBlockSize];
+                size_t count = packed_count(length, delta);
+                for (size_t i = 0; i < count; ++i) {
+                    uint32_t value = delta ? static_cast<uint32_t>(v[i + 1]) - static_cast<uint32_t>(v[i]) : static_cast<uint32_t>(v[i]);
+                    scratch[i] = value - reference;
+                }
+                pack_bits(scratch, count, block.bits, payload + offsets[b]);
+            });
+            if (blocks > 0) std::memcpy(bytes + kBitpackHeaderSize, headers.data(), blocks * sizeof(BitpackBlock));
+        }, size);
+        return out;
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_bitpack_decode(BitpackedColumn column, size_t begin, size_t end) {
+    return hpx::async([column = std::move(column), begin, end]() {
+        size_t stop = std::min(end, column.Size());
+        size_t start = std::min(begin, stop);
+        auto out = std::make_shared<std::vector<int32_t>>(stop - start);
+        if (start == stop) return out;
+        size_t blockSize = column.BlockSize();
+        size_t firstBlock = start / blockSize;
+        size_t lastBlock = (stop - 1) / blockSize;
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, firstBlock, lastBlock + 1, [&](size_t b) {
+                size_t blockBegin = b * blockSize;
+                size_t length = column.BlockLength(b);
+                size_t from = std::max(start, blockBegin);
+                size_t to = std::min(stop, blockBegin + length);
+                int32_t* dst = out->data() + (from - start);
+                if (from == blockBegin && to == blockBegin + length) {
+                    column.DecodeBlock(b, dst);
+                } else {
+                    // Partial blocks at the ends of the range go through scratch
+                    std::vector<int32_t> scratch(length);
+                    column.DecodeBlock(b, scratch.data());
+                    std::copy(scratch.begin() + (from - blockBegin), scratch.begin() + (to - blockBegin), dst);
+                }
+            });
+        }, stop - start);
+        return out;
+    });
+}
+
+hpx::future<int64_t> hpx_bitpack_count(BitpackedColumn column, int32_t value) {
+    return hpx::async([column = std::move(column), value]() { return column.Count(value); });
+}
+
+hpx::future<int64_t> hpx_bitpack_find(BitpackedColumn column, int32_t value) {
+    return hpx::async([column = std::move(column), value]() { return column.Find(value); });
+}
+
+hpx::future<int64_t> hpx_bitpack_count_range(BitpackedColumn column, int32_t lo, int32_t hi) {
+    return hpx::async([column = std::move(column), lo, hi]() { return column.CountRange(lo, hi); });
+}
+
+hpx::future<int64_t> hpx_bitpack_sum(BitpackedColumn column) {
+    return hpx::async([column = std::move(column)]() { return column.Sum(); });
+}
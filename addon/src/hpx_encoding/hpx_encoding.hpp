@@ -0,0 +1,149 @@
+#ifndef HPX_ENCODING_HPP
+#define HPX_ENCODING_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Result of hpx_dict_encode: one code per string plus the distinct strings, stored
+ * like the input (concatenated bytes and count + 1 offsets).
+ */
+struct DictEncoding {
+    std::shared_ptr<std::vector<int32_t>> codes;
+    std::shared_ptr<std::vector<char>> bytes;
+    std::shared_ptr<std::vector<int32_t>> offsets;
+};
+
+/**
+ * @brief Replaces variable-length strings by dense Int32 codes.
+ *
+ * Strings are given as a byte buffer and offsets (string i is bytes[offsets[i], offsets[i + 1])).
+ * Chunks of strings are hashed into per-chunk dictionaries in parallel. The chunk dictionaries
+ * are then merged in parallel hash partitions, and every code is remapped to its global value.
+ * By default codes follow first appearance; with 'sorted' they follow the byte-wise order of the
+ * strings, so comparing codes compares strings.
+ *
+ * @param bytes Pointer to the string bytes (read in place).
+ * @param byteLength Number of bytes.
+ * @param offsets Pointer to count + 1 non-decreasing offsets, the last one at most byteLength.
+ * @param count Number of strings.
+ * @param sorted Assign codes in string order instead of first-appearance order.
+ * @return A future that, when ready, returns the codes and the dictionary.
+ */
+hpx::future<DictEncoding> hpx_dict_encode(const char* bytes, size_t byteLength, const uint32_t* offsets, size_t count, bool sorted);
+
+// Values per block of hpx_bitpack_encode; a decoded block (4 KiB) stays in L1
+constexpr size_t kBitpackBlockSize = 1024;
+
+/**
+ * @brief Header of one block of a bit-packed column.
+ *
+ * A block stores its values (or, with delta coding, the differences between neighbours after
+ * 'first') as value - reference in 'bits' bits each. min/max allow skipping blocks without
+ * unpacking them.
+ */
+struct BitpackBlock {
+    int32_t min;
+    int32_t max;
+    int32_t first;          // first value of the block (delta coding starts from it)
+    int32_t reference;      // frame of reference: smallest value, or smallest delta
+    uint32_t offset;        // payload offset, relative to the payload section
+    uint8_t bits;           // bits per packed value, 0-32
+    uint8_t reserved[3];
+};
+
+/**
+ * @brief Read-only view of a column produced by hpx_bitpack_encode.
+ *
+ * Layout (little-endian): a 16-byte header ("HBP1", flags, value count, block size), one
+ * BitpackBlock per block, the packed payloads, and 8 zero bytes so unpacking may read whole
+ * words past the last payload. Blocks are independent, so any range decodes from the blocks
+ * it overlaps only.
+ */
+class BitpackedColumn {
+public:
+    // Validates the layout of 'bytes' (read in place); throws std::runtime_error if malformed
+    static BitpackedColumn Parse(const uint8_t* bytes, size_t byteLength);
+
+    size_t Size() const { return size_; }
+    bool Delta() const { return delta_; }
+    size_t BlockSize() const { return blockSize_; }
+    size_t BlockCount() const { return blocks_.size(); }
+    const BitpackBlock& Block(size_t b) const { return blocks_[b]; }
+
+    // Number of values in block b
+    size_t BlockLength(size_t b) const { return std::min(blockSize_, size_ - b * blockSize_); }
+
+    // Decodes block b into out[0, BlockLength(b))
+    void DecodeBlock(size_t b, int32_t* out) const;
+
+    // Queries on the packed blocks. Blocks whose header min/max rule them out are skipped and
+    // blocks that match as a whole are counted from the header; only the rest are unpacked.
+    int64_t Count(int32_t value) const;
+    int64_t Find(int32_t value) const;
+    int64_t CountRange(int32_t lo, int32_t hi) const;
+    int64_t Sum() const;
+
+private:
+    const uint8_t* payload_ = nullptr;
+    size_t size_ = 0;
+    size_t blockSize_ = kBitpackBlockSize;
+    bool delta_ = false;
+    std::vector<BitpackBlock> blocks_;   // copied out, as the input may be unaligned
+};
+
+/**
+ * @brief Compresses an Int32 column with frame-of-reference bit-packing.
+ *
+ * Each block of kBitpackBlockSize values is packed at the bit width of its value range; with
+ * 'delta' the differences between neighbours are packed instead, which suits sorted IDs and
+ * timestamps. Block headers are computed in parallel, a prefix sum places the payloads and the
+ * blocks are packed in parallel.
+ *
+ * @param src Pointer to the values (read in place).
+ * @param size Number of values.
+ * @param delta Pack differences between neighbouring values.
+ * @return A future that, when ready, returns the encoded bytes (see BitpackedColumn).
+ */
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_bitpack_encode(const int32_t* src, size_t size, bool delta);
+
+/**
+ * @brief Decodes the values [begin, end) of a bit-packed column, one block per task.
+ *
+ * @param column Parsed column; its bytes must stay valid until the future is ready.
+ * @param begin First value to decode.
+ * @param end One past the last value (clamped to the column size).
+ * @return A future that, when ready, returns the decoded values.
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_bitpack_decode(BitpackedColumn column, size_t begin, size_t end);
+
+/**
+ * @brief Counts occurrences of 'value' in a bit-packed column without decoding it.
+ *
+ * @param column Parsed column; its bytes must stay valid until the future is ready.
+ * @param value Value to count.
+ * @return A future that, when ready, returns the count.
+ */
+hpx::future<int64_t> hpx_bitpack_count(BitpackedColumn column, int32_t value);
+
+/**
+ * @brief Finds the first index of 'value' (-1 if absent) in a bit-packed column.
+ */
+hpx::future<int64_t> hpx_bitpack_find(BitpackedColumn column, int32_t value);
+
+/**
+ * @brief Counts values in [lo, hi]; blocks entirely inside the range are counted from their header.
+ */
+hpx::future<int64_t> hpx_bitpack_count_range(BitpackedColumn column, int32_t lo, int32_t hi);
+
+/**
+ * @brief Sums a bit-packed column; constant blocks are summed from their header.
+ */
+hpx::future<int64_t> hpx_bitpack_sum(BitpackedColumn column);
+
+#endif // HPX_ENCODING_HPP
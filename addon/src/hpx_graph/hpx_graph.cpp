@@ -0,0 +1,252 @@
+#include "hpx_graph.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Direction switching thresholds (Beamer et al.): go bottom-up once the frontier's edges exceed
+// 1/kAlpha of the unexplored edges, and back top-down once the frontier holds fewer than
+// 1/kBeta of the vertices
+constexpr int64_t kAlpha = 14;
+constexpr int64_t kBeta = 24;
+
+// Frontier vertices per top-down chunk (each may own many edges)
+constexpr size_t kFrontierMinChunk = 64;
+
+using AtomicVertices = std::vector<std::atomic<int32_t>>;
+
+void validate_graph(const CsrGraph& g) {
+    if (g.vertices >= static_cast<size_t>(std::numeric_limits<int32_t>::max()) ||
+        g.edgeCount > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        throw std::runtime_error("Graph too large");
+    }
+    if (g.offsets[0] != 0 || static_cast<size_t>(g.offsets[g.vertices]) != g.edgeCount) {
+        throw std::runtime_error("Invalid CSR offsets");
+    }
+    std::atomic<bool> offsets_ok(true), edges_ok(true);
+    int32_t n = static_cast<int32_t>(g.vertices);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), g.vertices, [&](size_t u) {
+            if (g.offsets[u] > g.offsets[u + 1]) offsets_ok.store(false, std::memory_order_relaxed);
+        });
+        hpx::experimental::for_loop(policy, size_t(0), g.edgeCount, [&](size_t e) {
+            if (g.edges[e] < 0 || g.edges[e] >= n) edges_ok.store(false, std::memory_order_relaxed);
+        });
+    }, g.vertices + g.edgeCount);
+    if (!offsets_ok.load()) throw std::runtime_error("Invalid CSR offsets");
+    if (!edges_ok.load()) throw std::runtime_error("Edge target out of range");
+}
+
+inline int64_t out_degree(const CsrGraph& g, int32_t u) {
+    return g.offsets[u + 1] - g.offsets[u];
+}
+
+// Concatenates per-chunk vertex lists in chunk order
+template <typename Policy>
+void gather(Policy policy, const std::vector<std::vector<int32_t>>& parts, std::vector<int32_t>& out) {
+    std::vector<size_t> starts(parts.size() + 1, 0);
+    for (size_t c = 0; c < parts.size(); ++c) starts[c + 1] = starts[c] + parts[c].size();
+    out.resize(starts.back());
+    hpx::experimental::for_loop(policy, size_t(0), parts.size(), [&](size_t c) {
+        std::copy(parts[c].begin(), parts[c].end(), out.begin() + starts[c]);
+    });
+}
+
+// Builds the in-edge CSR of g (neighbour order within a vertex is unspecified)
+template <typename Policy>
+void transpose_graph(Policy policy, const CsrGraph& g, std::vector<int32_t>& offsets, std::vector<int32_t>& edges) {
+    size_t n = g.vertices;
+    AtomicVertices cursor(n);
+    hpx::experimental::for_loop(policy, size_t(0), g.edgeCount, [&](size_t e) {
+        cursor[g.edges[e]].fetch_add(1, std::memory_order_relaxed);
+    });
+    offsets.assign(n + 1, 0);
+    for (size_t v = 0; v < n; ++v) {
+        int32_t count = cursor[v].load(std::memory_order_relaxed);
+        cursor[v].store(offsets[v], std::memory_order_relaxed);
+        offsets[v + 1] = offsets[v] + count;
+    }
+    edges.resize(g.edgeCount);
+    hpx::experimental::for_loop(policy, size_t(0), n, [&](size_t u) {
+        for (int32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            edges[cursor[g.edges[e]].fetch_add(1, std::memory_order_relaxed)] = static_cast<int32_t>(u);
+        }
+    });
+}
+
+// Frontier vertices claim their unvisited neighbours. Returns the out-edges of the new frontier.
+template <typename Policy>
+int64_t top_down_step(Policy policy, const CsrGraph& g, AtomicVertices& levels, const std::vector<int32_t>& frontier,
+                      int32_t depth, std::vector<int32_t>& next) {
+    size_t chunks = chunk_count(frontier.size(), kFrontierMinChunk);
+    size_t chunk_size = (frontier.size() + chunks - 1) / chunks;
+    std::vector<std::vector<int32_t>> parts(chunks);
+    std::vector<int64_t> edges(chunks, 0);
+    hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+        size_t begin = std::min(frontier.size(), c * chunk_size);
+        size_t end = std::min(frontier.size(), begin + chunk_size);
+        for (size_t i = begin; i < end; ++i) {
+            int32_t u = frontier[i];
+            for (int32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                int32_t v = g.edges[e];
+                if (levels[v].load(std::memory_order_relaxed) != -1) continue;
+                int32_t expected = -1;
+                if (levels[v].compare_exchange_strong(expected, depth + 1, std::memory_order_relaxed)) {
+                    parts[c].push_back(v);
+                    edges[c] += out_degree(g, v);
+                }
+            }
+        }
+    });
+    gather(policy, parts, next);
+    int64_t total = 0;
+    for (int64_t n : edges) total += n;
+    return total;
+}
+
+// Every unvisited vertex looks for an in-neighbour on the frontier (level == depth) and stops at
+// the first one. Only vertex v writes levels[v], so no CAS is needed. Returns the out-edges of
+// the new frontier.
+template <typename Policy>
+int64_t bottom_up_step(Policy policy, const CsrGraph& g, const CsrGraph& in, AtomicVertices& levels,
+                       int32_t depth, std::vector<int32_t>& next) {
+    size_t n = g.vertices;
+    size_t chunks = chunk_count(n);
+    size_t chunk_size = (n + chunks - 1) / chunks;
+    std::vector<std::vector<int32_t>> parts(chunks);
+    std::vector<int64_t> edges(chunks, 0);
+    hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+        size_t begin = std::min(n, c * chunk_size);
+        size_t end = std::min(n, begin + chunk_size);
+        for (size_t v = begin; v < end; ++v) {
+            if (levels[v].load(std::memory_order_relaxed) != -1) continue;
+            for (int32_t e = in.offsets[v]; e < in.offsets[v + 1]; ++e) {
+                if (levels[in.edges[e]].load(std::memory_order_relaxed) != depth) continue;
+                levels[v].store(depth + 1, std::memory_order_relaxed);
+                parts[c].push_back(static_cast<int32_t>(v));
+                edges[c] += out_degree(g, static_cast<int32_t>(v));
+                break;
+            }
+        }
+    });
+    gather(policy, parts, next);
+    int64_t total = 0;
+    for (int64_t m : edges) total += m;
+    return total;
+}
+
+// Root of x's tree with path halving. Parents only ever move to ancestors, and every parent is
+// smaller than its child, so concurrent halving and hooking stay consistent.
+int32_t find_root(AtomicVertices& parent, int32_t x) {
+    while (true) {
+        int32_t p = parent[x].load(std::memory_order_relaxed);
+        if (p == x) return x;
+        int32_t gp = parent[p].load(std::memory_order_relaxed);
+        if (gp == p) return p;
+        parent[x].store(gp, std::memory_order_relaxed);
+        x = gp;
+    }
+}
+
+// Merges the trees of u and v by hooking the larger root under the smaller one
+void link(AtomicVertices& parent, int32_t u, int32_t v) {
+    while (true) {
+        u = find_root(parent, u);
+        v = find_root(parent, v);
+        if (u == v) return;
+        if (u < v) std::swap(u, v);
+        int32_t expected = u;
+        if (parent[u].compare_exchange_strong(expected, v, std::memory_order_relaxed)) return;
+    }
+}
+
+} // namespace
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_bfs(CsrGraph graph, size_t source, bool symmetric) {
+    return hpx::async([graph, source, symmetric]() {
+        validate_graph(graph);
+        if (source >= graph.vertices) throw std::out_of_range("BFS source vertex out of range");
+        size_t n = graph.vertices;
+        AtomicVertices levels(n);
+        std::vector<int32_t> in_offsets, in_edges;
+        CsrGraph in = graph;
+        bool have_in = symmetric;
+
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), n, [&](size_t v) {
+                levels[v].store(-1, std::memory_order_relaxed);
+            });
+            int32_t start = static_cast<int32_t>(source);
+            levels[start].store(0, std::memory_order_relaxed);
+            std::vector<int32_t> frontier{ start }, next;
+            int64_t frontier_edges = out_degree(graph, start);
+            int64_t unexplored_edges = static_cast<int64_t>(graph.edgeCount) - frontier_edges;
+            bool bottom_up = false;
+
+            for (int32_t depth = 0; !frontier.empty(); ++depth) {
+                if (bottom_up) {
+                    bottom_up = frontier.size() >= n / kBeta;
+                } else {
+                    bottom_up = frontier_edges > unexplored_edges / kAlpha;
+                }
+                if (bottom_up && !have_in) {
+                    transpose_graph(policy, graph, in_offsets, in_edges);
+                    in = CsrGraph{ in_offsets.data(), n, in_edges.data(), in_edges.size() };
+                    have_in = true;
+                }
+                next.clear();
+                frontier_edges = bottom_up
+                    ? bottom_up_step(policy, graph, in, levels, depth, next)
+                    : top_down_step(policy, graph, levels, frontier, depth, next);
+                unexplored_edges -= frontier_edges;
+                frontier.swap(next);
+            }
+        }, graph.vertices + graph.edgeCount);
+
+        auto out = std::make_shared<std::vector<int32_t>>(n);
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), n, [&](size_t v) {
+                (*out)[v] = levels[v].load(std::memory_order_relaxed);
+            });
+        }, n);
+        return out;
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_connected_components(CsrGraph graph) {
+    return hpx::async([graph]() {
+        validate_graph(graph);
+        size_t n = graph.vertices;
+        AtomicVertices parent(n);
+        auto out = std::make_shared<std::vector<int32_t>>(n);
+
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), n, [&](size_t v) {
+                parent[v].store(static_cast<int32_t>(v), std::memory_order_relaxed);
+            });
+            // Partitioned by edges rather than vertices, so high-degree vertices do not
+            // serialize a chunk; each chunk finds the source of its first edge by binary search.
+            size_t chunks = chunk_count(graph.edgeCount);
+            size_t chunk_size = (graph.edgeCount + chunks - 1) / chunks;
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                int32_t begin = static_cast<int32_t>(std::min(graph.edgeCount, c * chunk_size));
+                int32_t end = static_cast<int32_t>(std::min(graph.edgeCount, c * chunk_size + chunk_size));
+                if (begin >= end) return;
+                const int32_t* first = std::upper_bound(graph.offsets, graph.offsets + n + 1, begin);
+                int32_t u = static_cast<int32_t>(first - graph.offsets) - 1;
+                for (int32_t e = begin; e < end; ++e) {
+                    while (graph.offsets[u + 1] <= e) ++u;
+                    if (graph.edges[e] != u) link(parent, u, graph.edges[e]);
+                }
+            });
+            hpx::experimental::for_loop(policy, size_t(0), n, [&](size_t v) {
+                (*out)[v] = find_root(parent, static_cast<int32_t>(v));
+            });
+        }, graph.vertices + graph.edgeCount);
+        return out;
+    });
+}
@@ -0,0 +1,52 @@
+#ifndef HPX_GRAPH_HPP
+#define HPX_GRAPH_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Read-only view of a graph in CSR form (both arrays are read in place).
+ *
+ * The out-neighbours of vertex u are edges[offsets[u], offsets[u + 1]). Offsets start at 0,
+ * never decrease and end at edgeCount; every edge names a vertex in [0, vertices).
+ */
+struct CsrGraph {
+    const int32_t* offsets = nullptr;
+    size_t vertices = 0;
+    const int32_t* edges = nullptr;
+    size_t edgeCount = 0;
+};
+
+/**
+ * @brief Breadth-first search levels from a source vertex.
+ *
+ * Direction-optimizing: levels are expanded top-down (frontier vertices claim unvisited
+ * neighbours with a CAS) while the frontier is small, and bottom-up (every unvisited vertex
+ * looks for a parent in the frontier and stops at the first hit) once the frontier's edges
+ * outweigh a fraction of the unexplored ones. Bottom-up steps need in-edges: a symmetric graph
+ * is its own transpose, otherwise the transpose is built the first time a step goes bottom-up.
+ *
+ * @param graph The graph; it is validated before the search.
+ * @param source The start vertex, in [0, vertices).
+ * @param symmetric True if every edge (u, v) has a matching (v, u).
+ * @return A future that, when ready, returns the level of each vertex (-1 = unreachable).
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_bfs(CsrGraph graph, size_t source, bool symmetric);
+
+/**
+ * @brief Connected components, treating every edge as undirected (weak connectivity).
+ *
+ * Lock-free union-find: edges are processed in parallel and hook the larger of two roots under
+ * the smaller with a CAS, with path halving on the way up. Every tree root therefore stays the
+ * smallest vertex of its tree, so labels do not depend on scheduling.
+ *
+ * @param graph The graph; it is validated before labelling.
+ * @return A future that, when ready, returns per vertex the smallest vertex id of its component.
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_connected_components(CsrGraph graph);
+
+#endif // HPX_GRAPH_HPP
@@ -0,0 +1,193 @@
+#include "hpx_index.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Maps int32 to uint32 preserving order, so (value, position) pairs sort as one uint64 key.
+inline uint32_t order_preserving(int32_t v) {
+    return static_cast<uint32_t>(v) ^ 0x80000000u;
+}
+
+inline int32_t from_order_preserving(uint32_t u) {
+    return static_cast<int32_t>(u ^ 0x80000000u);
+}
+
+inline uint32_t key_of(uint64_t packed) {
+    return static_cast<uint32_t>(packed >> 32);
+}
+
+} // namespace
+
+hpx::future<std::shared_ptr<const ValueIndex>> ValueIndex::Build(const int32_t* src, size_t size) {
+    // Positions are exposed as Int32 (-1 = absent) by the batch lookups
+    if (size > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        return hpx::make_exceptional_future<std::shared_ptr<const ValueIndex>>(std::runtime_error("Array too large for a value index"));
+    }
+    auto packed = std::make_shared<std::vector<uint64_t>>(size);
+    return hpx::async([src, size, packed]() {
+        auto index = std::make_shared<ValueIndex>();
+        run_with_policy([&](auto policy) {
+            // Sorting (value, position) as a single integer key groups equal values
+            // and keeps their positions ascending without a stable sort.
+            hpx::experimental::for_loop(policy, size_t(0), size, [&](size_t i) {
+                (*packed)[i] = (static_cast<uint64_t>(order_preserving(src[i])) << 32) | static_cast<uint64_t>(i);
+            });
+            hpx::sort(policy, packed->begin(), packed->end());
+
+            index->ownedPositions_.resize(size);
+            hpx::experimental::for_loop(policy, size_t(0), size, [&](size_t i) {
+                index->ownedPositions_[i] = static_cast<uint32_t>((*packed)[i]);
+            });
+
+            // Group starts are compacted in parallel: count per chunk, scan, write.
+            size_t chunks = chunk_count(size);
+            size_t chunk_size = (size + chunks - 1) / chunks;
+            std::vector<size_t> starts(chunks + 1, 0);
+            auto is_start = [&](size_t i) {
+                return i == 0 || key_of((*packed)[i]) != key_of((*packed)[i - 1]);
+            };
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(size, c * chunk_size);
+                size_t end = std::min(size, begin + chunk_size);
+                size_t n = 0;
+                for (size_t i = begin; i < end; ++i) n += is_start(i);
+                starts[c + 1] = n;
+            });
+            for (size_t c = 0; c < chunks; ++c) starts[c + 1] += starts[c];
+
+            size_t distinct = starts[chunks];
+            index->ownedKeys_.resize(distinct);
+            index->ownedOffsets_.resize(distinct + 1);
+            index->ownedOffsets_[distinct] = static_cast<uint32_t>(size);
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(size, c * chunk_size);
+                size_t end = std::min(size, begin + chunk_size);
+                size_t slot = starts[c];
+                for (size_t i = begin; i < end; ++i) {
+                    if (!is_start(i)) continue;
+                    index->ownedKeys_[slot] = from_order_preserving(key_of((*packed)[i]));
+                    index->ownedOffsets_[slot] = static_cast<uint32_t>(i);
+                    ++slot;
+                }
+            });
+        }, size);
+        index->keys_ = index->ownedKeys_.data();
+        index->offsets_ = index->ownedOffsets_.data();
+        index->positions_ = index->ownedPositions_.data();
+        index->distinct_ = index->ownedKeys_.size();
+        index->size_ = size;
+        return std::shared_ptr<const ValueIndex>(std::move(index));
+    });
+}
+
+std::shared_ptr<const ValueIndex> ValueIndex::FromArrays(std::shared_ptr<const void> storage, const int32_t* keys, size_t distinct,
+                                                         const uint32_t* offsets, const uint32_t* positions, size_t size) {
+    auto index = std::make_shared<ValueIndex>();
+    index->storage_ = std::move(storage);
+    index->keys_ = keys;
+    index->offsets_ = offsets;
+    index->positions_ = positions;
+    index->distinct_ = distinct;
+    index->size_ = size;
+    return index;
+}
+
+size_t ValueIndex::Lookup(int32_t value) const {
+    const int32_t* it = std::lower_bound(keys_, keys_ + distinct_, value);
+    if (it == keys_ + distinct_ || *it != value) return distinct_;
+    return static_cast<size_t>(it - keys_);
+}
+
+int64_t ValueIndex::Count(int32_t value) const {
+    size_t k = Lookup(value);
+    if (k == distinct_) return 0;
+    return static_cast<int64_t>(offsets_[k + 1] - offsets_[k]);
+}
+
+int64_t ValueIndex::Find(int32_t value) const {
+    size_t k = Lookup(value);
+    if (k == distinct_) return -1;
+    return static_cast<int64_t>(positions_[offsets_[k]]);
+}
+
+std::pair<const uint32_t*, const uint32_t*> ValueIndex::FindAll(int32_t value) const {
+    size_t k = Lookup(value);
+    if (k == distinct_) return { nullptr, nullptr };
+    return { positions_ + offsets_[k], positions_ + offsets_[k + 1] };
+}
+
+ZoneMap ZoneMap::Build(const int32_t* data, size_t size) {
+    ZoneMap zones;
+    size_t blocks = (size + kBlockSize - 1) / kBlockSize;
+    zones.min_.resize(blocks);
+    zones.max_.resize(blocks);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), blocks, [&](size_t b) {
+            size_t begin = b * kBlockSize;
+            size_t end = std::min(size, begin + kBlockSize);
+            int32_t lo = data[begin], hi = data[begin];
+            for (size_t i = begin; i < end; ++i) {
+                lo = std::min(lo, data[i]);
+                hi = std::max(hi, data[i]);
+            }
+            zones.min_[b] = lo;
+            zones.max_[b] = hi;
+        });
+    }, size);
+    return zones;
+}
+
+ZoneMap ZoneMap::FromBounds(std::vector<int32_t> min, std::vector<int32_t> max) {
+    ZoneMap zones;
+    zones.min_ = std::move(min);
+    zones.max_ = std::move(max);
+    return zones;
+}
+
+void ZoneMap::Update(const int32_t* data, size_t size, size_t offset, size_t count) {
+    if (count == 0) return;
+    size_t last = offset + count;
+    for (size_t b = offset / kBlockSize; b * kBlockSize < last; ++b) {
+        size_t block_begin = b * kBlockSize;
+        size_t block_end = std::min(size, block_begin + kBlockSize);
+        size_t begin = std::max(offset, block_begin);
+        size_t end = std::min(last, block_end);
+        bool whole = (begin == block_begin && end == block_end);
+        int32_t lo = whole ? data[begin] : min_[b];
+        int32_t hi = whole ? data[begin] : max_[b];
+        for (size_t i = begin; i < end; ++i) {
+            lo = std::min(lo, data[i]);
+            hi = std::max(hi, data[i]);
+        }
+        min_[b] = lo;
+        max_[b] = hi;
+    }
+}
+
+hpx::future<std::shared_ptr<std::vector<uint32_t>>> hpx_value_index_count_batch(std::shared_ptr<const ValueIndex> index, const int32_t* values, size_t size) {
+    return hpx::async([index, values, size]() {
+        return run_with_policy([&](auto policy) {
+            auto out = std::make_shared<std::vector<uint32_t>>(size);
+            hpx::experimental::for_loop(policy, size_t(0), size, [&](size_t i) {
+                (*out)[i] = static_cast<uint32_t>(index->Count(values[i]));
+            });
+            return out;
+        }, size);
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_value_index_find_batch(std::shared_ptr<const ValueIndex> index, const int32_t* values, size_t size) {
+    return hpx::async([index, values, size]() {
+        return run_with_policy([&](auto policy) {
+            auto out = std::make_shared<std::vector<int32_t>>(size);
+            hpx::experimental::for_loop(policy, size_t(0), size, [&](size_t i) {
+                (*out)[i] = static_cast<int32_t>(index->Find(values[i]));
+            });
+            return out;
+        }, size);
+    });
+}
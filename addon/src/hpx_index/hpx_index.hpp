@@ -0,0 +1,159 @@
+#ifndef HPX_INDEX_HPP
+#define HPX_INDEX_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Immutable value -> positions index over an unsorted Int32 array.
+ *
+ * Built once in parallel, it answers count/find/findAll for any value with a binary search
+ * over the distinct values instead of a full scan. Layout (CSR style):
+ * - keys_:      distinct values in ascending order
+ * - offsets_:   offsets_[k]..offsets_[k+1] is the slice of positions_ holding keys_[k]
+ * - positions_: all source positions, grouped by value, ascending within each group
+ */
+class ValueIndex {
+public:
+    /**
+     * @brief Builds an index over the given array (the data is not retained).
+     *
+     * @param src Pointer to the input array of int32_t elements.
+     * @param size Number of elements in the input array, at most INT32_MAX (positions are reported
+     *             as Int32 by the batch lookups); larger arrays make the future fail.
+     * @return A future that, when ready, returns the shared, immutable index.
+     */
+    static hpx::future<std::shared_ptr<const ValueIndex>> Build(const int32_t* src, size_t size);
+
+    /**
+     * @brief Wraps previously built arrays held by external storage (e.g. a file mapping).
+     *
+     * The arrays must have the layout Build produces; the caller validates them.
+     *
+     * @param storage Keeps the arrays alive for the lifetime of the index.
+     * @param keys Pointer to 'distinct' ascending keys.
+     * @param distinct Number of distinct values.
+     * @param offsets Pointer to distinct + 1 offsets into 'positions'.
+     * @param positions Pointer to 'size' positions.
+     * @param size Number of indexed elements.
+     */
+    static std::shared_ptr<const ValueIndex> FromArrays(std::shared_ptr<const void> storage, const int32_t* keys, size_t distinct,
+                                                        const uint32_t* offsets, const uint32_t* positions, size_t size);
+
+    // Number of indexed elements
+    size_t Size() const { return size_; }
+
+    // Number of distinct values
+    size_t DistinctCount() const { return distinct_; }
+
+    // Raw layout, for serialization
+    const int32_t* Keys() const { return keys_; }
+    const uint32_t* Offsets() const { return offsets_; }
+    const uint32_t* Positions() const { return positions_; }
+
+    // Number of occurrences of 'value'
+    int64_t Count(int32_t value) const;
+
+    // First position of 'value', or -1 if absent
+    int64_t Find(int32_t value) const;
+
+    // Ascending positions of 'value' as a [begin, end) range into the index (empty if absent)
+    std::pair<const uint32_t*, const uint32_t*> FindAll(int32_t value) const;
+
+private:
+    // Slot of 'value' in keys_, or distinct_ if absent
+    size_t Lookup(int32_t value) const;
+
+    // Arrays filled by Build; empty when the index wraps external storage
+    std::vector<int32_t> ownedKeys_;
+    std::vector<uint32_t> ownedOffsets_;
+    std::vector<uint32_t> ownedPositions_;
+    std::shared_ptr<const void> storage_;
+
+    const int32_t* keys_ = nullptr;
+    const uint32_t* offsets_ = nullptr;
+    const uint32_t* positions_ = nullptr;
+    size_t distinct_ = 0;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Block summary (zone map) index: min/max per fixed-size block of an Int32 array.
+ *
+ * Scans consult it to skip blocks whose [min, max] cannot contain what they look for.
+ * Bounds are conservative: partial writes only widen a block's range, while a block that is
+ * overwritten entirely gets exact bounds again. Widened bounds cost skipping opportunities,
+ * never correctness.
+ */
+class ZoneMap {
+public:
+    static constexpr size_t kBlockSize = 65536;
+
+    // Builds the block summaries in parallel (blocks the calling HPX thread)
+    static ZoneMap Build(const int32_t* data, size_t size);
+
+    // Restores a zone map from saved bounds (one entry per block)
+    static ZoneMap FromBounds(std::vector<int32_t> min, std::vector<int32_t> max);
+
+    size_t BlockCount() const { return min_.size(); }
+
+    // Per-block bounds, for serialization
+    const std::vector<int32_t>& Min() const { return min_; }
+    const std::vector<int32_t>& Max() const { return max_; }
+
+    // False if no element of 'block' can equal 'value'
+    bool MayContain(size_t block, int32_t value) const {
+        return min_[block] <= value && value <= max_[block];
+    }
+
+    // False if no element of 'block' can fall into [lo, hi]
+    bool MayOverlap(size_t block, int32_t lo, int32_t hi) const {
+        return min_[block] <= hi && lo <= max_[block];
+    }
+
+    // True if every element of 'block' is known to fall into [lo, hi]
+    bool Within(size_t block, int32_t lo, int32_t hi) const {
+        return lo <= min_[block] && max_[block] <= hi;
+    }
+
+    /**
+     * @brief Refreshes the summaries after data[offset, offset + count) was overwritten.
+     *
+     * @param data Pointer to the whole (already updated) array.
+     * @param size Number of elements in the whole array.
+     * @param offset First written element.
+     * @param count Number of written elements.
+     */
+    void Update(const int32_t* data, size_t size, size_t offset, size_t count);
+
+private:
+    std::vector<int32_t> min_;
+    std::vector<int32_t> max_;
+};
+
+/**
+ * @brief Counts many values against an index in parallel.
+ *
+ * @param index The index to query.
+ * @param values Pointer to the values to count (read in place).
+ * @param size Number of values.
+ * @return A future that, when ready, returns one count per value.
+ */
+hpx::future<std::shared_ptr<std::vector<uint32_t>>> hpx_value_index_count_batch(std::shared_ptr<const ValueIndex> index, const int32_t* values, size_t size);
+
+/**
+ * @brief Finds the first position of many values against an index in parallel.
+ *
+ * @param index The index to query.
+ * @param values Pointer to the values to look up (read in place).
+ * @param size Number of values.
+ * @return A future that, when ready, returns one first position per value (-1 if absent).
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_value_index_find_batch(std::shared_ptr<const ValueIndex> index, const int32_t* values, size_t size);
+
+#endif // HPX_INDEX_HPP
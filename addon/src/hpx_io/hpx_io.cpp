@@ -0,0 +1,293 @@
+#include "hpx_io.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Bytes per parse chunk at least; chunks then grow to their next line start
+constexpr size_t kParseMinChunk = size_t(1) << 20;
+
+// Bytes per search chunk at least
+constexpr size_t kScanMinChunk = size_t(256) << 10;
+
+// Candidates tested per first/last-byte filter step
+constexpr size_t kFilterBlock = 64;
+
+constexpr size_t kNoError = static_cast<size_t>(-1);
+
+// Concatenates per-chunk results in chunk order
+template <typename Policy, typename T>
+void concat_parts(Policy policy, const std::vector<std::vector<T>>& parts, std::vector<T>& out) {
+    std::vector<size_t> offsets(parts.size() + 1, 0);
+    for (size_t c = 0; c < parts.size(); ++c) offsets[c + 1] = offsets[c] + parts[c].size();
+    out.resize(offsets.back());
+    hpx::experimental::for_loop(policy, size_t(0), parts.size(), [&](size_t c) {
+        std::copy(parts[c].begin(), parts[c].end(), out.begin() + offsets[c]);
+    });
+}
+
+inline bool is_blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+// Parses all of [first, last) as a double. Floating-point std::from_chars needs libstdc++ 11 or
+// libc++ 17; older libraries fall back to strtod on a NUL-terminated copy, rejecting the hex
+// floats that from_chars would not accept. strtod reads the C locale, which Node never changes.
+inline bool parse_double(const char* first, const char* last, double& d) {
+#if defined(__cpp_lib_to_chars)
+    auto res = std::from_chars(first, last, d);
+    return res.ec == std::errc() && res.ptr == last;
+#else
+    if (std::find_if(first, last, [](char c) { return c == 'x' || c == 'X'; }) != last) return false;
+    char small[64];
+    std::string large;
+    size_t length = static_cast<size_t>(last - first);
+    char* copy = small;
+    if (length >= sizeof(small)) {
+        large.assign(first, last);
+        copy = &large[0];
+    } else {
+        std::memcpy(small, first, length);
+        small[length] = '\0';
+    }
+    char* end = nullptr;
+    errno = 0;
+    d = std::strtod(copy, &end);
+    return errno != ERANGE && end == copy + length;
+#endif
+}
+
+template <typename T>
+bool parse_value(const char* first, const char* last, T& value) {
+    while (first < last && is_blank(*first)) ++first;
+    while (last > first && is_blank(last[-1])) --last;
+    // std::from_chars rejects an explicit '+' sign
+    if (last - first > 1 && first[0] == '+' && first[1] != '-') ++first;
+    if (first == last) return false;
+    if constexpr (std::is_integral<T>::value) {
+        auto res = std::from_chars(first, last, value);
+        return res.ec == std::errc() && res.ptr == last;
+    } else {
+        double d;
+        if (!parse_double(first, last, d)) return false;
+        value = static_cast<T>(d);
+        return true;
+    }
+}
+
+// Parses the lines starting in text[begin, end). Returns the offset of the first bad line, or kNoError.
+template <typename T>
+size_t parse_lines(const char* text, size_t begin, size_t end, const ParseOptions& options, std::vector<T>& out) {
+    size_t pos = begin;
+    while (pos < end) {
+        const char* line = text + pos;
+        const char* nl = static_cast<const char*>(std::memchr(line, '\n', end - pos));
+        const char* line_end = nl ? nl : text + end;
+        pos = static_cast<size_t>(line_end - text) + 1;
+        if (line_end > line && line_end[-1] == '\r') --line_end;
+        if (line_end == line) continue;
+
+        const char* field = line;
+        for (size_t c = 0; c < options.column && field; ++c) {
+            const char* next = static_cast<const char*>(std::memchr(field, options.delimiter, static_cast<size_t>(line_end - field)));
+            field = next ? next + 1 : nullptr;
+        }
+        T value;
+        if (!field) return static_cast<size_t>(line - text);
+        const char* field_end = static_cast<const char*>(std::memchr(field, options.delimiter, static_cast<size_t>(line_end - field)));
+        if (!parse_value(field, field_end ? field_end : line_end, value)) return static_cast<size_t>(line - text);
+        out.push_back(value);
+    }
+    return kNoError;
+}
+
+template <typename T>
+std::shared_ptr<std::vector<T>> parse_numbers(const char* text, size_t size, const ParseOptions& options) {
+    size_t first = 0;
+    if (options.header) {
+        const char* nl = static_cast<const char*>(std::memchr(text, '\n', size));
+        first = nl ? static_cast<size_t>(nl - text) + 1 : size;
+    }
+    // A line belongs to the chunk holding its first byte
+    size_t chunks = chunk_count(size - first, kParseMinChunk);
+    size_t chunk_size = (size - first + chunks - 1) / chunks;
+    std::vector<size_t> starts(chunks + 1, size);
+    starts[0] = first;
+    for (size_t c = 1; c < chunks; ++c) {
+        size_t pos = std::min(size, first + c * chunk_size);
+        const char* nl = pos < size ? static_cast<const char*>(std::memchr(text + pos - 1, '\n', size - pos + 1)) : nullptr;
+        starts[c] = nl ? static_cast<size_t>(nl - text) + 1 : size;
+    }
+
+    std::vector<std::vector<T>> parts(chunks);
+    std::vector<size_t> errors(chunks, kNoError);
+    auto out = std::make_shared<std::vector<T>>();
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+            errors[c] = parse_lines(text, starts[c], std::max(starts[c], starts[c + 1]), options, parts[c]);
+        });
+        size_t error = *std::min_element(errors.begin(), errors.end());
+        if (error != kNoError) {
+            size_t line = 1 + static_cast<size_t>(std::count(text, text + error, '\n'));
+            throw std::runtime_error("Missing or invalid number at line " + std::to_string(line));
+        }
+        concat_parts(policy, parts, *out);
+    }, size);
+    return out;
+}
+
+// Offsets in [begin, end) holding 'byte'
+void find_byte(const char* text, size_t begin, size_t end, char byte, std::vector<uint32_t>& out) {
+    const char* p = text + begin;
+    const char* last = text + end;
+    while (p < last) {
+        const char* hit = static_cast<const char*>(std::memchr(p, byte, static_cast<size_t>(last - p)));
+        if (!hit) break;
+        out.push_back(static_cast<uint32_t>(hit - text));
+        p = hit + 1;
+    }
+}
+
+// Matches of a pattern of at least two bytes starting in [begin, end); end + m - 1 <= size
+void find_pattern(const char* text, size_t begin, size_t end, const std::string& pattern, std::vector<uint32_t>& out) {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(text);
+    size_t m = pattern.size();
+    unsigned char first = static_cast<unsigned char>(pattern[0]);
+    unsigned char last = static_cast<unsigned char>(pattern[m - 1]);
+    auto matches = [&](size_t i) {
+        return std::memcmp(text + i + 1, pattern.data() + 1, m - 2) == 0;
+    };
+    size_t i = begin;
+    for (; i + kFilterBlock <= end; i += kFilterBlock) {
+        unsigned char hit[kFilterBlock];
+        for (size_t j = 0; j < kFilterBlock; ++j) {
+            hit[j] = static_cast<unsigned char>((s[i + j] == first) & (s[i + j + m - 1] == last));
+        }
+        uint64_t words[kFilterBlock / 8];
+        std::memcpy(words, hit, sizeof(words));
+        for (size_t w = 0; w < kFilterBlock / 8; ++w) {
+            if (words[w] == 0) continue;
+            for (size_t j = w * 8; j < w * 8 + 8; ++j) {
+                if (hit[j] && matches(i + j)) out.push_back(static_cast<uint32_t>(i + j));
+            }
+        }
+    }
+    for (; i < end; ++i) {
+        if (s[i] == first && s[i + m - 1] == last && matches(i)) out.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+// Runs find(begin, end, part) over parallel chunks of [0, candidates) and concatenates the parts
+template <typename F>
+std::shared_ptr<std::vector<uint32_t>> scan_chunks(size_t candidates, F&& find) {
+    auto out = std::make_shared<std::vector<uint32_t>>();
+    if (candidates == 0) return out;
+    size_t chunks = chunk_count(candidates, kScanMinChunk);
+    size_t chunk_size = (candidates + chunks - 1) / chunks;
+    std::vector<std::vector<uint32_t>> parts(chunks);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+            size_t begin = std::min(candidates, c * chunk_size);
+            size_t end = std::min(candidates, begin + chunk_size);
+            find(begin, end, parts[c]);
+        });
+        concat_parts(policy, parts, *out);
+    }, candidates);
+    return out;
+}
+
+} // namespace
+
+MappedFile::MappedFile(const std::string& path, bool copyOnWrite) : copyOnWrite_(copyOnWrite) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("Cannot stat " + path + ": " + std::strerror(err));
+    }
+    if (!S_ISREG(st.st_mode)) {
+        ::close(fd);
+        throw std::runtime_error("Cannot map " + path + ": not a regular file");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        int prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* p = ::mmap(nullptr, size_, prot, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            int err = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot map " + path + ": " + std::strerror(err));
+        }
+        // Read-only mappings are scanned whole (parsing), so start read-ahead early; copy-on-write
+        // mappings back data that is touched lazily
+        if (!copyOnWrite) ::madvise(p, size_, MADV_WILLNEED);
+        data_ = static_cast<char*>(p);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) ::munmap(data_, size_);
+}
+
+template <typename T>
+hpx::future<std::shared_ptr<std::vector<T>>> hpx_parse_numbers(const char* text, size_t size, ParseOptions options) {
+    return hpx::async([text, size, options]() { return parse_numbers<T>(text, size, options); });
+}
+
+template <typename T>
+hpx::future<std::shared_ptr<std::vector<T>>> hpx_parse_numbers_file(std::string path, ParseOptions options) {
+    return hpx::async([path, options]() {
+        MappedFile file(path);
+        return parse_numbers<T>(file.Data(), file.Size(), options);
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<uint32_t>>> hpx_index_lines(const char* text, size_t size) {
+    if (size > static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<uint32_t>>>(std::runtime_error("Buffer too large for 32-bit offsets"));
+    }
+    return hpx::async([text, size]() {
+        return scan_chunks(size, [&](size_t begin, size_t end, std::vector<uint32_t>& part) {
+            find_byte(text, begin, end, '\n', part);
+        });
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<uint32_t>>> hpx_search_bytes(const char* text, size_t size, std::string pattern) {
+    if (pattern.empty()) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<uint32_t>>>(std::runtime_error("Search pattern must not be empty"));
+    }
+    if (size > static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<uint32_t>>>(std::runtime_error("Buffer too large for 32-bit offsets"));
+    }
+    return hpx::async([text, size, pattern]() {
+        size_t candidates = size >= pattern.size() ? size - pattern.size() + 1 : 0;
+        return scan_chunks(candidates, [&](size_t begin, size_t end, std::vector<uint32_t>& part) {
+            if (pattern.size() == 1) find_byte(text, begin, end, pattern[0], part);
+            else find_pattern(text, begin, end, pattern, part);
+        });
+    });
+}
+
+template hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_parse_numbers<int32_t>(const char*, size_t, ParseOptions);
+template hpx::future<std::shared_ptr<std::vector<float>>> hpx_parse_numbers<float>(const char*, size_t, ParseOptions);
+template hpx::future<std::shared_ptr<std::vector<double>>> hpx_parse_numbers<double>(const char*, size_t, ParseOptions);
+template hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_parse_numbers_file<int32_t>(std::string, ParseOptions);
+template hpx::future<std::shared_ptr<std::vector<float>>> hpx_parse_numbers_file<float>(std::string, ParseOptions);
+template hpx::future<std::shared_ptr<std::vector<double>>> hpx_parse_numbers_file<double>(std::string, ParseOptions);
@@ -0,0 +1,102 @@
+#ifndef HPX_IO_HPP
+#define HPX_IO_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Memory mapping of a whole file (POSIX mmap), unmapped on destruction.
+ *
+ * Pages are read in lazily on first access. A copy-on-write mapping may be modified through
+ * MutableData(); changes stay private to the process and never reach the file.
+ */
+class MappedFile {
+public:
+    // Maps 'path'; throws std::runtime_error naming the path and the OS error
+    explicit MappedFile(const std::string& path, bool copyOnWrite = false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+    // Writable view of a copy-on-write mapping, nullptr for read-only ones
+    char* MutableData() { return copyOnWrite_ ? data_ : nullptr; }
+
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    bool copyOnWrite_ = false;
+};
+
+/**
+ * @brief Options of hpx_parse_numbers.
+ */
+struct ParseOptions {
+    char delimiter = ',';
+    size_t column = 0;      // zero-based field index
+    bool header = false;    // skip the first line
+};
+
+/**
+ * @brief Parses one numeric column of delimited text (CSV/TSV) into a vector.
+ *
+ * The text is cut into chunks at line boundaries; chunks are parsed in parallel with
+ * std::from_chars and their outputs concatenated through a prefix sum over chunk counts, so
+ * values keep the line order. '\r\n' line ends, surrounding blanks and empty lines are accepted;
+ * a missing column or an unparsable value fails the whole call with its line number.
+ *
+ * @param text Pointer to the text (read in place).
+ * @param size Number of bytes.
+ * @param options Delimiter, column and header handling.
+ * @return A future that, when ready, returns one value per non-empty line.
+ */
+template <typename T>
+hpx::future<std::shared_ptr<std::vector<T>>> hpx_parse_numbers(const char* text, size_t size, ParseOptions options);
+
+/**
+ * @brief Like hpx_parse_numbers, reading the text from a memory-mapped file.
+ *
+ * @param path Path of the file.
+ * @param options Delimiter, column and header handling.
+ * @return A future that, when ready, returns one value per non-empty line.
+ */
+template <typename T>
+hpx::future<std::shared_ptr<std::vector<T>>> hpx_parse_numbers_file(std::string path, ParseOptions options);
+
+/**
+ * @brief Finds the offset of every '\n' in a byte buffer.
+ *
+ * Chunks are scanned in parallel with memchr (vectorized by the C library) and their offsets
+ * concatenated in chunk order, so the result is ascending.
+ *
+ * @param text Pointer to the bytes (read in place).
+ * @param size Number of bytes (offsets must fit in uint32_t).
+ * @return A future that, when ready, returns the ascending newline offsets.
+ */
+hpx::future<std::shared_ptr<std::vector<uint32_t>>> hpx_index_lines(const char* text, size_t size);
+
+/**
+ * @brief Finds every occurrence of a byte pattern, overlapping ones included.
+ *
+ * Candidate start offsets are split into parallel chunks; a chunk reads up to pattern.size() - 1
+ * bytes past its end, so matches straddling chunk boundaries are found exactly once. Within a
+ * chunk, 64 candidates at a time are filtered on the pattern's first and last byte in a
+ * branch-free loop the compiler vectorizes, and only surviving candidates are compared in full.
+ * Single-byte patterns use memchr.
+ *
+ * @param text Pointer to the bytes (read in place).
+ * @param size Number of bytes (offsets must fit in uint32_t).
+ * @param pattern Non-empty byte pattern.
+ * @return A future that, when ready, returns the ascending match offsets.
+ */
+hpx::future<std::shared_ptr<std::vector<uint32_t>>> hpx_search_bytes(const char* text, size_t size, std::string pattern);
+
+#endif // HPX_IO_HPP
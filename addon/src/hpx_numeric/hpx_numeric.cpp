@@ -0,0 +1,395 @@
+#include "hpx_numeric.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Convolution
+// ---------------------------------------------------------------------------
+
+// Kernels up to this length are convolved directly; longer ones go through the FFT
+constexpr size_t kDirectMaxKernel = 64;
+
+// Outputs accumulated per direct-convolution tile (fits L1 for double)
+constexpr size_t kConvolveTile = 1024;
+
+// In-place iterative radix-2 FFT of a fixed power-of-two size
+class Fft {
+public:
+    explicit Fft(size_t size) : size_(size), reversed_(size), twiddles_(size / 2) {
+        size_t bits = 0;
+        while ((size_t(1) << bits) < size) ++bits;
+        for (size_t i = 0; i < size; ++i) {
+            size_t r = 0;
+            for (size_t b = 0; b < bits; ++b) r |= ((i >> b) & 1) << (bits - 1 - b);
+            reversed_[i] = r;
+        }
+        const double pi = std::acos(-1.0);
+        for (size_t i = 0; i < size / 2; ++i) {
+            twiddles_[i] = std::polar(1.0, -2.0 * pi * static_cast<double>(i) / static_cast<double>(size));
+        }
+    }
+
+    size_t Size() const { return size_; }
+
+    // Unscaled transform; the inverse must be divided by Size() by the caller
+    void Transform(std::complex<double>* data, bool inverse) const {
+        for (size_t i = 0; i < size_; ++i) {
+            if (i < reversed_[i]) std::swap(data[i], data[reversed_[i]]);
+        }
+        for (size_t len = 2; len <= size_; len <<= 1) {
+            size_t half = len / 2, step = size_ / len;
+            for (size_t i = 0; i < size_; i += len) {
+                for (size_t j = 0; j < half; ++j) {
+                    std::complex<double> w = inverse ? std::conj(twiddles_[j * step]) : twiddles_[j * step];
+                    std::complex<double> u = data[i + j];
+                    std::complex<double> v = data[i + j + half] * w;
+                    data[i + j] = u + v;
+                    data[i + j + half] = u - v;
+                }
+            }
+        }
+    }
+
+private:
+    size_t size_;
+    std::vector<size_t> reversed_;
+    std::vector<std::complex<double>> twiddles_;
+};
+
+// out[j] = full[t0 + j] for j < len, where full[t] = sum_k b[k] * a[t - k].
+// Looping over the kernel outside makes the inner loop a contiguous multiply-add.
+template <typename T>
+void convolve_direct_tile(const T* a, size_t na, const T* b, size_t nb, size_t t0, size_t len, T* out) {
+    T acc[kConvolveTile];
+    for (size_t j = 0; j < len; ++j) acc[j] = T(0);
+    for (size_t k = 0; k < nb; ++k) {
+        // t0 + j - k must fall into [0, na)
+        size_t jlo = k > t0 ? k - t0 : 0;
+        if (na + k <= t0) continue;
+        size_t jhi = std::min(len, na + k - t0);
+        if (jhi <= jlo) continue;
+        const T bk = b[k];
+        const T* src = a + (t0 + jlo - k);
+        T* dst = acc + jlo;
+        size_t count = jhi - jlo;
+        for (size_t i = 0; i < count; ++i) dst[i] += bk * src[i];
+    }
+    std::copy(acc, acc + len, out);
+}
+
+template <typename T>
+void convolve_direct(const T* a, size_t na, const T* b, size_t nb, size_t offset, size_t length, T* out) {
+    size_t tiles = (length + kConvolveTile - 1) / kConvolveTile;
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), tiles, [&](size_t tile) {
+            size_t j0 = tile * kConvolveTile;
+            size_t len = std::min(kConvolveTile, length - j0);
+            convolve_direct_tile(a, na, b, nb, offset + j0, len, out + j0);
+        });
+    }, length * nb);
+}
+
+// Overlap-save: output block [j0, j0 + B) only needs the input segment of L = B + nb - 1 values
+// ending at its last output; the first nb - 1 values of the circular convolution are discarded.
+template <typename T>
+void convolve_fft(const T* a, size_t na, const T* b, size_t nb, size_t offset, size_t length, T* out) {
+    size_t fft_size = 1;
+    while (fft_size < 4 * nb) fft_size <<= 1;
+    Fft fft(fft_size);
+    size_t block = fft_size - (nb - 1);
+    double scale = 1.0 / static_cast<double>(fft_size);
+
+    std::vector<std::complex<double>> spectrum(fft_size);
+    for (size_t k = 0; k < nb; ++k) spectrum[k] = static_cast<double>(b[k]);
+    fft.Transform(spectrum.data(), false);
+
+    size_t blocks = (length + block - 1) / block;
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), blocks, [&](size_t blk) {
+            std::vector<std::complex<double>> buffer(fft_size);
+            size_t j0 = blk * block;
+            size_t len = std::min(block, length - j0);
+            // Segment starts at full index t0 - (nb - 1); values outside the signal are zero
+            size_t t0 = offset + j0;
+            for (size_t i = 0; i < fft_size; ++i) {
+                size_t pos = t0 + i;
+                buffer[i] = (pos >= nb - 1 && pos - (nb - 1) < na) ? static_cast<double>(a[pos - (nb - 1)]) : 0.0;
+            }
+            fft.Transform(buffer.data(), false);
+            for (size_t i = 0; i < fft_size; ++i) buffer[i] *= spectrum[i];
+            fft.Transform(buffer.data(), true);
+            for (size_t j = 0; j < len; ++j) out[j0 + j] = static_cast<T>(buffer[nb - 1 + j].real() * scale);
+        });
+    }, length * nb);
+}
+
+// ---------------------------------------------------------------------------
+// Dense matrices
+// ---------------------------------------------------------------------------
+
+// Output tile (rows x columns) per task and depth of a k block. A k block of B
+// (kMatmulKC x kMatmulNC) stays in L2 while a tile's rows stream over it.
+constexpr size_t kMatmulMC = 64;
+constexpr size_t kMatmulNC = 128;
+constexpr size_t kMatmulKC = 128;
+
+// Rows of C updated together by the micro-kernel
+constexpr size_t kMatmulMR = 4;
+
+// Transposes smaller than this (in elements) are done without recursion
+constexpr size_t kTransposeLeaf = 32;
+
+// C[rows, j0:j0+nc] += A[rows, p0:p0+kc] * B[p0:p0+kc, j0:j0+nc] for 'mr' (<= kMatmulMR) rows
+// starting at row i. Every loaded row of B feeds all rows at once.
+template <typename T>
+void matmul_micro(const T* a, const T* b, T* c, size_t n, size_t k, size_t i, size_t mr, size_t j0, size_t nc, size_t p0, size_t kc) {
+    T acc[kMatmulMR][kMatmulNC];
+    for (size_t r = 0; r < mr; ++r) {
+        for (size_t j = 0; j < nc; ++j) acc[r][j] = c[(i + r) * n + j0 + j];
+    }
+    for (size_t p = p0; p < p0 + kc; ++p) {
+        const T* brow = b + p * n + j0;
+        if (mr == kMatmulMR) {
+            const T a0 = a[(i + 0) * k + p], a1 = a[(i + 1) * k + p];
+            const T a2 = a[(i + 2) * k + p], a3 = a[(i + 3) * k + p];
+            for (size_t j = 0; j < nc; ++j) {
+                const T bj = brow[j];
+                acc[0][j] += a0 * bj;
+                acc[1][j] += a1 * bj;
+                acc[2][j] += a2 * bj;
+                acc[3][j] += a3 * bj;
+            }
+        } else {
+            for (size_t r = 0; r < mr; ++r) {
+                const T ar = a[(i + r) * k + p];
+                for (size_t j = 0; j < nc; ++j) acc[r][j] += ar * brow[j];
+            }
+        }
+    }
+    for (size_t r = 0; r < mr; ++r) {
+        for (size_t j = 0; j < nc; ++j) c[(i + r) * n + j0 + j] = acc[r][j];
+    }
+}
+
+template <typename T>
+void transpose_recursive(const T* src, T* dst, size_t rows, size_t cols, size_t r0, size_t r1, size_t c0, size_t c1) {
+    size_t dr = r1 - r0, dc = c1 - c0;
+    if (dr <= kTransposeLeaf && dc <= kTransposeLeaf) {
+        for (size_t r = r0; r < r1; ++r) {
+            for (size_t c = c0; c < c1; ++c) dst[c * rows + r] = src[r * cols + c];
+        }
+    } else if (dr >= dc) {
+        size_t mid = r0 + dr / 2;
+        transpose_recursive(src, dst, rows, cols, r0, mid, c0, c1);
+        transpose_recursive(src, dst, rows, cols, mid, r1, c0, c1);
+    } else {
+        size_t mid = c0 + dc / 2;
+        transpose_recursive(src, dst, rows, cols, r0, r1, c0, mid);
+        transpose_recursive(src, dst, rows, cols, r0, r1, mid, c1);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sparse matrices
+// ---------------------------------------------------------------------------
+
+// Minimum rows + non-zeros per merge-path partition
+constexpr size_t kSpmvMinItems = 8192;
+
+bool offsets_valid(const uint32_t* offsets, size_t rows, size_t nnz) {
+    if (offsets[0] != 0 || offsets[rows] != nnz) return false;
+    std::atomic<bool> ok(true);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), rows, [&](size_t i) {
+            if (offsets[i] > offsets[i + 1]) ok.store(false, std::memory_order_relaxed);
+        });
+    }, rows);
+    return ok.load();
+}
+
+// Rows fully consumed at merge-path diagonal 'diag' (rows + non-zeros consumed so far).
+// Row ends are merged with the non-zero indices; a row end comes first when it is <= j.
+size_t merge_path_rows(const uint32_t* offsets, size_t rows, size_t nnz, size_t diag) {
+    size_t lo = diag > nnz ? diag - nnz : 0;
+    size_t hi = std::min(diag, rows);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (offsets[mid + 1] <= diag - mid - 1) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// y = A * x. Each partition writes the rows it completes and hands the partial sum of the row it
+// stops in to a fix-up pass. With Checked, column indices are validated against xSize.
+template <typename T, bool Checked>
+bool spmv_merge_path(const uint32_t* offsets, size_t rows, const uint32_t* columns, const T* values, size_t nnz,
+                     const T* x, size_t xSize, T* y) {
+    size_t total = rows + nnz;
+    size_t parts = chunk_count(total, kSpmvMinItems);
+    std::vector<size_t> carry_row(parts, rows);
+    std::vector<T> carry_value(parts, T(0));
+    std::atomic<bool> ok(true);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), parts, [&](size_t p) {
+            size_t d0 = total * p / parts, d1 = total * (p + 1) / parts;
+            size_t i = merge_path_rows(offsets, rows, nnz, d0), i1 = merge_path_rows(offsets, rows, nnz, d1);
+            size_t j = d0 - i, j1 = d1 - i1;
+            bool bad = false;
+            for (; i < i1; ++i) {
+                T sum = T(0);
+                for (size_t end = offsets[i + 1]; j < end; ++j) {
+                    uint32_t c = columns[j];
+                    if (Checked && c >= xSize) { bad = true; c = 0; }
+                    sum += values[j] * x[c];
+                }
+                y[i] = sum;
+            }
+            // Partial row at the end of the partition
+            T sum = T(0);
+            for (; j < j1; ++j) {
+                uint32_t c = columns[j];
+                if (Checked && c >= xSize) { bad = true; c = 0; }
+                sum += values[j] * x[c];
+            }
+            carry_row[p] = i1;
+            carry_value[p] = sum;
+            if (bad) ok.store(false, std::memory_order_relaxed);
+        });
+    }, total);
+    for (size_t p = 0; p < parts; ++p) {
+        if (carry_row[p] < rows) y[carry_row[p]] += carry_value[p];
+    }
+    return ok.load();
+}
+
+} // namespace
+
+size_t convolve_output_length(size_t n, size_t m, ConvolveMode mode) {
+    switch (mode) {
+        case ConvolveMode::Same: return n;
+        case ConvolveMode::Valid: return std::max(n, m) - std::min(n, m) + 1;
+        default: return n + m - 1;
+    }
+}
+
+template <typename T>
+hpx::future<void> hpx_convolve(const T* signal, size_t n, const T* kernel, size_t m, ConvolveMode mode, T* out) {
+    if (n == 0 || m == 0) {
+        return hpx::make_exceptional_future<void>(std::runtime_error("Signal and kernel must not be empty"));
+    }
+    return hpx::async([signal, n, kernel, m, mode, out]() {
+        // Convolution is commutative: the shorter operand plays the kernel
+        const T* a = n >= m ? signal : kernel;
+        const T* b = n >= m ? kernel : signal;
+        size_t na = std::max(n, m), nb = std::min(n, m);
+        size_t offset = mode == ConvolveMode::Same ? (m - 1) / 2 : mode == ConvolveMode::Valid ? nb - 1 : 0;
+        size_t length = convolve_output_length(n, m, mode);
+        if (nb <= kDirectMaxKernel) convolve_direct(a, na, b, nb, offset, length, out);
+        else convolve_fft(a, na, b, nb, offset, length, out);
+    });
+}
+
+template hpx::future<void> hpx_convolve<float>(const float*, size_t, const float*, size_t, ConvolveMode, float*);
+template hpx::future<void> hpx_convolve<double>(const double*, size_t, const double*, size_t, ConvolveMode, double*);
+
+template <typename T>
+hpx::future<void> hpx_matmul(const T* a, const T* b, T* c, size_t m, size_t n, size_t k) {
+    return hpx::async([a, b, c, m, n, k]() {
+        size_t row_tiles = (m + kMatmulMC - 1) / kMatmulMC;
+        size_t col_tiles = (n + kMatmulNC - 1) / kMatmulNC;
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), row_tiles * col_tiles, [&](size_t tile) {
+                size_t i0 = (tile / col_tiles) * kMatmulMC, i1 = std::min(m, i0 + kMatmulMC);
+                size_t j0 = (tile % col_tiles) * kMatmulNC, nc = std::min(kMatmulNC, n - j0);
+                for (size_t i = i0; i < i1; ++i) std::fill(c + i * n + j0, c + i * n + j0 + nc, T(0));
+                for (size_t p0 = 0; p0 < k; p0 += kMatmulKC) {
+                    size_t kc = std::min(kMatmulKC, k - p0);
+                    for (size_t i = i0; i < i1; i += kMatmulMR) {
+                        matmul_micro(a, b, c, n, k, i, std::min(kMatmulMR, i1 - i), j0, nc, p0, kc);
+                    }
+                }
+            });
+        }, m * n * std::max<size_t>(k, 1));
+    });
+}
+
+template <typename T>
+hpx::future<void> hpx_transpose(const T* src, T* dst, size_t rows, size_t cols) {
+    return hpx::async([src, dst, rows, cols]() {
+        // Bands of source rows map to disjoint column ranges of dst
+        size_t band = std::max<size_t>(kTransposeLeaf, (rows + chunk_count(rows * cols) - 1) / chunk_count(rows * cols));
+        size_t bands = (rows + band - 1) / band;
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), bands, [&](size_t bi) {
+                size_t r0 = bi * band, r1 = std::min(rows, r0 + band);
+                transpose_recursive(src, dst, rows, cols, r0, r1, size_t(0), cols);
+            });
+        }, rows * cols);
+    });
+}
+
+template hpx::future<void> hpx_matmul<float>(const float*, const float*, float*, size_t, size_t, size_t);
+template hpx::future<void> hpx_matmul<double>(const double*, const double*, double*, size_t, size_t, size_t);
+template hpx::future<void> hpx_transpose<float>(const float*, float*, size_t, size_t);
+template hpx::future<void> hpx_transpose<double>(const double*, double*, size_t, size_t);
+
+template <typename T>
+hpx::future<std::shared_ptr<const CsrMatrix<T>>> CsrMatrix<T>::Build(const uint32_t* offsets, size_t rows, const uint32_t* columns,
+                                                                     const T* values, size_t nnz, size_t cols) {
+    return hpx::async([offsets, rows, columns, values, nnz, cols]() {
+        if (!offsets_valid(offsets, rows, nnz)) throw std::runtime_error("Invalid CSR row offsets");
+        auto matrix = std::make_shared<CsrMatrix<T>>();
+        matrix->cols_ = cols;
+        matrix->offsets_.assign(offsets, offsets + rows + 1);
+        matrix->columns_.resize(nnz);
+        matrix->values_.resize(nnz);
+        std::atomic<bool> ok(true);
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), nnz, [&](size_t j) {
+                if (columns[j] >= cols) ok.store(false, std::memory_order_relaxed);
+                matrix->columns_[j] = columns[j];
+                matrix->values_[j] = values[j];
+            });
+        }, nnz);
+        if (!ok.load()) throw std::runtime_error("CSR column index out of range");
+        return std::shared_ptr<const CsrMatrix<T>>(std::move(matrix));
+    });
+}
+
+template <typename T>
+void CsrMatrix<T>::Multiply(const T* x, T* y) const {
+    spmv_merge_path<T, false>(offsets_.data(), Rows(), columns_.data(), values_.data(), NonZeros(), x, cols_, y);
+}
+
+template <typename T>
+hpx::future<void> hpx_spmv(const uint32_t* offsets, size_t rows, const uint32_t* columns, const T* values, size_t nnz,
+                           const T* x, size_t xSize, T* y) {
+    return hpx::async([offsets, rows, columns, values, nnz, x, xSize, y]() {
+        if (!offsets_valid(offsets, rows, nnz)) throw std::runtime_error("Invalid CSR row offsets");
+        if (!spmv_merge_path<T, true>(offsets, rows, columns, values, nnz, x, xSize, y)) {
+            throw std::runtime_error("CSR column index out of range");
+        }
+    });
+}
+
+template <typename T>
+hpx::future<void> hpx_csr_multiply(std::shared_ptr<const CsrMatrix<T>> matrix, const T* x, T* y) {
+    return hpx::async([matrix, x, y]() { matrix->Multiply(x, y); });
+}
+
+template class CsrMatrix<float>;
+template class CsrMatrix<double>;
+template hpx::future<void> hpx_spmv<float>(const uint32_t*, size_t, const uint32_t*, const float*, size_t, const float*, size_t, float*);
+template hpx::future<void> hpx_spmv<double>(const uint32_t*, size_t, const uint32_t*, const double*, size_t, const double*, size_t, double*);
+template hpx::future<void> hpx_csr_multiply<float>(std::shared_ptr<const CsrMatrix<float>>, const float*, float*);
+template hpx::future<void> hpx_csr_multiply<double>(std::shared_ptr<const CsrMatrix<double>>, const double*, double*);
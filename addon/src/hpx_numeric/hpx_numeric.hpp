@@ -0,0 +1,151 @@
+#ifndef HPX_NUMERIC_HPP
+#define HPX_NUMERIC_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Numeric kernels over Float32/Float64 data. The kernels are templates instantiated for
+ * float and double only; inputs are read in place and results are written into caller-provided
+ * buffers, so the JS layer can hand its typed arrays straight through.
+ */
+
+/**
+ * @brief Output range of a 1D convolution (same semantics as scipy.signal.convolve).
+ */
+enum class ConvolveMode {
+    Full,   // every overlap: n + m - 1 values
+    Same,   // centered, as long as the signal: n values
+    Valid   // complete overlaps only: max(n, m) - min(n, m) + 1 values
+};
+
+/**
+ * @brief Number of output values of a convolution of lengths n and m (both > 0) in 'mode'.
+ */
+size_t convolve_output_length(size_t n, size_t m, ConvolveMode mode);
+
+/**
+ * @brief Convolves 'signal' with 'kernel' into 'out'.
+ *
+ * Short kernels use a direct convolution over output tiles, with the loop order arranged so the
+ * inner loop is a contiguous multiply-add the compiler vectorizes. Long kernels use FFT-based
+ * block convolution (overlap-save): every output block is computed independently from its own
+ * input segment, so blocks run in parallel without combining overlapping tails.
+ *
+ * @param signal Pointer to the signal (read in place).
+ * @param n Number of signal values (> 0).
+ * @param kernel Pointer to the kernel (read in place).
+ * @param m Number of kernel values (> 0).
+ * @param mode Output range.
+ * @param out Destination of convolve_output_length(n, m, mode) values.
+ * @return A future that becomes ready when 'out' is filled.
+ */
+template <typename T>
+hpx::future<void> hpx_convolve(const T* signal, size_t n, const T* kernel, size_t m, ConvolveMode mode, T* out);
+
+/**
+ * @brief Dense matrix product C = A * B over row-major matrices.
+ *
+ * Output tiles are computed in parallel. Within a tile the k dimension is blocked so the
+ * touched part of B stays in cache, and a micro-kernel updates four rows of C per pass over a
+ * row of B (four independent accumulator rows the compiler vectorizes along the columns).
+ *
+ * @param a Pointer to A, m x k (read in place).
+ * @param b Pointer to B, k x n (read in place).
+ * @param c Destination C, m x n (overwritten).
+ * @param m Rows of A and C.
+ * @param n Columns of B and C.
+ * @param k Columns of A, rows of B.
+ * @return A future that becomes ready when C is filled.
+ */
+template <typename T>
+hpx::future<void> hpx_matmul(const T* a, const T* b, T* c, size_t m, size_t n, size_t k);
+
+/**
+ * @brief Transposes a row-major rows x cols matrix into a row-major cols x rows matrix.
+ *
+ * Bands of rows are transposed in parallel, each with a cache-oblivious recursion that halves
+ * the longer side until a block fits in cache.
+ *
+ * @param src Pointer to the source matrix (read in place).
+ * @param dst Destination matrix (must not overlap src).
+ * @param rows Rows of the source matrix.
+ * @param cols Columns of the source matrix.
+ * @return A future that becomes ready when dst is filled.
+ */
+template <typename T>
+hpx::future<void> hpx_transpose(const T* src, T* dst, size_t rows, size_t cols);
+
+/**
+ * @brief Sparse matrix in CSR form, validated once and kept natively for repeated products.
+ *
+ * Products are partitioned along the merge path of row ends and non-zeros: every task gets the
+ * same number of rows + non-zeros, so a few very long rows (power-law graphs) are split across
+ * tasks instead of stalling one of them.
+ */
+template <typename T>
+class CsrMatrix {
+public:
+    /**
+     * @brief Validates the CSR arrays and copies them into a new matrix.
+     *
+     * @param offsets rows + 1 row offsets (offsets[0] == 0, non-decreasing, offsets[rows] == nnz).
+     * @param rows Number of rows.
+     * @param columns nnz column indices, each < cols.
+     * @param values nnz values.
+     * @param nnz Number of non-zeros.
+     * @param cols Number of columns (length of the vectors it is multiplied with).
+     * @return A future that, when ready, returns the matrix; fails if the arrays are inconsistent.
+     */
+    static hpx::future<std::shared_ptr<const CsrMatrix<T>>> Build(const uint32_t* offsets, size_t rows, const uint32_t* columns,
+                                                                  const T* values, size_t nnz, size_t cols);
+
+    size_t Rows() const { return offsets_.size() - 1; }
+    size_t Cols() const { return cols_; }
+    size_t NonZeros() const { return values_.size(); }
+
+    // y = A * x with x of Cols() and y of Rows() elements (blocks the calling HPX thread)
+    void Multiply(const T* x, T* y) const;
+
+private:
+    std::vector<uint32_t> offsets_;
+    std::vector<uint32_t> columns_;
+    std::vector<T> values_;
+    size_t cols_ = 0;
+};
+
+/**
+ * @brief One-shot sparse matrix-vector product y = A * x over CSR arrays read in place.
+ *
+ * Column indices are bounds-checked against xSize during the product itself (no extra pass).
+ *
+ * @param offsets rows + 1 row offsets.
+ * @param rows Number of rows (length of y).
+ * @param columns nnz column indices.
+ * @param values nnz values.
+ * @param nnz Number of non-zeros.
+ * @param x Input vector.
+ * @param xSize Length of x.
+ * @param y Output vector (overwritten).
+ * @return A future that becomes ready when y is filled; fails on inconsistent CSR arrays.
+ */
+template <typename T>
+hpx::future<void> hpx_spmv(const uint32_t* offsets, size_t rows, const uint32_t* columns, const T* values, size_t nnz,
+                           const T* x, size_t xSize, T* y);
+
+/**
+ * @brief y = A * x with a resident CsrMatrix.
+ *
+ * @param matrix The matrix.
+ * @param x Input vector of matrix->Cols() elements.
+ * @param y Output vector of matrix->Rows() elements (overwritten).
+ * @return A future that becomes ready when y is filled.
+ */
+template <typename T>
+hpx::future<void> hpx_csr_multiply(std::shared_ptr<const CsrMatrix<T>> matrix, const T* x, T* y);
+
+#endif // HPX_NUMERIC_HPP
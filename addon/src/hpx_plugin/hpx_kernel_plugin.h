@@ -0,0 +1,54 @@
+#ifndef HPX_KERNEL_PLUGIN_H
+#define HPX_KERNEL_PLUGIN_H
+
+/*
+ * C ABI for kernel plugins loaded with loadKernelPlugin(path).
+ *
+ * A plugin is a shared library exporting HPX_KERNEL_PLUGIN_ENTRY, which returns a table of
+ * named kernels. Kernels run on HPX worker threads, concurrently and without the JavaScript
+ * thread, so they must be thread-safe and must not throw (C++ plugins: mark them noexcept).
+ * The library stays loaded until the process exits, so the table and the names it points to
+ * must stay valid.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HPX_KERNEL_PLUGIN_ABI_VERSION 1
+#define HPX_KERNEL_PLUGIN_ENTRY "hpx_kernel_plugin_init"
+
+typedef enum hpx_kernel_kind {
+    HPX_KERNEL_PREDICATE = 1,   /* countIf/copyIf: nonzero keeps the value */
+    HPX_KERNEL_KEY = 2,         /* sortComp/partialSortComp: sorts ascending by key */
+    HPX_KERNEL_COMPARATOR = 3,  /* sortComp/partialSortComp: nonzero if a orders before b */
+    HPX_KERNEL_MAP = 4          /* transform: maps each value */
+} hpx_kernel_kind;
+
+typedef struct hpx_kernel {
+    const char* name;
+    int32_t kind;               /* hpx_kernel_kind */
+    void* context;              /* passed back to the function as is */
+    /* The function matching 'kind' must be set; the others are ignored */
+    int32_t (*predicate)(int32_t value, void* context);
+    int32_t (*key)(int32_t value, void* context);
+    int32_t (*less)(int32_t a, int32_t b, void* context);
+    int32_t (*map)(int32_t value, void* context);
+} hpx_kernel;
+
+typedef struct hpx_kernel_plugin {
+    uint32_t abi_version;       /* HPX_KERNEL_PLUGIN_ABI_VERSION */
+    uint32_t kernel_count;
+    const hpx_kernel* kernels;
+} hpx_kernel_plugin;
+
+/* Signature of the exported entry point */
+typedef const hpx_kernel_plugin* (*hpx_kernel_plugin_init_fn)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HPX_KERNEL_PLUGIN_H */
@@ -0,0 +1,181 @@
+#include "hpx_plugin.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <dlfcn.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// Kernels by name, and by library handle so reloading a library is a no-op
+struct KernelRegistry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const NativeKernel>> byName;
+    std::map<void*, std::vector<std::shared_ptr<const NativeKernel>>> byLibrary;
+};
+
+KernelRegistry& registry() {
+    static KernelRegistry instance;
+    return instance;
+}
+
+bool has_function(const hpx_kernel& entry) {
+    switch (entry.kind) {
+        case HPX_KERNEL_PREDICATE: return entry.predicate != nullptr;
+        case HPX_KERNEL_KEY: return entry.key != nullptr;
+        case HPX_KERNEL_COMPARATOR: return entry.less != nullptr;
+        case HPX_KERNEL_MAP: return entry.map != nullptr;
+        default: return false;
+    }
+}
+
+// Reads and validates the plugin table; throws without registering anything
+std::vector<std::shared_ptr<const NativeKernel>> read_table(void* handle, const std::string& path) {
+    void* symbol = dlsym(handle, HPX_KERNEL_PLUGIN_ENTRY);
+    if (!symbol) throw std::runtime_error("Kernel plugin '" + path + "' does not export " HPX_KERNEL_PLUGIN_ENTRY);
+    auto init = reinterpret_cast<hpx_kernel_plugin_init_fn>(symbol);
+    const hpx_kernel_plugin* table = init();
+    if (!table) throw std::runtime_error("Kernel plugin '" + path + "' returned no kernel table");
+    if (table->abi_version != HPX_KERNEL_PLUGIN_ABI_VERSION) {
+        throw std::runtime_error("Kernel plugin '" + path + "' has ABI version " + std::to_string(table->abi_version) +
+                                 ", expected " + std::to_string(HPX_KERNEL_PLUGIN_ABI_VERSION));
+    }
+    if (table->kernel_count > 0 && !table->kernels) throw std::runtime_error("Kernel plugin '" + path + "' has no kernels array");
+
+    std::vector<std::shared_ptr<const NativeKernel>> kernels;
+    for (uint32_t i = 0; i < table->kernel_count; ++i) {
+        const hpx_kernel& entry = table->kernels[i];
+        if (!entry.name || !*entry.name) throw std::runtime_error("Kernel plugin '" + path + "' has an unnamed kernel");
+        if (!has_function(entry)) {
+            throw std::runtime_error("Kernel '" + std::string(entry.name) + "' in '" + path + "' has an unknown kind or no function");
+        }
+        auto kernel = std::make_shared<NativeKernel>();
+        kernel->name = entry.name;
+        kernel->kind = static_cast<hpx_kernel_kind>(entry.kind);
+        kernel->entry = entry;
+        kernel->library = path;
+        kernels.push_back(std::move(kernel));
+    }
+    return kernels;
+}
+
+void require_kind(const NativeKernel& kernel, hpx_kernel_kind kind) {
+    if (kernel.kind != kind) throw std::runtime_error("Kernel '" + kernel.name + "' has the wrong kind for this operation");
+}
+
+} // namespace
+
+std::vector<std::shared_ptr<const NativeKernel>> hpx_load_kernel_plugin(const std::string& path) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        const char* error = dlerror();
+        throw std::runtime_error("Failed to load kernel plugin: " + std::string(error ? error : path));
+    }
+    auto known = reg.byLibrary.find(handle);
+    if (known != reg.byLibrary.end()) {
+        dlclose(handle);    // drop the extra reference; the first one keeps it loaded
+        return known->second;
+    }
+
+    std::vector<std::shared_ptr<const NativeKernel>> kernels;
+    try {
+        kernels = read_table(handle, path);
+        for (size_t i = 0; i < kernels.size(); ++i) {
+            auto existing = reg.byName.find(kernels[i]->name);
+            bool duplicate = existing != reg.byName.end();
+            for (size_t j = 0; j < i && !duplicate; ++j) duplicate = kernels[j]->name == kernels[i]->name;
+            if (duplicate) {
+                throw std::runtime_error("Kernel '" + kernels[i]->name + "' is already registered" +
+                                         (existing != reg.byName.end() ? " by '" + existing->second->library + "'" : ""));
+            }
+        }
+    } catch (...) {
+        dlclose(handle);
+        throw;
+    }
+    for (const auto& kernel : kernels) reg.byName.emplace(kernel->name, kernel);
+    reg.byLibrary.emplace(handle, kernels);
+    return kernels;
+}
+
+std::shared_ptr<const NativeKernel> hpx_find_kernel(const std::string& name) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto it = reg.byName.find(name);
+    return it == reg.byName.end() ? nullptr : it->second;
+}
+
+hpx::future<int64_t> hpx_kernel_count_if(const int32_t* src, size_t size, std::shared_ptr<const NativeKernel> kernel) {
+    return hpx::async([src, size, kernel]() {
+        require_kind(*kernel, HPX_KERNEL_PREDICATE);
+        auto fn = kernel->entry.predicate;
+        void* context = kernel->entry.context;
+        return run_with_policy([&](auto policy) {
+            return (int64_t)hpx::count_if(policy, src, src + size, [fn, context](int32_t v) { return fn(v, context) != 0; });
+        }, size);
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_kernel_copy_if(const int32_t* src, size_t size, std::shared_ptr<const NativeKernel> kernel) {
+    return hpx::async([src, size, kernel]() {
+        require_kind(*kernel, HPX_KERNEL_PREDICATE);
+        auto fn = kernel->entry.predicate;
+        void* context = kernel->entry.context;
+        return run_with_policy([&](auto policy) {
+            auto out = std::make_shared<std::vector<int32_t>>(size);
+            auto end_it = hpx::copy_if(policy, src, src + size, out->begin(), [fn, context](int32_t v) { return fn(v, context) != 0; });
+            out->resize(std::distance(out->begin(), end_it));
+            return out;
+        }, size);
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_kernel_sort(const int32_t* src, size_t size, size_t middle, std::shared_ptr<const NativeKernel> kernel) {
+    if (middle > size) middle = size;
+    return hpx::async([src, size, middle, kernel]() {
+        if (kernel->kind != HPX_KERNEL_COMPARATOR && kernel->kind != HPX_KERNEL_KEY) {
+            throw std::runtime_error("Kernel '" + kernel->name + "' is neither a comparator nor a key kernel");
+        }
+        void* context = kernel->entry.context;
+        return run_with_policy([&](auto policy) {
+            auto out = std::make_shared<std::vector<int32_t>>(src, src + size);
+            if (kernel->kind == HPX_KERNEL_COMPARATOR) {
+                auto less = kernel->entry.less;
+                auto comp = [less, context](int32_t a, int32_t b) { return less(a, b, context) != 0; };
+                if (middle == size) hpx::sort(policy, out->begin(), out->end(), comp);
+                else hpx::partial_sort(policy, out->begin(), out->begin() + middle, out->end(), comp);
+                return out;
+            }
+            // Key kernels run once per element; (key, value) pairs are sorted by key
+            auto key = kernel->entry.key;
+            std::vector<std::pair<int32_t, int32_t>> keyed(size);
+            hpx::experimental::for_loop(policy, size_t(0), size, [&](size_t i) {
+                keyed[i] = { key(src[i], context), src[i] };
+            });
+            auto byKey = [](const std::pair<int32_t, int32_t>& a, const std::pair<int32_t, int32_t>& b) { return a.first < b.first; };
+            if (middle == size) hpx::sort(policy, keyed.begin(), keyed.end(), byKey);
+            else hpx::partial_sort(policy, keyed.begin(), keyed.begin() + middle, keyed.end(), byKey);
+            hpx::experimental::for_loop(policy, size_t(0), size, [&](size_t i) { (*out)[i] = keyed[i].second; });
+            return out;
+        }, size);
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_kernel_map(const int32_t* src, size_t size, std::shared_ptr<const NativeKernel> kernel) {
+    return hpx::async([src, size, kernel]() {
+        require_kind(*kernel, HPX_KERNEL_MAP);
+        auto fn = kernel->entry.map;
+        void* context = kernel->entry.context;
+        return run_with_policy([&](auto policy) {
+            auto out = std::make_shared<std::vector<int32_t>>(size);
+            hpx::transform(policy, src, src + size, out->begin(), [fn, context](int32_t v) { return fn(v, context); });
+            return out;
+        }, size);
+    });
+}
@@ -0,0 +1,73 @@
+#ifndef HPX_PLUGIN_HPP
+#define HPX_PLUGIN_HPP
+
+#include "hpx_kernel_plugin.h"
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <string>
+
+/**
+ * @brief A kernel registered from a plugin library (see hpx_kernel_plugin.h).
+ */
+struct NativeKernel {
+    std::string name;
+    hpx_kernel_kind kind;
+    hpx_kernel entry;       // copy of the plugin's table entry
+    std::string library;    // path the kernel was loaded from
+};
+
+/**
+ * @brief Loads a kernel plugin and registers its kernels by name.
+ *
+ * The library is opened with dlopen and stays loaded until the process exits. Loading the
+ * same library again returns its kernels without registering anything. Throws
+ * std::runtime_error if the library cannot be opened, has no valid entry point or table, or
+ * names a kernel already registered by another library; nothing is registered then.
+ *
+ * @param path Path of the shared library.
+ * @return The kernels of the library.
+ */
+std::vector<std::shared_ptr<const NativeKernel>> hpx_load_kernel_plugin(const std::string& path);
+
+/**
+ * @brief Looks up a registered kernel.
+ *
+ * @param name Kernel name.
+ * @return The kernel, or nullptr if no loaded plugin defines it.
+ */
+std::shared_ptr<const NativeKernel> hpx_find_kernel(const std::string& name);
+
+/**
+ * @brief Counts the elements a predicate kernel keeps (read in place).
+ */
+hpx::future<int64_t> hpx_kernel_count_if(const int32_t* src, size_t size, std::shared_ptr<const NativeKernel> kernel);
+
+/**
+ * @brief Copies the elements a predicate kernel keeps, in input order (read in place).
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_kernel_copy_if(const int32_t* src, size_t size, std::shared_ptr<const NativeKernel> kernel);
+
+/**
+ * @brief Sorts with a comparator kernel, or ascending by the values of a key kernel.
+ *
+ * Keys are computed once per element in parallel and sorted together with the values. With
+ * middle < size only the first 'middle' elements are guaranteed sorted (partial sort).
+ *
+ * @param src Pointer to the input array (read in place).
+ * @param size Number of elements.
+ * @param middle Number of elements to sort to the front; size for a full sort.
+ * @param kernel Comparator or key kernel.
+ * @return A future that, when ready, returns the sorted copy.
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_kernel_sort(const int32_t* src, size_t size, size_t middle, std::shared_ptr<const NativeKernel> kernel);
+
+/**
+ * @brief Applies a map kernel to every element (read in place).
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_kernel_map(const int32_t* src, size_t size, std::shared_ptr<const NativeKernel> kernel);
+
+#endif // HPX_PLUGIN_HPP
@@ -0,0 +1,42 @@
+/*
+ * Kernel plugin used by the addon tests: one kernel of every kind, built as the
+ * hpx_test_kernels target. The hpx_test_kernels_bad_abi target builds the same table with a
+ * wrong ABI version, which loadKernelPlugin must reject.
+ */
+
+#include "hpx_kernel_plugin.h"
+
+#ifndef HPX_TEST_KERNELS_ABI_VERSION
+#define HPX_TEST_KERNELS_ABI_VERSION HPX_KERNEL_PLUGIN_ABI_VERSION
+#endif
+
+static int32_t is_even(int32_t v, void* context) {
+    (void)context;
+    return (v & 1) == 0;
+}
+
+static int32_t abs_key(int32_t v, void* context) {
+    (void)context;
+    return v < 0 ? -v : v;
+}
+
+static int32_t descending(int32_t a, int32_t b, void* context) {
+    (void)context;
+    return a > b;
+}
+
+static int32_t add_offset(int32_t v, void* context) {
+    return v + *(const int32_t*)context;
+}
+
+static int32_t offset = 10;
+
+static const hpx_kernel kernels[] = {
+    { "testIsEven", HPX_KERNEL_PREDICATE, 0, is_even, 0, 0, 0 },
+    { "testByAbs", HPX_KERNEL_KEY, 0, 0, abs_key, 0, 0 },
+    { "testDescending", HPX_KERNEL_COMPARATOR, 0, 0, 0, descending, 0 },
+    { "testAddTen", HPX_KERNEL_MAP, &offset, 0, 0, 0, add_offset }
+};
+static const hpx_kernel_plugin plugin = { HPX_TEST_KERNELS_ABI_VERSION, 4, kernels };
+
+const hpx_kernel_plugin* hpx_kernel_plugin_init(void) { return &plugin; }
@@ -0,0 +1,79 @@
+#include "hpx_pool.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Workers update the status words with Atomics, so read them atomically as well
+int32_t load_status(const MaskJob& job, size_t word) {
+    return __atomic_load_n(job.status + word, __ATOMIC_ACQUIRE);
+}
+
+} // namespace
+
+void PredicatePoolState::Fail(const std::string& message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!broken_.load(std::memory_order_relaxed)) error_ = message;
+    broken_.store(true, std::memory_order_release);
+}
+
+std::string PredicatePoolState::Error() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+void hpx_wait_for_mask(const MaskJob& job) {
+    while (load_status(job, kMaskJobDoneChunks) < static_cast<int32_t>(job.chunks)) {
+        if (job.pool->Broken()) throw std::runtime_error(job.pool->Error());
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    if (load_status(job, kMaskJobFailed)) {
+        size_t length = std::min(job.errorCapacity, static_cast<size_t>(std::max(0, load_status(job, kMaskJobErrorLength))));
+        std::string message(reinterpret_cast<const char*>(job.errorText), length);
+        throw std::runtime_error(message.empty() ? "Predicate failed in a pool worker" : message);
+    }
+}
+
+hpx::future<int64_t> hpx_count_mask(const uint8_t* mask, size_t size) {
+    return hpx::async([mask, size]() {
+        return run_with_policy([&](auto policy) {
+            return (int64_t)hpx::count(policy, mask, mask + size, uint8_t(1));
+        }, size);
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_copy_masked(const int32_t* src, const uint8_t* mask, size_t size) {
+    return hpx::async([src, mask, size]() {
+        size_t chunks = chunk_count(size);
+        size_t chunk_size = (size + chunks - 1) / chunks;
+        std::vector<size_t> starts(chunks, 0);
+        auto out = std::make_shared<std::vector<int32_t>>();
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(size, c * chunk_size);
+                size_t end = std::min(size, begin + chunk_size);
+                for (size_t i = begin; i < end; ++i) starts[c] += mask[i] == 1;
+            });
+            size_t total = 0;
+            for (size_t& start : starts) {
+                size_t n = start;
+                start = total;
+                total += n;
+            }
+            out->resize(total);
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(size, c * chunk_size);
+                size_t end = std::min(size, begin + chunk_size);
+                int32_t* dst = out->data() + starts[c];
+                for (size_t i = begin; i < end; ++i) {
+                    if (mask[i] == 1) *dst++ = src[i];
+                }
+            });
+        }, size);
+        return out;
+    });
+}
@@ -0,0 +1,92 @@
+#ifndef HPX_POOL_HPP
+#define HPX_POOL_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Health of a predicate worker pool, updated from the JavaScript thread.
+ *
+ * A pool breaks when a worker fails or exits (including close()); jobs still waiting for
+ * chunks then fail with the recorded error instead of waiting forever.
+ */
+class PredicatePoolState {
+public:
+    // Records the first failure and marks the pool broken
+    void Fail(const std::string& message);
+
+    bool Broken() const { return broken_.load(std::memory_order_acquire); }
+    std::string Error() const;
+
+private:
+    std::atomic<bool> broken_{false};
+    mutable std::mutex mutex_;
+    std::string error_;
+};
+
+/**
+ * @brief Words of a job's shared status array (Int32Array over a SharedArrayBuffer).
+ *
+ * Workers claim chunks by incrementing NextChunk and count finished chunks in DoneChunks. The
+ * first predicate error sets Failed and stores its UTF-8 message (ErrorLength bytes).
+ */
+enum MaskJobStatus : size_t {
+    kMaskJobNextChunk = 0,
+    kMaskJobDoneChunks = 1,
+    kMaskJobFailed = 2,
+    kMaskJobErrorLength = 3,
+    kMaskJobStatusWords = 4
+};
+
+/**
+ * @brief A predicate mask being filled by the workers of a pool, all in shared memory.
+ */
+struct MaskJob {
+    const int32_t* status = nullptr;        // kMaskJobStatusWords words
+    const uint8_t* errorText = nullptr;
+    size_t errorCapacity = 0;
+    const uint8_t* mask = nullptr;          // one byte per element, 1 = selected
+    size_t chunks = 0;
+    std::shared_ptr<PredicatePoolState> pool;
+};
+
+/**
+ * @brief Blocks until every chunk of the job is evaluated.
+ *
+ * Polls the shared status words (the workers never call into native code). Throws
+ * std::runtime_error with the predicate's error, or the pool's if it broke before finishing.
+ *
+ * @param job Job to wait for.
+ */
+void hpx_wait_for_mask(const MaskJob& job);
+
+/**
+ * @brief Counts the entries of a predicate mask equal to 1.
+ *
+ * @param mask Pointer to the mask.
+ * @param size Number of entries.
+ * @return A future that, when ready, returns the count.
+ */
+hpx::future<int64_t> hpx_count_mask(const uint8_t* mask, size_t size);
+
+/**
+ * @brief Copies the elements whose mask entry is 1, in input order.
+ *
+ * Chunks count their selected elements, a prefix sum places them and the chunks copy in
+ * parallel.
+ *
+ * @param src Pointer to the input array.
+ * @param mask Pointer to the mask.
+ * @param size Number of elements.
+ * @return A future that, when ready, returns the selected elements.
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_copy_masked(const int32_t* src, const uint8_t* mask, size_t size);
+
+#endif // HPX_POOL_HPP
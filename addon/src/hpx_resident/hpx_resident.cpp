@@ -0,0 +1,154 @@
+#include "hpx_resident.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+// Scans are partitioned along zone map blocks, whether or not a zone map exists
+constexpr size_t kBlock = ZoneMap::kBlockSize;
+
+size_t block_count(size_t size) {
+    return (size + kBlock - 1) / kBlock;
+}
+
+} // namespace
+
+ResidentBuffer::ResidentBuffer(std::vector<int32_t> data, bool withZoneMap)
+    : owned_(std::move(data)), data_(owned_.data()), size_(owned_.size()) {
+    if (withZoneMap) {
+        zones_ = std::make_unique<ZoneMap>(ZoneMap::Build(data_, size_));
+    }
+}
+
+ResidentBuffer::ResidentBuffer(std::shared_ptr<void> storage, int32_t* data, size_t size, std::unique_ptr<ZoneMap> zones)
+    : storage_(std::move(storage)), data_(data), size_(size), zones_(std::move(zones)) {}
+
+size_t ResidentBuffer::Size() const {
+    return size_;
+}
+
+bool ResidentBuffer::HasZoneMap() const {
+    return zones_ != nullptr;
+}
+
+int64_t ResidentBuffer::Count(int32_t value) const {
+    std::shared_lock<hpx::shared_mutex> lock(mutex_);
+    const int32_t* data = data_;
+    size_t size = size_;
+    std::vector<int64_t> partial(block_count(size), 0);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), partial.size(), [&](size_t b) {
+            if (zones_ && !zones_->MayContain(b, value)) return;
+            size_t end = std::min(size, (b + 1) * kBlock);
+            int64_t n = 0;
+            for (size_t i = b * kBlock; i < end; ++i) n += (data[i] == value);
+            partial[b] = n;
+        });
+    }, size);
+    return std::accumulate(partial.begin(), partial.end(), int64_t(0));
+}
+
+int64_t ResidentBuffer::Find(int32_t value) const {
+    std::shared_lock<hpx::shared_mutex> lock(mutex_);
+    const int32_t* data = data_;
+    size_t size = size_;
+    std::atomic<size_t> best(size);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), block_count(size), [&](size_t b) {
+            size_t begin = b * kBlock;
+            if (begin >= best.load(std::memory_order_relaxed)) return;
+            if (zones_ && !zones_->MayContain(b, value)) return;
+            size_t end = std::min(size, begin + kBlock);
+            const int32_t* it = std::find(data + begin, data + end, value);
+            if (it == data + end) return;
+            size_t pos = static_cast<size_t>(it - data);
+            size_t cur = best.load(std::memory_order_relaxed);
+            while (pos < cur && !best.compare_exchange_weak(cur, pos, std::memory_order_relaxed)) {}
+        });
+    }, size);
+    size_t pos = best.load();
+    return pos == size ? static_cast<int64_t>(-1) : static_cast<int64_t>(pos);
+}
+
+int64_t ResidentBuffer::CountRange(int32_t lo, int32_t hi) const {
+    if (lo > hi) return 0;
+    std::shared_lock<hpx::shared_mutex> lock(mutex_);
+    const int32_t* data = data_;
+    size_t size = size_;
+    // One unsigned comparison per element: v in [lo, hi] <=> (v - lo) <= (hi - lo) modulo 2^32
+    uint32_t base = static_cast<uint32_t>(lo);
+    uint32_t width = static_cast<uint32_t>(hi) - base;
+    std::vector<int64_t> partial(block_count(size), 0);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(0), partial.size(), [&](size_t b) {
+            size_t begin = b * kBlock;
+            size_t end = std::min(size, begin + kBlock);
+            if (zones_ && !zones_->MayOverlap(b, lo, hi)) return;
+            if (zones_ && zones_->Within(b, lo, hi)) {
+                partial[b] = static_cast<int64_t>(end - begin);
+                return;
+            }
+            int64_t n = 0;
+            for (size_t i = begin; i < end; ++i) n += (static_cast<uint32_t>(data[i]) - base <= width);
+            partial[b] = n;
+        });
+    }, size);
+    return std::accumulate(partial.begin(), partial.end(), int64_t(0));
+}
+
+void ResidentBuffer::Write(size_t offset, const int32_t* src, size_t count) {
+    std::unique_lock<hpx::shared_mutex> lock(mutex_);
+    if (offset > size_ || count > size_ - offset) {
+        throw std::out_of_range("Write exceeds resident buffer bounds");
+    }
+    run_with_policy([&](auto policy) {
+        hpx::copy(policy, src, src + count, data_ + offset);
+    }, count);
+    if (zones_) zones_->Update(data_, size_, offset, count);
+}
+
+std::shared_ptr<std::vector<int32_t>> ResidentBuffer::Read(size_t offset, size_t count) const {
+    std::shared_lock<hpx::shared_mutex> lock(mutex_);
+    offset = std::min(offset, size_);
+    count = std::min(count, size_ - offset);
+    auto out = std::make_shared<std::vector<int32_t>>(count);
+    run_with_policy([&](auto policy) {
+        hpx::copy(policy, data_ + offset, data_ + offset + count, out->begin());
+    }, count);
+    return out;
+}
+
+hpx::future<std::shared_ptr<ResidentBuffer>> hpx_resident_create(const int32_t* src, size_t size, bool withZoneMap) {
+    return hpx::async([src, size, withZoneMap]() {
+        std::vector<int32_t> data(size);
+        run_with_policy([&](auto policy) {
+            hpx::copy(policy, src, src + size, data.begin());
+        }, size);
+        return std::make_shared<ResidentBuffer>(std::move(data), withZoneMap);
+    });
+}
+
+hpx::future<int64_t> hpx_resident_count(std::shared_ptr<const ResidentBuffer> buffer, int32_t value) {
+    return hpx::async([buffer, value]() { return buffer->Count(value); });
+}
+
+hpx::future<int64_t> hpx_resident_find(std::shared_ptr<const ResidentBuffer> buffer, int32_t value) {
+    return hpx::async([buffer, value]() { return buffer->Find(value); });
+}
+
+hpx::future<int64_t> hpx_resident_count_range(std::shared_ptr<const ResidentBuffer> buffer, int32_t lo, int32_t hi) {
+    return hpx::async([buffer, lo, hi]() { return buffer->CountRange(lo, hi); });
+}
+
+hpx::future<void> hpx_resident_write(std::shared_ptr<ResidentBuffer> buffer, size_t offset, const int32_t* src, size_t count) {
+    return hpx::async([buffer, offset, src, count]() { buffer->Write(offset, src, count); });
+}
+
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_resident_read(std::shared_ptr<const ResidentBuffer> buffer, size_t offset, size_t count) {
+    return hpx::async([buffer, offset, count]() { return buffer->Read(offset, count); });
+}
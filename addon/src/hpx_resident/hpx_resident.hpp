@@ -0,0 +1,110 @@
+#ifndef HPX_RESIDENT_HPP
+#define HPX_RESIDENT_HPP
+
+#include "hpx_index.hpp"
+#include <hpx/hpx.hpp>
+#include <hpx/shared_mutex.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <shared_mutex>
+
+/**
+ * @brief Int32 data kept natively between calls, so repeated queries skip the JS -> C++ copy.
+ *
+ * Queries take a shared lock and writes take an exclusive lock, so concurrent Promises
+ * never observe a half-applied write. The lock is an hpx::shared_mutex: it is held across
+ * parallel loops, so it must survive the HPX thread migrating between OS threads, and a
+ * waiting writer suspends its HPX thread instead of blocking a worker the readers need.
+ * Locking methods must therefore be called on HPX threads. An optional ZoneMap lets scans
+ * skip whole blocks; it is kept up to date by every write.
+ */
+class ResidentBuffer {
+public:
+    ResidentBuffer(std::vector<int32_t> data, bool withZoneMap);
+
+    /**
+     * @brief Wraps externally owned, writable storage (e.g. a copy-on-write file mapping).
+     *
+     * @param storage Keeps 'data' alive for the lifetime of the buffer.
+     * @param data Pointer to the elements.
+     * @param size Number of elements.
+     * @param zones Zone map matching the data, or nullptr.
+     */
+    ResidentBuffer(std::shared_ptr<void> storage, int32_t* data, size_t size, std::unique_ptr<ZoneMap> zones);
+
+    // Fixed at construction, so readable without the lock from any thread
+    size_t Size() const;
+    bool HasZoneMap() const;
+
+    // Scans below run in parallel and block the calling HPX thread
+    int64_t Count(int32_t value) const;
+    int64_t Find(int32_t value) const;
+    int64_t CountRange(int32_t lo, int32_t hi) const;
+
+    // Overwrites [offset, offset + count); throws std::out_of_range past the end
+    void Write(size_t offset, const int32_t* src, size_t count);
+
+    // Copies out [offset, offset + count), clamped to the buffer size
+    std::shared_ptr<std::vector<int32_t>> Read(size_t offset, size_t count) const;
+
+    // Calls f(data, size, zones) under the shared lock; zones is nullptr without a zone map
+    template <typename F>
+    void Inspect(F&& f) const {
+        std::shared_lock<hpx::shared_mutex> lock(mutex_);
+        f(static_cast<const int32_t*>(data_), size_, static_cast<const ZoneMap*>(zones_.get()));
+    }
+
+private:
+    mutable hpx::shared_mutex mutex_;
+    std::vector<int32_t> owned_;
+    std::shared_ptr<void> storage_;
+    int32_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::unique_ptr<ZoneMap> zones_;
+};
+
+/**
+ * @brief Copies an array into a new resident buffer.
+ *
+ * @param src Pointer to the input array of int32_t elements.
+ * @param size Number of elements in the input array.
+ * @param withZoneMap Whether to build and maintain a block min/max index.
+ * @return A future that, when ready, returns the resident buffer.
+ */
+hpx::future<std::shared_ptr<ResidentBuffer>> hpx_resident_create(const int32_t* src, size_t size, bool withZoneMap);
+
+/**
+ * @brief Counts occurrences of 'value', skipping blocks the zone map rules out.
+ */
+hpx::future<int64_t> hpx_resident_count(std::shared_ptr<const ResidentBuffer> buffer, int32_t value);
+
+/**
+ * @brief Finds the first index of 'value' (-1 if absent), skipping blocks the zone map rules out.
+ */
+hpx::future<int64_t> hpx_resident_find(std::shared_ptr<const ResidentBuffer> buffer, int32_t value);
+
+/**
+ * @brief Counts elements in [lo, hi]; blocks entirely inside the range are counted without a scan.
+ */
+hpx::future<int64_t> hpx_resident_count_range(std::shared_ptr<const ResidentBuffer> buffer, int32_t lo, int32_t hi);
+
+/**
+ * @brief Overwrites part of the buffer and updates its zone map.
+ *
+ * @param buffer The buffer to write to.
+ * @param offset First element to overwrite.
+ * @param src Pointer to the new values (read in place).
+ * @param count Number of values to write.
+ * @return A future that becomes ready once the write is visible to subsequent queries.
+ */
+hpx::future<void> hpx_resident_write(std::shared_ptr<ResidentBuffer> buffer, size_t offset, const int32_t* src, size_t count);
+
+/**
+ * @brief Copies a range of the buffer out.
+ */
+hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_resident_read(std::shared_ptr<const ResidentBuffer> buffer, size_t offset, size_t count);
+
+#endif // HPX_RESIDENT_HPP
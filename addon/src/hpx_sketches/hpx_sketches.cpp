@@ -0,0 +1,506 @@
+#include "hpx_sketches.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// murmur3 finalizer; the offset keeps key 0 from hashing to 0
+inline uint64_t hash_key(int32_t key) {
+    uint64_t x = static_cast<uint64_t>(static_cast<uint32_t>(key)) ^ 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// ---------------------------------------------------------------------------
+// Blocked Bloom filter
+// ---------------------------------------------------------------------------
+
+constexpr size_t kBloomBlockBits = 512;                  // one 64-byte cache line
+constexpr size_t kBloomBlockWords = kBloomBlockBits / 64;
+constexpr uint32_t kBloomVersion = 1;
+constexpr uint32_t kBloomMaxHashes = 16;
+constexpr size_t kBloomProbeBatch = 64;
+
+struct BloomHeader {
+    char magic[8];      // "HPXBLOOM"
+    uint32_t version;   // kBloomVersion
+    uint32_t hashes;    // bits set per key
+    uint64_t blocks;    // number of 64-byte blocks following the header
+    uint64_t keys;      // number of inserted keys (informational)
+};
+static_assert(sizeof(BloomHeader) == 32, "BloomHeader must be packed to 32 bytes");
+
+constexpr char kBloomMagic[8] = { 'H', 'P', 'X', 'B', 'L', 'O', 'O', 'M' };
+
+// Block selection uses the high half of the hash and bit positions are derived from the low
+// half, so both stay independent.
+inline size_t bloom_block(uint64_t h, uint64_t blocks) {
+    return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(h >> 32)) * blocks) >> 32);
+}
+
+inline void bloom_masks(uint64_t h, uint32_t hashes, uint64_t (&masks)[kBloomBlockWords]) {
+    // Each bit position takes 9 fresh bits of a multiplicative hash stream seeded by the low half
+    uint64_t x = static_cast<uint32_t>(h) | (uint64_t(1) << 32);
+    for (size_t w = 0; w < kBloomBlockWords; ++w) masks[w] = 0;
+    for (uint32_t i = 0; i < hashes; ++i) {
+        x *= 0x9E3779B97F4A7C15ULL;
+        uint32_t bit = static_cast<uint32_t>(x >> 55);
+        masks[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+}
+
+BloomHeader read_bloom_header(const uint8_t* filter, size_t filterSize) {
+    BloomHeader header;
+    if (filterSize < sizeof(BloomHeader)) throw std::runtime_error("Invalid Bloom filter: too short");
+    std::memcpy(&header, filter, sizeof(BloomHeader));
+    if (std::memcmp(header.magic, kBloomMagic, sizeof(kBloomMagic)) != 0) throw std::runtime_error("Invalid Bloom filter: bad magic");
+    if (header.version != kBloomVersion) throw std::runtime_error("Unsupported Bloom filter version");
+    if (header.hashes == 0 || header.hashes > kBloomMaxHashes || header.blocks == 0 ||
+        header.blocks > (filterSize - sizeof(BloomHeader)) / 64 ||
+        filterSize != sizeof(BloomHeader) + header.blocks * 64) {
+        throw std::runtime_error("Invalid Bloom filter: inconsistent header");
+    }
+    return header;
+}
+
+// ---------------------------------------------------------------------------
+// HyperLogLog
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t kHllVersion = 1;
+constexpr uint32_t kHllMinPrecision = 4;
+constexpr uint32_t kHllMaxPrecision = 18;
+
+struct HllHeader {
+    char magic[8];      // "HPXHLL\0\0"
+    uint32_t version;   // kHllVersion
+    uint32_t precision; // index bits; 2^precision one-byte registers follow
+};
+static_assert(sizeof(HllHeader) == 16, "HllHeader must be packed to 16 bytes");
+
+constexpr char kHllMagic[8] = { 'H', 'P', 'X', 'H', 'L', 'L', 0, 0 };
+
+inline void hll_add(uint8_t* registers, uint32_t precision, uint64_t h) {
+    size_t slot = static_cast<size_t>(h >> (64 - precision));
+    // Rank of the first set bit in the remaining bits; the sentinel caps it at 64 - p + 1
+    uint64_t rest = (h << precision) | (uint64_t(1) << (precision - 1));
+    uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    if (rank > registers[slot]) registers[slot] = rank;
+}
+
+double hll_estimate(const uint8_t* registers, uint32_t precision) {
+    size_t m = size_t(1) << precision;
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (size_t i = 0; i < m; ++i) {
+        sum += std::ldexp(1.0, -static_cast<int>(registers[i]));
+        zeros += (registers[i] == 0);
+    }
+    double alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / static_cast<double>(m));
+    double estimate = alpha * static_cast<double>(m) * static_cast<double>(m) / sum;
+    // Small range correction (linear counting); a 64-bit hash needs no large range correction
+    if (estimate <= 2.5 * static_cast<double>(m) && zeros > 0) {
+        estimate = static_cast<double>(m) * std::log(static_cast<double>(m) / static_cast<double>(zeros));
+    }
+    return estimate;
+}
+
+HllResult hll_serialize(uint32_t precision, const std::vector<uint8_t>& registers) {
+    HllHeader header;
+    std::memcpy(header.magic, kHllMagic, sizeof(kHllMagic));
+    header.version = kHllVersion;
+    header.precision = precision;
+    HllResult result;
+    result.estimate = hll_estimate(registers.data(), precision);
+    result.sketch = std::make_shared<std::vector<uint8_t>>(sizeof(HllHeader) + registers.size());
+    std::memcpy(result.sketch->data(), &header, sizeof(HllHeader));
+    std::memcpy(result.sketch->data() + sizeof(HllHeader), registers.data(), registers.size());
+    return result;
+}
+
+HllHeader read_hll_header(const uint8_t* sketch, size_t sketchSize) {
+    HllHeader header;
+    if (sketchSize < sizeof(HllHeader)) throw std::runtime_error("Invalid HyperLogLog sketch: too short");
+    std::memcpy(&header, sketch, sizeof(HllHeader));
+    if (std::memcmp(header.magic, kHllMagic, sizeof(kHllMagic)) != 0) throw std::runtime_error("Invalid HyperLogLog sketch: bad magic");
+    if (header.version != kHllVersion) throw std::runtime_error("Unsupported HyperLogLog sketch version");
+    if (header.precision < kHllMinPrecision || header.precision > kHllMaxPrecision ||
+        sketchSize != sizeof(HllHeader) + (size_t(1) << header.precision)) {
+        throw std::runtime_error("Invalid HyperLogLog sketch: inconsistent header");
+    }
+    return header;
+}
+
+// ---------------------------------------------------------------------------
+// KLL quantile sketch
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t kKllVersion = 1;
+constexpr uint32_t kKllMinK = 8;
+constexpr uint32_t kKllMaxK = 65535;
+
+struct KllHeader {
+    char magic[8];      // "HPXKLL\0\0"
+    uint32_t version;   // kKllVersion
+    uint32_t k;         // accuracy parameter (capacity of the top level)
+    uint64_t count;     // number of summarized values
+    int32_t min;        // exact minimum (undefined if count == 0)
+    int32_t max;        // exact maximum (undefined if count == 0)
+    uint32_t levels;    // number of levels; followed by one uint32 size per level, then the items
+    uint32_t reserved;
+};
+static_assert(sizeof(KllHeader) == 40, "KllHeader must be packed to 40 bytes");
+
+constexpr char kKllMagic[8] = { 'H', 'P', 'X', 'K', 'L', 'L', 0, 0 };
+
+// A stack of compactors: items on level h stand for 2^h original values. A full level is
+// sorted and every other item (random offset) is promoted, halving it with a rank error of at
+// most one item weight. Lower levels get geometrically smaller capacities (factor 2/3).
+class KllSketch {
+public:
+    KllSketch(uint32_t k, uint64_t seed) : k_(k), rng_(seed | 1), levels_(1) {}
+
+    void Add(int32_t value) {
+        if (count_ == 0) min_ = max_ = value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        ++count_;
+        levels_[0].push_back(value);
+        if (levels_[0].size() >= Capacity(0)) Compress();
+    }
+
+    void Merge(const KllSketch& other) {
+        if (other.count_ == 0) return;
+        if (count_ == 0) { min_ = other.min_; max_ = other.max_; }
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        count_ += other.count_;
+        if (levels_.size() < other.levels_.size()) levels_.resize(other.levels_.size());
+        for (size_t h = 0; h < other.levels_.size(); ++h) {
+            levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+        }
+        Compress();
+    }
+
+    // Value whose weighted rank first reaches q * count
+    double Quantile(double q, const std::vector<std::pair<int32_t, uint64_t>>& cumulative) const {
+        if (q <= 0.0) return min_;
+        if (q >= 1.0) return max_;
+        double target = q * static_cast<double>(count_);
+        auto it = std::lower_bound(cumulative.begin(), cumulative.end(), target,
+            [](const std::pair<int32_t, uint64_t>& item, double t) { return static_cast<double>(item.second) < t; });
+        return it == cumulative.end() ? max_ : it->first;
+    }
+
+    // All retained items sorted by value, paired with their cumulative weight
+    std::vector<std::pair<int32_t, uint64_t>> Cumulative() const {
+        std::vector<std::pair<int32_t, uint64_t>> items;
+        for (size_t h = 0; h < levels_.size(); ++h) {
+            for (int32_t v : levels_[h]) items.emplace_back(v, uint64_t(1) << h);
+        }
+        std::sort(items.begin(), items.end());
+        uint64_t total = 0;
+        for (auto& item : items) item.second = (total += item.second);
+        return items;
+    }
+
+    uint64_t Count() const { return count_; }
+
+    std::shared_ptr<std::vector<uint8_t>> Serialize() const {
+        KllHeader header;
+        std::memcpy(header.magic, kKllMagic, sizeof(kKllMagic));
+        header.version = kKllVersion;
+        header.k = k_;
+        header.count = count_;
+        header.min = min_;
+        header.max = max_;
+        header.levels = static_cast<uint32_t>(levels_.size());
+        header.reserved = 0;
+        size_t items = 0;
+        for (const auto& level : levels_) items += level.size();
+        auto out = std::make_shared<std::vector<uint8_t>>(sizeof(KllHeader) + levels_.size() * sizeof(uint32_t) + items * sizeof(int32_t));
+        uint8_t* p = out->data();
+        std::memcpy(p, &header, sizeof(KllHeader));
+        p += sizeof(KllHeader);
+        for (const auto& level : levels_) {
+            uint32_t n = static_cast<uint32_t>(level.size());
+            std::memcpy(p, &n, sizeof(n));
+            p += sizeof(n);
+        }
+        for (const auto& level : levels_) {
+            if (level.empty()) continue;
+            std::memcpy(p, level.data(), level.size() * sizeof(int32_t));
+            p += level.size() * sizeof(int32_t);
+        }
+        return out;
+    }
+
+    static KllSketch Deserialize(const uint8_t* data, size_t size) {
+        KllHeader header;
+        if (size < sizeof(KllHeader)) throw std::runtime_error("Invalid quantile sketch: too short");
+        std::memcpy(&header, data, sizeof(KllHeader));
+        if (std::memcmp(header.magic, kKllMagic, sizeof(kKllMagic)) != 0) throw std::runtime_error("Invalid quantile sketch: bad magic");
+        if (header.version != kKllVersion) throw std::runtime_error("Unsupported quantile sketch version");
+        if (header.k < kKllMinK || header.k > kKllMaxK || header.levels == 0 || header.levels > 64 ||
+            size < sizeof(KllHeader) + header.levels * sizeof(uint32_t)) {
+            throw std::runtime_error("Invalid quantile sketch: inconsistent header");
+        }
+        KllSketch sketch(header.k, header.count ^ 0x9E3779B97F4A7C15ULL);
+        sketch.count_ = header.count;
+        sketch.min_ = header.min;
+        sketch.max_ = header.max;
+        sketch.levels_.resize(header.levels);
+        const uint8_t* sizes = data + sizeof(KllHeader);
+        const uint8_t* items = sizes + header.levels * sizeof(uint32_t);
+        size_t remaining = size - (items - data);
+        uint64_t weight = 0;
+        for (uint32_t h = 0; h < header.levels; ++h) {
+            uint32_t n;
+            std::memcpy(&n, sizes + h * sizeof(uint32_t), sizeof(n));
+            if (static_cast<size_t>(n) * sizeof(int32_t) > remaining) throw std::runtime_error("Invalid quantile sketch: truncated");
+            sketch.levels_[h].resize(n);
+            if (n > 0) std::memcpy(sketch.levels_[h].data(), items, n * sizeof(int32_t));
+            items += n * sizeof(int32_t);
+            remaining -= n * sizeof(int32_t);
+            weight += static_cast<uint64_t>(n) << h;
+        }
+        if (remaining != 0 || weight != header.count) throw std::runtime_error("Invalid quantile sketch: inconsistent header");
+        return sketch;
+    }
+
+    uint32_t K() const { return k_; }
+
+private:
+    size_t Capacity(size_t level) const {
+        size_t depth = levels_.size() - 1 - level;
+        return std::max<size_t>(2, static_cast<size_t>(std::ceil(k_ * std::pow(2.0 / 3.0, static_cast<double>(depth)))));
+    }
+
+    // Compacts every level that is over capacity, bottom up
+    void Compress() {
+        for (size_t h = 0; h < levels_.size(); ++h) {
+            if (levels_[h].size() < Capacity(h)) continue;
+            if (h + 1 == levels_.size()) levels_.emplace_back();
+            auto& level = levels_[h];
+            std::sort(level.begin(), level.end());
+            // An odd item out stays behind so the total weight is preserved exactly
+            bool odd = level.size() % 2 != 0;
+            int32_t leftover = odd ? level.back() : 0;
+            size_t even = level.size() - (odd ? 1 : 0);
+            rng_ ^= rng_ << 13; rng_ ^= rng_ >> 7; rng_ ^= rng_ << 17;
+            for (size_t i = rng_ & 1; i < even; i += 2) levels_[h + 1].push_back(level[i]);
+            level.clear();
+            if (odd) level.push_back(leftover);
+        }
+    }
+
+    uint32_t k_;
+    uint64_t rng_;
+    uint64_t count_ = 0;
+    int32_t min_ = 0;
+    int32_t max_ = 0;
+    std::vector<std::vector<int32_t>> levels_;
+};
+
+} // namespace
+
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_bloom_build(const int32_t* keys, size_t size, double fpRate) {
+    if (!(fpRate > 0.0 && fpRate < 1.0)) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<uint8_t>>>(std::runtime_error("fpRate must be in (0, 1)"));
+    }
+    return hpx::async([keys, size, fpRate]() {
+        const double ln2 = std::log(2.0);
+        double bitsPerKey = -std::log(fpRate) / (ln2 * ln2);
+        uint32_t hashes = static_cast<uint32_t>(std::lround(bitsPerKey * ln2));
+        hashes = std::min(kBloomMaxHashes, std::max(1u, hashes));
+        // Blocking spreads keys unevenly over cache lines, which raises the false positive
+        // rate above the classic formula, the more so the lower the target. Extra bits
+        // (10% at 1%, 15% at 0.1%, ...) bring it back to the target.
+        double surcharge = 1.0 + 0.05 * std::log10(1.0 / fpRate);
+        double bits = std::ceil(static_cast<double>(size) * bitsPerKey * surcharge);
+        uint64_t blocks = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(bits / kBloomBlockBits)));
+
+        std::vector<uint64_t> words(blocks * kBloomBlockWords, 0);
+        run_with_policy([&](auto policy) {
+            size_t chunks = chunk_count(size);
+            size_t chunk_size = (size + chunks - 1) / chunks;
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t end = std::min(size, (c + 1) * chunk_size);
+                for (size_t i = c * chunk_size; i < end; ++i) {
+                    uint64_t h = hash_key(keys[i]);
+                    uint64_t masks[kBloomBlockWords];
+                    bloom_masks(h, hashes, masks);
+                    uint64_t* block = words.data() + bloom_block(h, blocks) * kBloomBlockWords;
+                    for (size_t w = 0; w < kBloomBlockWords; ++w) {
+                        if (masks[w] != 0 && (__atomic_load_n(&block[w], __ATOMIC_RELAXED) & masks[w]) != masks[w]) {
+                            __atomic_fetch_or(&block[w], masks[w], __ATOMIC_RELAXED);
+                        }
+                    }
+                }
+            });
+        }, size);
+
+        BloomHeader header;
+        std::memcpy(header.magic, kBloomMagic, sizeof(kBloomMagic));
+        header.version = kBloomVersion;
+        header.hashes = hashes;
+        header.blocks = blocks;
+        header.keys = size;
+        auto out = std::make_shared<std::vector<uint8_t>>(sizeof(BloomHeader) + words.size() * sizeof(uint64_t));
+        std::memcpy(out->data(), &header, sizeof(BloomHeader));
+        std::memcpy(out->data() + sizeof(BloomHeader), words.data(), words.size() * sizeof(uint64_t));
+        return out;
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_bloom_query(const uint8_t* filter, size_t filterSize, const int32_t* probes, size_t size) {
+    BloomHeader header;
+    try {
+        header = read_bloom_header(filter, filterSize);
+    } catch (const std::exception& e) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<uint8_t>>>(std::runtime_error(e.what()));
+    }
+    return hpx::async([filter, header, probes, size]() {
+        const uint8_t* bits = filter + sizeof(BloomHeader);
+        auto out = std::make_shared<std::vector<uint8_t>>(size);
+        run_with_policy([&](auto policy) {
+            size_t batches = (size + kBloomProbeBatch - 1) / kBloomProbeBatch;
+            hpx::experimental::for_loop(policy, size_t(0), batches, [&](size_t b) {
+                size_t begin = b * kBloomProbeBatch;
+                size_t n = std::min(kBloomProbeBatch, size - begin);
+                // Hash the whole batch first: a straight loop of multiplies and shifts the
+                // compiler can vectorize, separated from the data-dependent block loads.
+                uint64_t hashes[kBloomProbeBatch];
+                for (size_t j = 0; j < n; ++j) hashes[j] = hash_key(probes[begin + j]);
+                for (size_t j = 0; j < n; ++j) {
+                    uint64_t masks[kBloomBlockWords];
+                    bloom_masks(hashes[j], header.hashes, masks);
+                    uint64_t block[kBloomBlockWords];
+                    std::memcpy(block, bits + bloom_block(hashes[j], header.blocks) * 64, sizeof(block));
+                    uint64_t missing = 0;
+                    for (size_t w = 0; w < kBloomBlockWords; ++w) missing |= masks[w] & ~block[w];
+                    (*out)[begin + j] = missing == 0 ? 1 : 0;
+                }
+            });
+        }, size);
+        return out;
+    });
+}
+
+hpx::future<HllResult> hpx_hll_build(const int32_t* src, size_t size, uint32_t precision) {
+    if (precision < kHllMinPrecision || precision > kHllMaxPrecision) {
+        return hpx::make_exceptional_future<HllResult>(std::runtime_error("precision must be in [4, 18]"));
+    }
+    return hpx::async([src, size, precision]() {
+        size_t m = size_t(1) << precision;
+        std::vector<uint8_t> registers(m, 0);
+        run_with_policy([&](auto policy) {
+            size_t chunks = chunk_count(size, std::max<size_t>(4096, m));
+            size_t chunk_size = (size + chunks - 1) / chunks;
+            std::vector<std::vector<uint8_t>> local(chunks);
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                local[c].assign(m, 0);
+                size_t end = std::min(size, (c + 1) * chunk_size);
+                for (size_t i = c * chunk_size; i < end; ++i) hll_add(local[c].data(), precision, hash_key(src[i]));
+            });
+            // Register-wise max, parallel over register ranges
+            size_t slices = chunk_count(m, 1024);
+            size_t slice_size = (m + slices - 1) / slices;
+            hpx::experimental::for_loop(policy, size_t(0), slices, [&](size_t sl) {
+                size_t end = std::min(m, (sl + 1) * slice_size);
+                for (const auto& regs : local) {
+                    for (size_t i = sl * slice_size; i < end; ++i) registers[i] = std::max(registers[i], regs[i]);
+                }
+            });
+        }, size);
+        return hll_serialize(precision, registers);
+    });
+}
+
+hpx::future<HllResult> hpx_hll_merge(std::vector<std::vector<uint8_t>> sketches) {
+    if (sketches.empty()) {
+        return hpx::make_exceptional_future<HllResult>(std::runtime_error("Expected at least one sketch to merge"));
+    }
+    uint32_t precision = 0;
+    try {
+        for (const auto& sketch : sketches) {
+            HllHeader header = read_hll_header(sketch.data(), sketch.size());
+            if (precision != 0 && header.precision != precision) throw std::runtime_error("Cannot merge HyperLogLog sketches of different precision");
+            precision = header.precision;
+        }
+    } catch (const std::exception& e) {
+        return hpx::make_exceptional_future<HllResult>(std::runtime_error(e.what()));
+    }
+    auto input = std::make_shared<std::vector<std::vector<uint8_t>>>(std::move(sketches));
+    return hpx::async([input, precision]() {
+        size_t m = size_t(1) << precision;
+        std::vector<uint8_t> registers(m, 0);
+        for (const auto& sketch : *input) {
+            const uint8_t* regs = sketch.data() + sizeof(HllHeader);
+            for (size_t i = 0; i < m; ++i) registers[i] = std::max(registers[i], regs[i]);
+        }
+        return hll_serialize(precision, registers);
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_kll_build(const int32_t* src, size_t size, uint32_t k) {
+    if (k < kKllMinK || k > kKllMaxK) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<uint8_t>>>(std::runtime_error("k must be in [8, 65535]"));
+    }
+    return hpx::async([src, size, k]() {
+        size_t chunks = chunk_count(size, std::max<size_t>(4096, size_t(k) * 16));
+        size_t chunk_size = (size + chunks - 1) / chunks;
+        std::vector<KllSketch> local;
+        local.reserve(chunks);
+        for (size_t c = 0; c < chunks; ++c) local.emplace_back(k, hash_key(static_cast<int32_t>(c)));
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t end = std::min(size, (c + 1) * chunk_size);
+                for (size_t i = c * chunk_size; i < end; ++i) local[c].Add(src[i]);
+            });
+        }, size);
+        // Chunk sketches are small (O(k log n) items), merging them is cheap
+        for (size_t c = 1; c < chunks; ++c) local[0].Merge(local[c]);
+        return local[0].Serialize();
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_kll_merge(std::vector<std::vector<uint8_t>> sketches) {
+    if (sketches.empty()) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<uint8_t>>>(std::runtime_error("Expected at least one sketch to merge"));
+    }
+    auto input = std::make_shared<std::vector<std::vector<uint8_t>>>(std::move(sketches));
+    return hpx::async([input]() {
+        KllSketch merged = KllSketch::Deserialize((*input)[0].data(), (*input)[0].size());
+        for (size_t i = 1; i < input->size(); ++i) {
+            KllSketch next = KllSketch::Deserialize((*input)[i].data(), (*input)[i].size());
+            if (next.K() != merged.K()) throw std::runtime_error("Cannot merge quantile sketches with different k");
+            merged.Merge(next);
+        }
+        return merged.Serialize();
+    });
+}
+
+hpx::future<std::shared_ptr<std::vector<double>>> hpx_kll_quantiles(const uint8_t* sketch, size_t sketchSize, std::vector<double> quantiles) {
+    for (double q : quantiles) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            return hpx::make_exceptional_future<std::shared_ptr<std::vector<double>>>(std::runtime_error("Quantiles must be in [0, 1]"));
+        }
+    }
+    return hpx::async([sketch, sketchSize, quantiles]() {
+        KllSketch kll = KllSketch::Deserialize(sketch, sketchSize);
+        if (kll.Count() == 0) throw std::runtime_error("Cannot compute quantiles of an empty sketch");
+        auto cumulative = kll.Cumulative();
+        auto out = std::make_shared<std::vector<double>>(quantiles.size());
+        for (size_t i = 0; i < quantiles.size(); ++i) (*out)[i] = kll.Quantile(quantiles[i], cumulative);
+        return out;
+    });
+}
@@ -0,0 +1,108 @@
+#ifndef HPX_SKETCHES_HPP
+#define HPX_SKETCHES_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+/**
+ * Probabilistic summaries of Int32 arrays. Every sketch is serialized into a flat, versioned
+ * byte layout (little-endian header followed by the payload), which is exactly what is handed to
+ * JavaScript as a Uint8Array. Sketches can therefore be stored or shipped between processes
+ * and passed back to the addon without any conversion step.
+ */
+
+/**
+ * @brief Builds a blocked Bloom filter over the given keys.
+ *
+ * Each key sets all of its bits inside a single 64-byte (cache line) block, so a query touches
+ * exactly one cache line. Keys are inserted in parallel with atomic bit updates.
+ *
+ * @param keys Pointer to the keys (read in place).
+ * @param size Number of keys.
+ * @param fpRate Target false positive rate, in (0, 1).
+ * @return A future that, when ready, returns the serialized filter.
+ */
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_bloom_build(const int32_t* keys, size_t size, double fpRate);
+
+/**
+ * @brief Tests many probes against a serialized Bloom filter.
+ *
+ * @param filter Pointer to the serialized filter (read in place).
+ * @param filterSize Size of the serialized filter in bytes.
+ * @param probes Pointer to the probe keys (read in place).
+ * @param size Number of probes.
+ * @return A future that, when ready, returns a mask with 1 for "possibly present" and 0 for
+ *         "definitely absent". Fails if the filter bytes are malformed.
+ */
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_bloom_query(const uint8_t* filter, size_t filterSize, const int32_t* probes, size_t size);
+
+/**
+ * @brief A HyperLogLog sketch together with its cardinality estimate.
+ */
+struct HllResult {
+    double estimate = 0.0;
+    std::shared_ptr<std::vector<uint8_t>> sketch;
+};
+
+/**
+ * @brief Estimates the number of distinct values with HyperLogLog in one parallel pass.
+ *
+ * Every chunk fills its own register array; the arrays are merged by register-wise max.
+ *
+ * @param src Pointer to the input array (read in place).
+ * @param size Number of elements.
+ * @param precision Number of index bits p in [4, 18]; 2^p one-byte registers,
+ *        relative standard error about 1.04 / sqrt(2^p).
+ * @return A future that, when ready, returns the estimate and the serialized sketch.
+ */
+hpx::future<HllResult> hpx_hll_build(const int32_t* src, size_t size, uint32_t precision);
+
+/**
+ * @brief Merges serialized HyperLogLog sketches of equal precision.
+ *
+ * The merged sketch is exactly the sketch of the union of the underlying data.
+ *
+ * @param sketches The serialized sketches to merge (at least one).
+ * @return A future that, when ready, returns the merged sketch and its estimate.
+ *         Fails if a sketch is malformed or the precisions differ.
+ */
+hpx::future<HllResult> hpx_hll_merge(std::vector<std::vector<uint8_t>> sketches);
+
+/**
+ * @brief Builds a KLL quantile sketch in one parallel pass.
+ *
+ * Every chunk feeds its own sketch; the chunk sketches are merged at the end. Quantiles read
+ * from the sketch have a rank error of roughly 1.7 / k (about 1% for the default k = 200)
+ * with high probability, independent of the input size.
+ *
+ * @param src Pointer to the input array (read in place).
+ * @param size Number of elements.
+ * @param k Accuracy parameter in [8, 65535]; the sketch keeps O(k log(size / k)) values.
+ * @return A future that, when ready, returns the serialized sketch.
+ */
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_kll_build(const int32_t* src, size_t size, uint32_t k);
+
+/**
+ * @brief Merges serialized KLL sketches built with the same k.
+ *
+ * @param sketches The serialized sketches to merge (at least one).
+ * @return A future that, when ready, returns the merged sketch, which summarizes the union of
+ *         the underlying data. Fails if a sketch is malformed or the k values differ.
+ */
+hpx::future<std::shared_ptr<std::vector<uint8_t>>> hpx_kll_merge(std::vector<std::vector<uint8_t>> sketches);
+
+/**
+ * @brief Reads approximate quantiles from a serialized KLL sketch.
+ *
+ * @param sketch Pointer to the serialized sketch (read in place).
+ * @param sketchSize Size of the serialized sketch in bytes.
+ * @param quantiles The quantiles to read, each in [0, 1]. 0 and 1 return the exact min/max.
+ * @return A future that, when ready, returns one value per requested quantile.
+ */
+hpx::future<std::shared_ptr<std::vector<double>>> hpx_kll_quantiles(const uint8_t* sketch, size_t sketchSize, std::vector<double> quantiles);
+
+#endif // HPX_SKETCHES_HPP
@@ -0,0 +1,412 @@
+#include "hpx_snapshot.hpp"
+#include "hpx_io.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = { 'H', 'P', 'X', 'S', 'N', 'A', 'P', '\0' };
+constexpr uint32_t kVersion = 1;
+
+// Column arrays start on cache-line boundaries
+constexpr uint64_t kColumnAlignment = 64;
+
+// Bytes hashed per checksum block
+constexpr size_t kChecksumBlock = size_t(1) << 20;
+
+enum class EntryKind : uint32_t { Resident = 1, Index = 2 };
+enum class ColumnRole : uint32_t { Data = 1, ZoneMin = 2, ZoneMax = 3, Keys = 4, Offsets = 5, Positions = 6 };
+enum class ColumnType : uint32_t { Int32 = 1, Uint32 = 2 };
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+    uint64_t tableOffset;
+    uint64_t tableSize;
+    uint64_t fileSize;
+    uint64_t tableChecksum;
+    uint64_t headerChecksum;   // over all preceding fields
+    uint64_t reserved;
+};
+static_assert(sizeof(FileHeader) == 64, "Snapshot header must be 64 bytes");
+
+// Followed by the name (padded to 8 bytes) and columnCount ColumnRecords
+struct EntryRecord {
+    uint32_t kind;
+    uint32_t nameLength;
+    uint32_t columnCount;
+    uint32_t reserved;
+};
+
+struct ColumnRecord {
+    uint32_t role;
+    uint32_t type;
+    uint64_t count;     // elements (4 bytes each)
+    uint64_t offset;    // from the start of the file
+    uint64_t checksum;
+};
+
+// Column to write: the source stays valid while the owning buffer's lock is held
+struct Column {
+    ColumnRole role;
+    ColumnType type;
+    const void* data;
+    uint64_t count;
+    uint64_t offset = 0;
+    uint64_t checksum = 0;
+};
+
+struct Entry {
+    EntryKind kind;
+    std::string name;
+    std::shared_ptr<ResidentBuffer> buffer;
+    std::shared_ptr<const ValueIndex> index;
+    std::vector<Column> columns;
+};
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+
+inline uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+// Four independent 64-bit lanes per 32 bytes (xxHash64-style rounds), folded with the length
+uint64_t hash_bytes(const unsigned char* p, size_t size, uint64_t seed) {
+    uint64_t acc[4] = { seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1 };
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int l = 0; l < 4; ++l) {
+            uint64_t v;
+            std::memcpy(&v, p + i + 8 * l, 8);
+            acc[l] = rotl(acc[l] + v * kPrime2, 31) * kPrime1;
+        }
+    }
+    uint64_t h = rotl(acc[0], 1) + rotl(acc[1], 7) + rotl(acc[2], 12) + rotl(acc[3], 18) + size;
+    for (; i < size; ++i) h = rotl(h ^ (p[i] * kPrime3), 11) * kPrime1;
+    return mix(h);
+}
+
+// Hashes 1 MiB blocks in parallel and combines them in order; optionally copies 'src' into 'p' first
+template <typename Policy>
+uint64_t checksum(Policy policy, unsigned char* p, const unsigned char* src, size_t size) {
+    size_t blocks = (size + kChecksumBlock - 1) / kChecksumBlock;
+    std::vector<uint64_t> hashes(blocks);
+    hpx::experimental::for_loop(policy, size_t(0), blocks, [&](size_t b) {
+        size_t begin = b * kChecksumBlock;
+        size_t length = std::min(kChecksumBlock, size - begin);
+        if (src) std::memcpy(p + begin, src + begin, length);
+        hashes[b] = hash_bytes(p + begin, length, b);
+    });
+    uint64_t h = mix(size ^ kPrime3);
+    for (uint64_t block : hashes) h = mix(h ^ block) * kPrime1;
+    return h;
+}
+
+uint64_t hash_header(const FileHeader& header) {
+    return hash_bytes(reinterpret_cast<const unsigned char*>(&header), offsetof(FileHeader, headerChecksum), 0);
+}
+
+inline uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint64_t table_size(const std::vector<Entry>& entries) {
+    uint64_t size = 0;
+    for (const Entry& e : entries) {
+        size += sizeof(EntryRecord) + align_up(e.name.size(), 8) + e.columns.size() * sizeof(ColumnRecord);
+    }
+    return size;
+}
+
+std::vector<Entry> collect_entries(const Snapshot& snapshot) {
+    std::vector<Entry> entries;
+    for (const auto& item : snapshot.buffers) {
+        if (!item.second) throw std::runtime_error("Snapshot buffer '" + item.first + "' is null");
+        Entry e{ EntryKind::Resident, item.first, item.second, nullptr, {} };
+        // Sizes are fixed for the lifetime of a buffer; the pointers are refreshed under the lock when writing
+        item.second->Inspect([&](const int32_t* data, size_t size, const ZoneMap* zones) {
+            e.columns.push_back({ ColumnRole::Data, ColumnType::Int32, data, size });
+            if (zones) {
+                e.columns.push_back({ ColumnRole::ZoneMin, ColumnType::Int32, zones->Min().data(), zones->BlockCount() });
+                e.columns.push_back({ ColumnRole::ZoneMax, ColumnType::Int32, zones->Max().data(), zones->BlockCount() });
+            }
+        });
+        entries.push_back(std::move(e));
+    }
+    for (const auto& item : snapshot.indexes) {
+        if (!item.second) throw std::runtime_error("Snapshot index '" + item.first + "' is null");
+        const ValueIndex& index = *item.second;
+        Entry e{ EntryKind::Index, item.first, nullptr, item.second, {} };
+        e.columns.push_back({ ColumnRole::Keys, ColumnType::Int32, index.Keys(), index.DistinctCount() });
+        e.columns.push_back({ ColumnRole::Offsets, ColumnType::Uint32, index.Offsets(), index.DistinctCount() + 1 });
+        e.columns.push_back({ ColumnRole::Positions, ColumnType::Uint32, index.Positions(), index.Size() });
+        entries.push_back(std::move(e));
+    }
+    if (entries.size() > std::numeric_limits<uint32_t>::max()) throw std::runtime_error("Too many snapshot entries");
+    return entries;
+}
+
+template <typename Policy>
+void write_columns(Policy policy, unsigned char* base, Entry& e) {
+    auto copy = [&](Column& c) {
+        c.checksum = checksum(policy, base + c.offset, static_cast<const unsigned char*>(c.data), c.count * 4);
+    };
+    if (e.kind == EntryKind::Resident) {
+        // Inspect holds the buffer's hpx::shared_mutex, which may be kept across the parallel
+        // checksum: writes wait by suspending, and the copy sees all of a write or none of it
+        e.buffer->Inspect([&](const int32_t* data, size_t, const ZoneMap* zones) {
+            for (Column& c : e.columns) {
+                if (c.role == ColumnRole::Data) c.data = data;
+                else if (c.role == ColumnRole::ZoneMin) c.data = zones->Min().data();
+                else c.data = zones->Max().data();
+                copy(c);
+            }
+        });
+    } else {
+        for (Column& c : e.columns) copy(c);
+    }
+}
+
+void write_table(unsigned char* p, const std::vector<Entry>& entries) {
+    for (const Entry& e : entries) {
+        EntryRecord record{ static_cast<uint32_t>(e.kind), static_cast<uint32_t>(e.name.size()),
+                            static_cast<uint32_t>(e.columns.size()), 0 };
+        std::memcpy(p, &record, sizeof(record));
+        p += sizeof(record);
+        std::memcpy(p, e.name.data(), e.name.size());
+        p += align_up(e.name.size(), 8);
+        for (const Column& c : e.columns) {
+            ColumnRecord column{ static_cast<uint32_t>(c.role), static_cast<uint32_t>(c.type), c.count, c.offset, c.checksum };
+            std::memcpy(p, &column, sizeof(column));
+            p += sizeof(column);
+        }
+    }
+}
+
+void save_snapshot(const std::string& path, const Snapshot& snapshot) {
+    std::vector<Entry> entries = collect_entries(snapshot);
+    uint64_t tableOffset = sizeof(FileHeader);
+    uint64_t tableBytes = table_size(entries);
+    uint64_t fileSize = align_up(tableOffset + tableBytes, kColumnAlignment);
+    for (Entry& e : entries) {
+        if (e.name.size() > std::numeric_limits<uint32_t>::max()) throw std::runtime_error("Snapshot entry name too long");
+        for (Column& c : e.columns) {
+            c.offset = fileSize;
+            fileSize = align_up(fileSize + c.count * 4, kColumnAlignment);
+        }
+    }
+
+    std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) throw std::runtime_error("Cannot create " + tmp + ": " + std::strerror(errno));
+    void* mapped = MAP_FAILED;
+    try {
+        if (::ftruncate(fd, static_cast<off_t>(fileSize)) != 0) {
+            throw std::runtime_error("Cannot resize " + tmp + ": " + std::strerror(errno));
+        }
+        mapped = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) throw std::runtime_error("Cannot map " + tmp + ": " + std::strerror(errno));
+        unsigned char* base = static_cast<unsigned char*>(mapped);
+
+        run_with_policy([&](auto policy) {
+            for (Entry& e : entries) write_columns(policy, base, e);
+        }, fileSize);
+        write_table(base + tableOffset, entries);
+
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.tableOffset = tableOffset;
+        header.tableSize = tableBytes;
+        header.fileSize = fileSize;
+        header.tableChecksum = hash_bytes(base + tableOffset, tableBytes, 0);
+        header.headerChecksum = hash_header(header);
+        std::memcpy(base, &header, sizeof(header));
+
+        if (::msync(mapped, fileSize, MS_SYNC) != 0 || ::fsync(fd) != 0) {
+            throw std::runtime_error("Cannot sync " + tmp + ": " + std::strerror(errno));
+        }
+        ::munmap(mapped, fileSize);
+        mapped = MAP_FAILED;
+        if (::close(fd) != 0) {
+            fd = -1;
+            throw std::runtime_error("Cannot close " + tmp + ": " + std::strerror(errno));
+        }
+        fd = -1;
+        if (::rename(tmp.c_str(), path.c_str()) != 0) {
+            throw std::runtime_error("Cannot rename " + tmp + " to " + path + ": " + std::strerror(errno));
+        }
+    } catch (...) {
+        if (mapped != MAP_FAILED) ::munmap(mapped, fileSize);
+        if (fd >= 0) ::close(fd);
+        ::unlink(tmp.c_str());
+        throw;
+    }
+}
+
+// Bounds-checked reader over the entry table
+class TableReader {
+public:
+    TableReader(const unsigned char* p, uint64_t size) : p_(p), size_(size) {}
+
+    template <typename T>
+    T Read() {
+        T value;
+        std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    const unsigned char* Take(uint64_t bytes) {
+        if (bytes > size_ - pos_) throw std::runtime_error("Corrupt snapshot: entry table truncated");
+        const unsigned char* at = p_ + pos_;
+        pos_ += bytes;
+        return at;
+    }
+
+    bool Done() const { return pos_ == size_; }
+
+private:
+    const unsigned char* p_;
+    uint64_t size_;
+    uint64_t pos_ = 0;
+};
+
+const ColumnRecord* find_column(const std::vector<ColumnRecord>& columns, ColumnRole role, ColumnType type) {
+    const ColumnRecord* found = nullptr;
+    for (const ColumnRecord& c : columns) {
+        if (c.role != static_cast<uint32_t>(role)) continue;
+        if (found || c.type != static_cast<uint32_t>(type)) throw std::runtime_error("Corrupt snapshot: invalid column");
+        found = &c;
+    }
+    return found;
+}
+
+template <typename Policy>
+void validate_index(Policy policy, const std::string& name, const uint32_t* offsets, size_t distinct, size_t size) {
+    // Lookups slice 'positions' by these offsets, so they must be monotonic and in range
+    if (offsets[0] != 0 || offsets[distinct] != size) throw std::runtime_error("Corrupt snapshot: invalid index '" + name + "'");
+    std::atomic<bool> ok(true);
+    hpx::experimental::for_loop(policy, size_t(0), distinct, [&](size_t k) {
+        if (offsets[k] > offsets[k + 1]) ok.store(false, std::memory_order_relaxed);
+    });
+    if (!ok.load()) throw std::runtime_error("Corrupt snapshot: invalid index '" + name + "'");
+}
+
+Snapshot load_snapshot(const std::string& path, bool verify) {
+    auto file = std::make_shared<MappedFile>(path, true);
+    unsigned char* base = reinterpret_cast<unsigned char*>(file->MutableData());
+    uint64_t fileSize = file->Size();
+
+    FileHeader header;
+    if (fileSize < sizeof(header)) throw std::runtime_error("Not a snapshot file: " + path);
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) throw std::runtime_error("Not a snapshot file: " + path);
+    if (header.version != kVersion) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version));
+    }
+    if (header.headerChecksum != hash_header(header)) throw std::runtime_error("Corrupt snapshot: header checksum mismatch");
+    if (header.fileSize != fileSize) throw std::runtime_error("Corrupt snapshot: file size mismatch (truncated?)");
+    if (header.tableOffset > fileSize || header.tableSize > fileSize - header.tableOffset) {
+        throw std::runtime_error("Corrupt snapshot: entry table out of bounds");
+    }
+    if (header.tableChecksum != hash_bytes(base + header.tableOffset, header.tableSize, 0)) {
+        throw std::runtime_error("Corrupt snapshot: entry table checksum mismatch");
+    }
+
+    Snapshot snapshot;
+    TableReader table(base + header.tableOffset, header.tableSize);
+    run_with_policy([&](auto policy) {
+        for (uint32_t i = 0; i < header.entryCount; ++i) {
+            EntryRecord record = table.Read<EntryRecord>();
+            const unsigned char* name_bytes = table.Take(align_up(record.nameLength, 8));
+            std::string name(reinterpret_cast<const char*>(name_bytes), record.nameLength);
+            std::vector<ColumnRecord> columns;
+            for (uint32_t c = 0; c < record.columnCount; ++c) {
+                ColumnRecord column = table.Read<ColumnRecord>();
+                if (column.offset % kColumnAlignment != 0 || column.offset > fileSize ||
+                    column.count > (fileSize - column.offset) / 4) {
+                    throw std::runtime_error("Corrupt snapshot: column of '" + name + "' out of bounds");
+                }
+                if (verify && checksum(policy, base + column.offset, nullptr, column.count * 4) != column.checksum) {
+                    throw std::runtime_error("Corrupt snapshot: checksum mismatch in '" + name + "'");
+                }
+                columns.push_back(column);
+            }
+
+            if (record.kind == static_cast<uint32_t>(EntryKind::Resident)) {
+                const ColumnRecord* data = find_column(columns, ColumnRole::Data, ColumnType::Int32);
+                const ColumnRecord* min = find_column(columns, ColumnRole::ZoneMin, ColumnType::Int32);
+                const ColumnRecord* max = find_column(columns, ColumnRole::ZoneMax, ColumnType::Int32);
+                if (!data || !min != !max || columns.size() != (min ? 3u : 1u)) {
+                    throw std::runtime_error("Corrupt snapshot: invalid buffer '" + name + "'");
+                }
+                size_t size = static_cast<size_t>(data->count);
+                std::unique_ptr<ZoneMap> zones;
+                if (min) {
+                    size_t blocks = (size + ZoneMap::kBlockSize - 1) / ZoneMap::kBlockSize;
+                    if (min->count != blocks || max->count != blocks) {
+                        throw std::runtime_error("Corrupt snapshot: invalid zone map of '" + name + "'");
+                    }
+                    const int32_t* lo = reinterpret_cast<const int32_t*>(base + min->offset);
+                    const int32_t* hi = reinterpret_cast<const int32_t*>(base + max->offset);
+                    zones = std::make_unique<ZoneMap>(ZoneMap::FromBounds(std::vector<int32_t>(lo, lo + blocks),
+                                                                          std::vector<int32_t>(hi, hi + blocks)));
+                }
+                int32_t* values = reinterpret_cast<int32_t*>(base + data->offset);
+                snapshot.buffers.emplace_back(name, std::make_shared<ResidentBuffer>(file, values, size, std::move(zones)));
+            } else if (record.kind == static_cast<uint32_t>(EntryKind::Index)) {
+                const ColumnRecord* keys = find_column(columns, ColumnRole::Keys, ColumnType::Int32);
+                const ColumnRecord* offsets = find_column(columns, ColumnRole::Offsets, ColumnType::Uint32);
+                const ColumnRecord* positions = find_column(columns, ColumnRole::Positions, ColumnType::Uint32);
+                if (!keys || !offsets || !positions || columns.size() != 3 || offsets->count != keys->count + 1 ||
+                    positions->count > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+                    throw std::runtime_error("Corrupt snapshot: invalid index '" + name + "'");
+                }
+                const uint32_t* offset_data = reinterpret_cast<const uint32_t*>(base + offsets->offset);
+                size_t distinct = static_cast<size_t>(keys->count);
+                size_t size = static_cast<size_t>(positions->count);
+                validate_index(policy, name, offset_data, distinct, size);
+                snapshot.indexes.emplace_back(name, ValueIndex::FromArrays(
+                    file, reinterpret_cast<const int32_t*>(base + keys->offset), distinct, offset_data,
+                    reinterpret_cast<const uint32_t*>(base + positions->offset), size));
+            } else {
+                throw std::runtime_error("Corrupt snapshot: unknown entry kind " + std::to_string(record.kind));
+            }
+        }
+    }, verify ? fileSize : header.tableSize);
+    if (!table.Done()) throw std::runtime_error("Corrupt snapshot: trailing entry table bytes");
+    return snapshot;
+}
+
+} // namespace
+
+hpx::future<void> hpx_snapshot_save(std::string path, Snapshot snapshot) {
+    return hpx::async([path, snapshot]() { save_snapshot(path, snapshot); });
+}
+
+hpx::future<Snapshot> hpx_snapshot_load(std::string path, bool verify) {
+    return hpx::async([path, verify]() { return load_snapshot(path, verify); });
+}
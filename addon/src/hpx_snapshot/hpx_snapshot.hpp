@@ -0,0 +1,51 @@
+#ifndef HPX_SNAPSHOT_HPP
+#define HPX_SNAPSHOT_HPP
+
+#include "hpx_index.hpp"
+#include "hpx_resident.hpp"
+#include <hpx/hpx.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Named native objects stored in, or loaded from, one snapshot file.
+ */
+struct Snapshot {
+    std::vector<std::pair<std::string, std::shared_ptr<ResidentBuffer>>> buffers;
+    std::vector<std::pair<std::string, std::shared_ptr<const ValueIndex>>> indexes;
+};
+
+/**
+ * @brief Writes resident buffers (with their zone maps) and value indexes to a snapshot file.
+ *
+ * Layout: a 64-byte header, an entry table naming every object and its columns, then the raw
+ * column arrays in native byte order, each aligned to 64 bytes. Every column carries a
+ * checksum computed over 1 MiB blocks in parallel while it is copied. The file is written to
+ * 'path.tmp' through a shared mapping, synced and renamed over 'path', so readers never see a
+ * partial snapshot. Each buffer is copied under its read lock.
+ *
+ * @param path Destination file.
+ * @param snapshot Objects to store.
+ * @return A future that becomes ready once the file is in place.
+ */
+hpx::future<void> hpx_snapshot_save(std::string path, Snapshot snapshot);
+
+/**
+ * @brief Maps a snapshot file and rebuilds its objects on top of the mapping.
+ *
+ * The header, entry table, column bounds and index offsets are always validated. Column data
+ * is not copied: buffers and indexes point into a private copy-on-write mapping that stays
+ * alive as long as any of them does, so pages are read on first access and buffer writes
+ * never reach the file. Verifying the column checksums reads every page up front and is
+ * therefore optional.
+ *
+ * @param path Snapshot file.
+ * @param verify Check every column checksum before returning.
+ * @return A future that, when ready, returns the loaded objects.
+ */
+hpx::future<Snapshot> hpx_snapshot_load(std::string path, bool verify);
+
+#endif // HPX_SNAPSHOT_HPP
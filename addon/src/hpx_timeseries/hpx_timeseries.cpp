@@ -0,0 +1,292 @@
+#include "hpx_timeseries.hpp"
+#include "hpx_run_policy.hpp"
+#include <hpx/hpx.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Rolling extremum over in[0, length) for windows of 'window' elements (van Herk/Gil-Werman).
+// Writes length - window + 1 values; 'prefix' and 'suffix' are scratch buffers of 'length'.
+template <typename Pick>
+void rolling_extremum(const int32_t* in, size_t length, size_t window, int32_t* out,
+                      std::vector<int32_t>& prefix, std::vector<int32_t>& suffix, Pick pick) {
+    prefix.resize(length);
+    suffix.resize(length);
+    for (size_t j = 0; j < length; ++j) {
+        prefix[j] = (j % window == 0) ? in[j] : pick(prefix[j - 1], in[j]);
+    }
+    for (size_t j = length; j-- > 0;) {
+        suffix[j] = (j + 1 == length || (j + 1) % window == 0) ? in[j] : pick(suffix[j + 1], in[j]);
+    }
+    // A window starting at k spans at most two blocks: the tail of k's block and the head of the next
+    size_t outputs = length - window + 1;
+    for (size_t k = 0; k < outputs; ++k) out[k] = pick(suffix[k], prefix[k + window - 1]);
+}
+
+// LTTB buckets with at least this many points have their argmax split across workers
+constexpr size_t kLttbParallelBucket = 32768;
+
+double aggregate(const double* values, size_t count, ResampleAgg agg) {
+    switch (agg) {
+    case ResampleAgg::Count:
+        return static_cast<double>(count);
+    case ResampleAgg::Sum:
+    case ResampleAgg::Mean: {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) sum += values[i];
+        if (agg == ResampleAgg::Sum) return sum;
+        return count ? sum / static_cast<double>(count) : std::numeric_limits<double>::quiet_NaN();
+    }
+    default:
+        break;
+    }
+    if (count == 0) return std::numeric_limits<double>::quiet_NaN();
+    switch (agg) {
+    case ResampleAgg::Min: return *std::min_element(values, values + count);
+    case ResampleAgg::Max: return *std::max_element(values, values + count);
+    case ResampleAgg::First: return values[0];
+    default: return values[count - 1];
+    }
+}
+
+// First position in [begin, end) maximizing |p * y + q * x + r| (twice the LTTB triangle area)
+size_t lttb_argmax(const double* x, const double* y, size_t begin, size_t end, double p, double q, double r) {
+    size_t best = begin;
+    double best_area = -1.0;
+    for (size_t b = begin; b < end; ++b) {
+        double area = std::abs(p * y[b] + q * x[b] + r);
+        if (area > best_area) {
+            best_area = area;
+            best = b;
+        }
+    }
+    return best;
+}
+
+// Elements of the merged sequence per as-of join partition
+constexpr size_t kAsofMinItems = 8192;
+
+// True if values never decrease (a NaN anywhere counts as unsorted)
+bool ascending(const double* values, size_t size) {
+    if (size == 0) return true;
+    if (std::isnan(values[0])) return false;
+    std::atomic<bool> ok(true);
+    run_with_policy([&](auto policy) {
+        hpx::experimental::for_loop(policy, size_t(1), size, [&](size_t i) {
+            if (!(values[i - 1] <= values[i])) ok.store(false, std::memory_order_relaxed);
+        });
+    }, size);
+    return ok.load();
+}
+
+// Left elements among the first 'diag' merged elements. A right element is merged first when it
+// precedes the left one (right <= left, or right < left without exact matches).
+size_t asof_merge_path(const double* left, size_t leftSize, const double* right, size_t rightSize,
+                       bool allowExact, size_t diag) {
+    size_t lo = diag > rightSize ? diag - rightSize : 0;
+    size_t hi = std::min(diag, leftSize);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        double r = right[diag - mid - 1];
+        bool left_first = allowExact ? left[mid] < r : left[mid] <= r;
+        if (left_first) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+} // namespace
+
+hpx::future<RollingResult> hpx_rolling(const int32_t* src, size_t size, size_t window, RollingOps ops) {
+    if (window == 0 || window > size) {
+        return hpx::make_exceptional_future<RollingResult>(std::runtime_error("window must be in [1, length]"));
+    }
+    return hpx::async([src, size, window, ops]() {
+        size_t outputs = size - window + 1;
+        RollingResult result;
+        if (ops.sum) result.sum = std::make_shared<std::vector<double>>(outputs);
+        if (ops.mean) result.mean = std::make_shared<std::vector<double>>(outputs);
+        if (ops.min) result.min = std::make_shared<std::vector<int32_t>>(outputs);
+        if (ops.max) result.max = std::make_shared<std::vector<int32_t>>(outputs);
+
+        // Chunks of at least 4 windows keep the halo (window - 1 extra reads) a small overhead
+        size_t chunks = chunk_count(outputs, std::max<size_t>(4096, 4 * window));
+        size_t chunk_size = (outputs + chunks - 1) / chunks;
+        double inv_window = 1.0 / static_cast<double>(window);
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(outputs, c * chunk_size);
+                size_t end = std::min(outputs, begin + chunk_size);
+                if (begin == end) return;
+                const int32_t* in = src + begin;
+                size_t length = end - begin + window - 1;
+
+                if (ops.sum || ops.mean) {
+                    int64_t running = 0;
+                    for (size_t j = 0; j < window; ++j) running += in[j];
+                    for (size_t k = 0; k < end - begin; ++k) {
+                        if (k > 0) running += static_cast<int64_t>(in[k + window - 1]) - in[k - 1];
+                        double total = static_cast<double>(running);
+                        if (ops.sum) (*result.sum)[begin + k] = total;
+                        if (ops.mean) (*result.mean)[begin + k] = total * inv_window;
+                    }
+                }
+                std::vector<int32_t> prefix, suffix;
+                if (ops.min) {
+                    rolling_extremum(in, length, window, result.min->data() + begin, prefix, suffix,
+                                     [](int32_t a, int32_t b) { return std::min(a, b); });
+                }
+                if (ops.max) {
+                    rolling_extremum(in, length, window, result.max->data() + begin, prefix, suffix,
+                                     [](int32_t a, int32_t b) { return std::max(a, b); });
+                }
+            });
+        }, size);
+        return result;
+    });
+}
+
+hpx::future<void> hpx_resample(const double* timestamps, const double* values, size_t size, double start, double bucketMs,
+                               ResampleAgg agg, double* out, size_t buckets) {
+    if (!(bucketMs > 0.0) || !std::isfinite(start)) {
+        return hpx::make_exceptional_future<void>(std::runtime_error("bucketMs must be positive and start finite"));
+    }
+    return hpx::async([timestamps, values, size, start, bucketMs, agg, out, buckets]() {
+        if (!ascending(timestamps, size)) throw std::runtime_error("timestamps must be ascending");
+
+        // Chunks follow the points rather than the buckets, so bursts of points in a few buckets
+        // are still spread out. Chunk c owns the buckets from that of its first point up to that of
+        // the next chunk's first point; a single bucket is never split.
+        size_t chunks = chunk_count(size);
+        size_t chunk_size = (size + chunks - 1) / chunks;
+        auto first_bucket = [&](size_t c) -> size_t {
+            if (c == 0) return 0;
+            if (c * chunk_size >= size) return buckets;
+            double b = std::floor((timestamps[c * chunk_size] - start) / bucketMs);
+            if (!(b > 0.0)) return 0;
+            return b >= static_cast<double>(buckets) ? buckets : static_cast<size_t>(b);
+        };
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t first = first_bucket(c);
+                size_t last = first_bucket(c + 1);
+                double edge = start + static_cast<double>(first) * bucketMs;
+                size_t i = static_cast<size_t>(std::lower_bound(timestamps, timestamps + size, edge) - timestamps);
+                for (size_t b = first; b < last; ++b) {
+                    edge = start + static_cast<double>(b + 1) * bucketMs;
+                    size_t j = i;
+                    while (j < size && timestamps[j] < edge) ++j;
+                    out[b] = aggregate(values + i, j - i, agg);
+                    i = j;
+                }
+            });
+        }, size + buckets);
+    });
+}
+
+hpx::future<void> hpx_lttb(const double* x, const double* y, size_t size, size_t target, uint32_t* out) {
+    if (target > size || (target < 2 && target != size)) {
+        return hpx::make_exceptional_future<void>(std::runtime_error("target must be in [2, length]"));
+    }
+    if (size > std::numeric_limits<uint32_t>::max()) {
+        return hpx::make_exceptional_future<void>(std::runtime_error("Series too large for LTTB"));
+    }
+    return hpx::async([x, y, size, target, out]() {
+        if (target == size) {
+            run_with_policy([&](auto policy) {
+                hpx::experimental::for_loop(policy, size_t(0), size, [&](size_t i) { out[i] = static_cast<uint32_t>(i); });
+            }, size);
+            return;
+        }
+        out[0] = 0;
+        out[target - 1] = static_cast<uint32_t>(size - 1);
+        if (target == 2) return;
+
+        // Inner bucket i spans [begin(i), begin(i + 1)); integer bounds keep every bucket non-empty
+        size_t inner = target - 2;
+        auto bucket_begin = [&](size_t i) {
+            return i > inner ? size : 1 + static_cast<size_t>(static_cast<uint64_t>(i) * (size - 2) / inner);
+        };
+        std::vector<double> avg_x(inner), avg_y(inner);
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), inner, [&](size_t i) {
+                size_t begin = bucket_begin(i + 1);
+                size_t end = bucket_begin(i + 2);
+                double sx = 0.0, sy = 0.0;
+                for (size_t j = begin; j < end; ++j) {
+                    sx += x[j];
+                    sy += y[j];
+                }
+                avg_x[i] = sx / static_cast<double>(end - begin);
+                avg_y[i] = sy / static_cast<double>(end - begin);
+            });
+        }, size);
+
+        size_t a = 0;
+        for (size_t i = 0; i < inner; ++i) {
+            // 2 * area(a, b, c) = |(ax - cx) * (by - ay) - (ax - bx) * (cy - ay)| = |p * by + q * bx + r|
+            double ax = x[a], ay = y[a];
+            double p = ax - avg_x[i];
+            double q = avg_y[i] - ay;
+            double r = -p * ay - ax * q;
+            size_t begin = bucket_begin(i);
+            size_t end = bucket_begin(i + 1);
+            if (end - begin < kLttbParallelBucket) {
+                a = lttb_argmax(x, y, begin, end, p, q, r);
+            } else {
+                size_t parts = chunk_count(end - begin);
+                size_t part_size = (end - begin + parts - 1) / parts;
+                std::vector<size_t> best(parts);
+                run_with_policy([&](auto policy) {
+                    hpx::experimental::for_loop(policy, size_t(0), parts, [&](size_t k) {
+                        size_t lo = std::min(end, begin + k * part_size);
+                        size_t hi = std::min(end, lo + part_size);
+                        best[k] = lo < hi ? lttb_argmax(x, y, lo, hi, p, q, r) : begin;
+                    });
+                }, end - begin);
+                a = best[0];
+                double best_area = std::abs(p * y[a] + q * x[a] + r);
+                for (size_t k = 1; k < parts; ++k) {
+                    double area = std::abs(p * y[best[k]] + q * x[best[k]] + r);
+                    if (area > best_area) {
+                        best_area = area;
+                        a = best[k];
+                    }
+                }
+            }
+            out[i + 1] = static_cast<uint32_t>(a);
+        }
+    });
+}
+
+hpx::future<void> hpx_asof_join(const double* left, size_t leftSize, const double* right, size_t rightSize,
+                                double tolerance, bool allowExact, int32_t* out) {
+    if (rightSize > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        return hpx::make_exceptional_future<void>(std::runtime_error("Right series too large for Int32 indices"));
+    }
+    return hpx::async([left, leftSize, right, rightSize, tolerance, allowExact, out]() {
+        if (!ascending(left, leftSize) || !ascending(right, rightSize)) {
+            throw std::runtime_error("timestamps must be ascending");
+        }
+        size_t total = leftSize + rightSize;
+        size_t parts = chunk_count(total, kAsofMinItems);
+        size_t part_size = (total + parts - 1) / parts;
+        run_with_policy([&](auto policy) {
+            hpx::experimental::for_loop(policy, size_t(0), parts, [&](size_t p) {
+                size_t d0 = std::min(total, p * part_size);
+                size_t d1 = std::min(total, d0 + part_size);
+                size_t i = asof_merge_path(left, leftSize, right, rightSize, allowExact, d0);
+                size_t i_end = asof_merge_path(left, leftSize, right, rightSize, allowExact, d1);
+                size_t j = d0 - i;
+                for (; i < i_end; ++i) {
+                    while (j < rightSize && (allowExact ? right[j] <= left[i] : right[j] < left[i])) ++j;
+                    out[i] = (j > 0 && left[i] - right[j - 1] <= tolerance) ? static_cast<int32_t>(j - 1) : -1;
+                }
+            });
+        }, total);
+    });
+}
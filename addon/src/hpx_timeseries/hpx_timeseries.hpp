@@ -0,0 +1,115 @@
+#ifndef HPX_TIMESERIES_HPP
+#define HPX_TIMESERIES_HPP
+
+#include <hpx/hpx.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Selects the aggregates computed by hpx_rolling.
+ */
+struct RollingOps {
+    bool sum = false;
+    bool mean = false;
+    bool min = false;
+    bool max = false;
+};
+
+/**
+ * @brief Rolling aggregates; only the requested ones are set.
+ *
+ * Element i aggregates the window src[i, i + window), so every output holds
+ * size - window + 1 values.
+ */
+struct RollingResult {
+    std::shared_ptr<std::vector<double>> sum;
+    std::shared_ptr<std::vector<double>> mean;
+    std::shared_ptr<std::vector<int32_t>> min;
+    std::shared_ptr<std::vector<int32_t>> max;
+};
+
+/**
+ * @brief Computes rolling sum/mean/min/max over fixed-size windows in O(size), independent of
+ *        the window size.
+ *
+ * The outputs are split into chunks; each chunk reads its own input range plus a halo of
+ * window - 1 elements, so chunks run in parallel without coordination. Sums slide a 64-bit
+ * running total (prefix differences); min/max use the van Herk/Gil-Werman scheme (prefix and
+ * suffix extrema within window-sized blocks, two branch-free passes).
+ *
+ * @param src Pointer to the input array (read in place).
+ * @param size Number of elements in the input array.
+ * @param window Window length, in [1, size].
+ * @param ops The aggregates to compute.
+ * @return A future that, when ready, returns the requested rolling aggregates.
+ */
+hpx::future<RollingResult> hpx_rolling(const int32_t* src, size_t size, size_t window, RollingOps ops);
+
+/**
+ * @brief Aggregate computed per bucket by hpx_resample.
+ */
+enum class ResampleAgg { Mean, Sum, Min, Max, Count, First, Last };
+
+/**
+ * @brief Aggregates a time series into fixed-width time buckets.
+ *
+ * Bucket b covers [start + b * bucketMs, start + (b + 1) * bucketMs); points outside all buckets
+ * are ignored. The points are split into parallel chunks, widened to whole buckets; each chunk
+ * binary-searches its first point once and then walks the sorted timestamps. Empty buckets get 0
+ * for Sum/Count and NaN otherwise.
+ *
+ * @param timestamps Pointer to ascending timestamps (read in place; validated).
+ * @param values Pointer to one value per timestamp (read in place).
+ * @param size Number of points.
+ * @param start Start of the first bucket.
+ * @param bucketMs Bucket width (> 0).
+ * @param agg The aggregate to compute.
+ * @param out Pointer to 'buckets' output values.
+ * @param buckets Number of buckets.
+ * @return A future that becomes ready once 'out' is filled.
+ */
+hpx::future<void> hpx_resample(const double* timestamps, const double* values, size_t size, double start, double bucketMs,
+                               ResampleAgg agg, double* out, size_t buckets);
+
+/**
+ * @brief Largest-Triangle-Three-Buckets downsampling (Steinarsson), exact.
+ *
+ * Keeps the first and last point and one point per bucket in between: the one forming the
+ * largest triangle with the previously kept point and the average of the next bucket. The
+ * bucket averages are computed in parallel; the selection chain is inherently sequential, so
+ * only the per-bucket argmax of large buckets is split across workers. The triangle area is
+ * linear in the candidate point, which keeps the scan branch-free.
+ *
+ * @param x Pointer to ascending x coordinates (read in place).
+ * @param y Pointer to y coordinates (read in place).
+ * @param size Number of points.
+ * @param target Number of points to keep, in [2, size] (target == size keeps every point).
+ * @param out Pointer to 'target' output indices (ascending).
+ * @return A future that becomes ready once 'out' is filled.
+ */
+hpx::future<void> hpx_lttb(const double* x, const double* y, size_t size, size_t target, uint32_t* out);
+
+/**
+ * @brief As-of join: for every left timestamp, the last right timestamp at or before it.
+ *
+ * Both inputs are sorted, so the answer for left[i] is the number of right timestamps ordered
+ * before it in the merged sequence, minus one. The merged sequence is split into equal parts
+ * by binary-searching merge-path diagonals; each part walks its own slice of both arrays, so
+ * workers get the same amount of left + right elements however the timestamps interleave.
+ *
+ * @param left Pointer to ascending left timestamps (read in place; validated).
+ * @param leftSize Number of left timestamps.
+ * @param right Pointer to ascending right timestamps (read in place; validated).
+ * @param rightSize Number of right timestamps (must fit in int32_t).
+ * @param tolerance Largest accepted left - right distance; farther matches are dropped.
+ * @param allowExact If false, only right timestamps strictly before the left one match.
+ * @param out Pointer to leftSize matched right indices (-1 = no match).
+ * @return A future that becomes ready once 'out' is filled.
+ */
+hpx::future<void> hpx_asof_join(const double* left, size_t leftSize, const double* right, size_t rightSize,
+                                double tolerance, bool allowExact, int32_t* out);
+
+#endif // HPX_TIMESERIES_HPP
@@ -3,6 +3,7 @@
 
 #include "hpx_config.hpp"
 #include <hpx/hpx.hpp>
+#include <algorithm>
 #include <utility>
 #include <cstddef>
 
@@ -24,4 +25,13 @@ auto run_with_policy(F&& f, size_t size) {
     }
 }
 
+// Number of chunks for kernels that partition their input by hand instead of
+// delegating to a single HPX algorithm. A few chunks per worker keep the load
+// balanced, while min_chunk keeps per-chunk overhead negligible.
+inline size_t chunk_count(size_t size, size_t min_chunk = 4096) {
+    size_t workers = std::max<size_t>(1, hpx::get_num_worker_threads());
+    size_t by_size = (size + min_chunk - 1) / min_chunk;
+    return std::max<size_t>(1, std::min(workers * 4, by_size));
+}
+
 #endif // HPX_RUN_POLICY_HPP
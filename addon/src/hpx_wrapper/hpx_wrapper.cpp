@@ -7,6 +7,80 @@
 #include <memory>
 #include <stdexcept>
 #include <functional>
+#include <atomic>
+#include <limits>
+
+namespace {
+
+// Elements compared per block before testing whether the block differs. The XOR/OR
+// reduction over a block has no branches, so the compiler vectorizes it.
+constexpr size_t kCompareBlock = 64;
+
+// Chunks are scanned in stripes of this size; between stripes a chunk checks whether
+// an earlier difference already makes the rest of its work pointless.
+constexpr size_t kCompareStripe = 16384;
+
+bool block_differs(const int32_t* a, const int32_t* b, size_t begin) {
+    int32_t acc = 0;
+    for (size_t j = 0; j < kCompareBlock; ++j) acc |= a[begin + j] ^ b[begin + j];
+    return acc != 0;
+}
+
+// Returns the first index in [begin, end) where a and b differ, or end.
+size_t first_difference(const int32_t* a, const int32_t* b, size_t begin, size_t end) {
+    size_t i = begin;
+    while (i + kCompareBlock <= end && !block_differs(a, b, i)) i += kCompareBlock;
+    for (; i < end; ++i) {
+        if (a[i] != b[i]) return i;
+    }
+    return end;
+}
+
+size_t count_differences(const int32_t* a, const int32_t* b, size_t begin, size_t end) {
+    size_t n = 0;
+    for (size_t i = begin; i < end; ++i) n += (a[i] != b[i]);
+    return n;
+}
+
+// Writes the differing indices of [begin, end) to out and returns the advanced pointer.
+uint32_t* write_differences(const int32_t* a, const int32_t* b, size_t begin, size_t end, uint32_t* out) {
+    size_t i = begin;
+    for (; i + kCompareBlock <= end; i += kCompareBlock) {
+        if (!block_differs(a, b, i)) continue;
+        for (size_t j = i; j < i + kCompareBlock; ++j) {
+            if (a[j] != b[j]) *out++ = static_cast<uint32_t>(j);
+        }
+    }
+    for (; i < end; ++i) {
+        if (a[i] != b[i]) *out++ = static_cast<uint32_t>(i);
+    }
+    return out;
+}
+
+// Below this many elements a selection step runs inline instead of as a separate task
+constexpr size_t kSelectTaskMin = 65536;
+
+// Moves the elements of the ascending, distinct ranks[rlo, rhi) to their sorted positions
+// within data[begin, end). Selecting the middle rank partitions the range, so both sides
+// are independent and recurse in parallel, each with only the ranks that fall into it.
+void multi_select(std::vector<int32_t>& data, size_t begin, size_t end, const std::vector<size_t>& ranks, size_t rlo, size_t rhi) {
+    if (rlo >= rhi) return;
+    size_t mid = rlo + (rhi - rlo) / 2;
+    size_t rank = ranks[mid];
+    run_with_policy([&](auto policy) {
+        hpx::nth_element(policy, data.begin() + begin, data.begin() + rank, data.begin() + end);
+    }, end - begin);
+    if (rank - begin >= kSelectTaskMin && mid + 1 < rhi) {
+        auto left = hpx::async([&]() { multi_select(data, begin, rank, ranks, rlo, mid); });
+        multi_select(data, rank + 1, end, ranks, mid + 1, rhi);
+        left.get();
+    } else {
+        multi_select(data, begin, rank, ranks, rlo, mid);
+        multi_select(data, rank + 1, end, ranks, mid + 1, rhi);
+    }
+}
+
+} // namespace
 
 // https://hpx-docs.stellar-group.org/latest/html/libs/core/algorithms/api/sort.html
 hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_sort(const int32_t* src, size_t size) {
@@ -59,6 +133,62 @@ hpx::future<bool> hpx_equal(const int32_t* arr1, size_t size1, const int32_t* ar
         }, effective_size);
     });
 }
+// https://hpx-docs.stellar-group.org/latest/html/libs/core/algorithms/api/mismatch.html
+hpx::future<int64_t> hpx_mismatch(const int32_t* arr1, size_t size1, const int32_t* arr2, size_t size2) {
+    size_t common = std::min(size1, size2);
+    return hpx::async([arr1, arr2, size1, size2, common]() {
+        size_t first = run_with_policy([&](auto policy) {
+            size_t chunks = chunk_count(common);
+            size_t chunk_size = (common + chunks - 1) / chunks;
+            std::atomic<size_t> best(common);
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t end = std::min(common, (c + 1) * chunk_size);
+                for (size_t begin = c * chunk_size; begin < end; begin += kCompareStripe) {
+                    if (begin >= best.load(std::memory_order_relaxed)) return;
+                    size_t stripe_end = std::min(end, begin + kCompareStripe);
+                    size_t pos = first_difference(arr1, arr2, begin, stripe_end);
+                    if (pos == stripe_end) continue;
+                    size_t cur = best.load(std::memory_order_relaxed);
+                    while (pos < cur && !best.compare_exchange_weak(cur, pos, std::memory_order_relaxed)) {}
+                    return;
+                }
+            });
+            return best.load();
+        }, common);
+        if (first < common) return static_cast<int64_t>(first);
+        return size1 == size2 ? static_cast<int64_t>(-1) : static_cast<int64_t>(common);
+    });
+}
+// Parallel compaction: count differences per chunk, scan the counts into offsets, then write.
+hpx::future<std::shared_ptr<std::vector<uint32_t>>> hpx_diff_positions(const int32_t* arr1, size_t size1, const int32_t* arr2, size_t size2) {
+    size_t common = std::min(size1, size2);
+    size_t total = std::max(size1, size2);
+    if (total > std::numeric_limits<uint32_t>::max()) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<uint32_t>>>(std::runtime_error("Arrays too large for 32-bit positions"));
+    }
+    return hpx::async([arr1, arr2, common, total]() {
+        return run_with_policy([&](auto policy) {
+            size_t chunks = chunk_count(common);
+            size_t chunk_size = (common + chunks - 1) / chunks;
+            std::vector<size_t> offsets(chunks + 1, 0);
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(common, c * chunk_size);
+                size_t end = std::min(common, begin + chunk_size);
+                offsets[c + 1] = count_differences(arr1, arr2, begin, end);
+            });
+            for (size_t c = 0; c < chunks; ++c) offsets[c + 1] += offsets[c];
+
+            auto out = std::make_shared<std::vector<uint32_t>>(offsets[chunks] + (total - common));
+            hpx::experimental::for_loop(policy, size_t(0), chunks, [&](size_t c) {
+                size_t begin = std::min(common, c * chunk_size);
+                size_t end = std::min(common, begin + chunk_size);
+                write_differences(arr1, arr2, begin, end, out->data() + offsets[c]);
+            });
+            for (size_t i = common; i < total; ++i) (*out)[offsets[chunks] + (i - common)] = static_cast<uint32_t>(i);
+            return out;
+        }, common);
+    });
+}
 // https://hpx-docs.stellar-group.org/latest/html/libs/core/algorithms/api/find.html
 hpx::future<int64_t> hpx_find(const int32_t* src, size_t size, int32_t value) {
     auto input = std::make_shared<std::vector<int32_t>>(src, src + size);
@@ -98,6 +228,42 @@ hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_partial_sort(const int32_
         }, input->size());
     });
 }
+// https://hpx-docs.stellar-group.org/latest/html/libs/core/algorithms/api/nth_element.html
+hpx::future<std::shared_ptr<std::vector<double>>> hpx_quantiles(const int32_t* src, size_t size, std::vector<double> quantiles) {
+    if (size == 0) {
+        return hpx::make_exceptional_future<std::shared_ptr<std::vector<double>>>(std::runtime_error("Cannot compute quantiles of an empty array"));
+    }
+    for (double q : quantiles) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            return hpx::make_exceptional_future<std::shared_ptr<std::vector<double>>>(std::runtime_error("Quantiles must be in [0, 1]"));
+        }
+    }
+
+    auto input = std::make_shared<std::vector<int32_t>>(src, src + size);
+    return hpx::async([input, quantiles]() {
+        // Linear interpolation between the two closest ranks (h = q * (n - 1))
+        size_t n = input->size();
+        std::vector<size_t> ranks;
+        for (double q : quantiles) {
+            size_t lo = static_cast<size_t>(q * static_cast<double>(n - 1));
+            ranks.push_back(lo);
+            ranks.push_back(std::min(lo + 1, n - 1));
+        }
+        std::sort(ranks.begin(), ranks.end());
+        ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+        multi_select(*input, 0, n, ranks, 0, ranks.size());
+
+        auto out = std::make_shared<std::vector<double>>(quantiles.size());
+        for (size_t i = 0; i < quantiles.size(); ++i) {
+            double h = quantiles[i] * static_cast<double>(n - 1);
+            size_t lo = static_cast<size_t>(h);
+            size_t hi = std::min(lo + 1, n - 1);
+            double a = (*input)[lo], b = (*input)[hi];
+            (*out)[i] = a + (h - static_cast<double>(lo)) * (b - a);
+        }
+        return out;
+    });
+}
 // https://hpx-docs.stellar-group.org/latest/html/libs/core/algorithms/api/copy.html
 hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_copy_n(const int32_t* src, size_t count) {
     auto input = std::make_shared<std::vector<int32_t>>(src, src + count);
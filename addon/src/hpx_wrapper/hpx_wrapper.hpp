@@ -60,6 +60,35 @@ hpx::future<bool> hpx_ends_with(const int32_t* src, size_t src_size, const int32
  */
 hpx::future<bool> hpx_equal(const int32_t* arr1, size_t size1, const int32_t* arr2, size_t size2);
 
+/**
+ * @brief Finds the first index at which two arrays differ.
+ *
+ * Reads both arrays in place (no copy), so the caller must keep them alive until the future is ready.
+ * Chunks are compared in parallel and stop early once a difference before them has been found.
+ *
+ * @param arr1 Pointer to the first array.
+ * @param size1 Number of elements in the first array.
+ * @param arr2 Pointer to the second array.
+ * @param size2 Number of elements in the second array.
+ * @return A future that, when ready, returns the first differing index, min(size1, size2) if one array
+ *         is a strict prefix of the other, or -1 if both arrays are equal.
+ */
+hpx::future<int64_t> hpx_mismatch(const int32_t* arr1, size_t size1, const int32_t* arr2, size_t size2);
+
+/**
+ * @brief Collects all indices at which two arrays differ.
+ *
+ * Reads both arrays in place (no copy). Positions are gathered with a parallel count/scan/write compaction.
+ * If the sizes differ, every index past the end of the shorter array is reported as a difference.
+ *
+ * @param arr1 Pointer to the first array.
+ * @param size1 Number of elements in the first array.
+ * @param arr2 Pointer to the second array.
+ * @param size2 Number of elements in the second array.
+ * @return A future that, when ready, returns a shared pointer to the ascending differing indices.
+ */
+hpx::future<std::shared_ptr<std::vector<uint32_t>>> hpx_diff_positions(const int32_t* arr1, size_t size1, const int32_t* arr2, size_t size2);
+
 /**
  * @brief Finds the first occurrence of a given value in the array.
  *
@@ -98,6 +127,21 @@ hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_merge(const int32_t* src1
  */
 hpx::future<std::shared_ptr<std::vector<int32_t>>> hpx_partial_sort(const int32_t* src, size_t size, size_t middle);
 
+/**
+ * @brief Computes exact quantiles without sorting the whole array.
+ *
+ * The requested ranks are selected by a recursive multi-select: each step partitions the
+ * current range around one rank (parallel nth_element), and the two sides are processed in
+ * parallel with the ranks that fall into them. Values between ranks are linearly interpolated
+ * (rank h = q * (size - 1)), matching the usual "linear" percentile definition.
+ *
+ * @param src Pointer to the input array (copied, the input stays untouched).
+ * @param size Number of elements in the input array (must be > 0).
+ * @param quantiles The quantiles to compute, each in [0, 1], in any order.
+ * @return A future that, when ready, returns one value per requested quantile.
+ */
+hpx::future<std::shared_ptr<std::vector<double>>> hpx_quantiles(const int32_t* src, size_t size, std::vector<double> quantiles);
+
 /**
  * @brief Copies the first 'count' elements of the input array into a new vector.
  *
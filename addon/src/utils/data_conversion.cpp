@@ -51,6 +51,132 @@ Napi::Int32Array GetInt32ArrayArgument(const Napi::CallbackInfo& info, size_t in
     return ta.As<Napi::Int32Array>();
 }
 
+/**
+ * @brief Extracts and validates a Uint8Array argument from a JavaScript call.
+ *
+ * Counterpart of GetInt32ArrayArgument for byte-oriented inputs (masks, serialized sketches).
+ * Node.js Buffers are Uint8Arrays and are accepted as well.
+ *
+ * @param info Napi callback info, providing access to arguments.
+ * @param index The zero-based index of the argument to extract.
+ * @return A Napi::Uint8Array representing the extracted argument.
+ * @throws If the argument is missing or not a Uint8Array, a JS TypeError is thrown.
+ */
+Napi::Uint8Array GetUint8ArrayArgument(const Napi::CallbackInfo& info, size_t index) {
+    if (info.Length() <= index || !info[index].IsTypedArray()) {
+        Napi::TypeError::New(info.Env(), "Expected a Uint8Array at argument " + std::to_string(index)).ThrowAsJavaScriptException();
+        return Napi::Uint8Array();
+    }
+    auto ta = info[index].As<Napi::TypedArray>();
+    if (ta.TypedArrayType() != napi_uint8_array) {
+        Napi::TypeError::New(info.Env(), "Expected Uint8Array").ThrowAsJavaScriptException();
+        return Napi::Uint8Array();
+    }
+    return ta.As<Napi::Uint8Array>();
+}
+
+/**
+ * @brief Extracts a list of numbers (an Array of numbers or a Float64Array) from a JavaScript call.
+ *
+ * Used for small parameter lists such as requested quantiles, so the values are copied.
+ *
+ * @param info Napi callback info, providing access to arguments.
+ * @param index The zero-based index of the argument to extract.
+ * @return The numbers in argument order.
+ * @throws If the argument is neither, or an Array element is not a number, a JS TypeError is thrown.
+ */
+std::vector<double> GetNumberListArgument(const Napi::CallbackInfo& info, size_t index) {
+    std::vector<double> out;
+    if (info.Length() > index && info[index].IsTypedArray() &&
+        info[index].As<Napi::TypedArray>().TypedArrayType() == napi_float64_array) {
+        auto arr = info[index].As<Napi::Float64Array>();
+        out.assign(arr.Data(), arr.Data() + arr.ElementLength());
+        return out;
+    }
+    if (info.Length() <= index || !info[index].IsArray()) {
+        Napi::TypeError::New(info.Env(), "Expected an Array of numbers at argument " + std::to_string(index)).ThrowAsJavaScriptException();
+        return out;
+    }
+    Napi::Array arr = info[index].As<Napi::Array>();
+    for (uint32_t i = 0; i < arr.Length(); i++) {
+        Napi::Value v = arr.Get(i);
+        if (!v.IsNumber()) {
+            Napi::TypeError::New(info.Env(), "Expected an Array of numbers at argument " + std::to_string(index)).ThrowAsJavaScriptException();
+            return {};
+        }
+        out.push_back(v.As<Napi::Number>().DoubleValue());
+    }
+    return out;
+}
+
+/**
+ * @brief Extracts an Array of Uint8Arrays (e.g. serialized sketches) from a JavaScript call.
+ *
+ * The bytes are copied, so the result can be handed to async work without retaining the inputs.
+ *
+ * @param info Napi callback info, providing access to arguments.
+ * @param index The zero-based index of the argument to extract.
+ * @return One byte vector per Array element.
+ * @throws If the argument is not an Array of Uint8Arrays, a JS TypeError is thrown.
+ */
+std::vector<std::vector<uint8_t>> GetUint8ArrayListArgument(const Napi::CallbackInfo& info, size_t index) {
+    std::vector<std::vector<uint8_t>> out;
+    if (info.Length() <= index || !info[index].IsArray()) {
+        Napi::TypeError::New(info.Env(), "Expected an Array of Uint8Arrays at argument " + std::to_string(index)).ThrowAsJavaScriptException();
+        return out;
+    }
+    Napi::Array arr = info[index].As<Napi::Array>();
+    for (uint32_t i = 0; i < arr.Length(); i++) {
+        Napi::Value v = arr.Get(i);
+        if (!v.IsTypedArray() || v.As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+            Napi::TypeError::New(info.Env(), "Expected an Array of Uint8Arrays at argument " + std::to_string(index)).ThrowAsJavaScriptException();
+            return {};
+        }
+        auto bytes = v.As<Napi::Uint8Array>();
+        out.emplace_back(bytes.Data(), bytes.Data() + bytes.ElementLength());
+    }
+    return out;
+}
+
+/**
+ * @brief Pins JavaScript arguments so their backing buffers outlive an async operation.
+ *
+ * Operations that read a typed array in place (instead of copying it into a std::vector first)
+ * must keep the JS object reachable until the work completes, otherwise the GC may free the buffer
+ * while HPX threads are still reading it. The returned references must be captured by the
+ * "complete" lambda of QueueAsyncWork, so they are released on the main thread.
+ *
+ * @param info Napi callback info, providing access to arguments.
+ * @param indices Zero-based indices of the object arguments to retain.
+ * @return A shared_ptr to the persistent references (one per retained argument).
+ */
+RetainedArguments RetainArguments(const Napi::CallbackInfo& info, std::initializer_list<size_t> indices) {
+    auto refs = std::make_shared<std::vector<Napi::ObjectReference>>();
+    refs->reserve(indices.size());
+    for (size_t index : indices) {
+        if (index < info.Length() && info[index].IsObject()) {
+            refs->emplace_back(Napi::Persistent(info[index].As<Napi::Object>()));
+        }
+    }
+    return refs;
+}
+
+/**
+ * @brief Tells whether two typed arrays share bytes.
+ *
+ * Kernels that write an 'out' argument while reading their inputs in place use this to reject
+ * aliased buffers, whose results would depend on the order in which HPX tasks run.
+ *
+ * @param a First typed array.
+ * @param b Second typed array.
+ * @return True if both view the same ArrayBuffer and their byte ranges intersect.
+ */
+bool TypedArraysOverlap(const Napi::TypedArray& a, const Napi::TypedArray& b) {
+    return a.ArrayBuffer() == b.ArrayBuffer() &&
+        a.ByteOffset() < b.ByteOffset() + b.ByteLength() &&
+        b.ByteOffset() < a.ByteOffset() + a.ByteLength();
+}
+
 /**
  * @brief Retrieves a predicate mask array from a JavaScript callback using a ThreadSafeFunction.
  *
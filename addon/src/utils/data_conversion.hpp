@@ -4,9 +4,20 @@
 #include <napi.h>
 #include <memory>
 #include <vector>
+#include <initializer_list>
 
 std::string ToUpperCase(const std::string& str);
 Napi::Int32Array GetInt32ArrayArgument(const Napi::CallbackInfo& info, size_t index);
+Napi::Uint8Array GetUint8ArrayArgument(const Napi::CallbackInfo& info, size_t index);
+std::vector<double> GetNumberListArgument(const Napi::CallbackInfo& info, size_t index);
+std::vector<std::vector<uint8_t>> GetUint8ArrayListArgument(const Napi::CallbackInfo& info, size_t index);
+
+// Keeps JS arguments alive while async work reads their buffers in place
+using RetainedArguments = std::shared_ptr<std::vector<Napi::ObjectReference>>;
+RetainedArguments RetainArguments(const Napi::CallbackInfo& info, std::initializer_list<size_t> indices);
+
+// True if both typed arrays view the same ArrayBuffer and their byte ranges intersect
+bool TypedArraysOverlap(const Napi::TypedArray& a, const Napi::TypedArray& b);
 
 // Functions that use an already-created TSFN
 std::shared_ptr<std::vector<uint8_t>> GetPredicateMaskBatchUsingTSFN(const Napi::ThreadSafeFunction& tsfn, const int32_t* data, size_t length);
@@ -3,6 +3,13 @@ import { createRequire } from 'module';
 import chalk from 'chalk';
 import ora from 'ora';
 import figlet from 'figlet';
+import { mkdtempSync, readFileSync, rmSync, writeFileSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { fileURLToPath } from 'url';
+import { setFlagsFromString } from 'v8';
+import { runInNewContext } from 'vm';
+import { Worker } from 'worker_threads';
 
 const require = createRequire(import.meta.url);
 const {
@@ -13,6 +20,8 @@ const {
   count: _count,
   endsWith,
   equal,
+  mismatch,
+  diffPositions,
   find,
   merge,
   partialSort,
@@ -21,7 +30,54 @@ const {
   countIf,
   copyIf,
   sortComp,
-  partialSortComp
+  partialSortComp,
+  buildValueIndex,
+  createResidentBuffer,
+  bloomBuild,
+  bloomQuery,
+  distinctApprox,
+  hllMerge,
+  quantiles,
+  quantileSketch,
+  quantileSketchMerge,
+  quantileSketchQuery,
+  countApprox,
+  countIfApprox,
+  sumApprox,
+  meanApprox,
+  rolling,
+  convolve,
+  matmul,
+  transpose,
+  spmv,
+  createCsrMatrix,
+  bfs,
+  connectedComponents,
+  kmeans,
+  resample,
+  downsampleLTTB,
+  asofJoin,
+  parseNumbers,
+  saveSnapshot,
+  loadSnapshot,
+  indexLines,
+  searchBytes,
+  dictEncode,
+  arrowImport,
+  arrowCount,
+  arrowSort,
+  arrowFilter,
+  loadKernelPlugin,
+  transform,
+  createPredicatePool,
+  encodeBitpacked,
+  decodeBitpacked,
+  bitpackedCount,
+  bitpackedFind,
+  bitpackedCountRange,
+  bitpackedSum,
+  bitmapFromMask,
+  bitmapFromIndices
 } = require('../addons/hpxaddon.node');
 
 // Helpers
@@ -182,6 +238,22 @@ describe('HPX Addon Test Suite', function() {
       expect(result).to.be.true;
     });
 
+    it('should find the first differing index using HPX mismatch', async function() {
+      const arr1 = toInt32Array([1, 2, 3, 4, 5]);
+      const arr2 = toInt32Array([1, 2, 9, 4, 7]);
+      expect(await mismatch(arr1, arr2)).to.equal(2);
+      expect(await mismatch(arr1, toInt32Array([1, 2, 3, 4, 5]))).to.equal(-1);
+      expect(await mismatch(arr1, toInt32Array([1, 2, 3]))).to.equal(3);
+    });
+
+    it('should list all differing indices using HPX diffPositions', async function() {
+      const arr1 = toInt32Array([1, 2, 3, 4, 5]);
+      const arr2 = toInt32Array([1, 2, 9, 4, 7, 6]);
+      const positions = await diffPositions(arr1, arr2);
+      expect(positions).to.be.instanceOf(Uint32Array);
+      expect(Array.from(positions)).to.deep.equal([2, 4, 5]);
+    });
+
     it('should find an element using HPX find', async function() {
       const data = toInt32Array([1, 2, 3, 4, 5]);
       const valueToFind = 3;
@@ -217,6 +289,704 @@ describe('HPX Addon Test Suite', function() {
       expect(partiallySortedArray.slice(0, middle)).to.deep.equal([5,4]);
     });
 
+    it('should answer count/find/findAll from a value index built with buildValueIndex', async function() {
+      const data = toInt32Array([7, 3, 7, 1, 3, 7]);
+      const index = await buildValueIndex(data);
+      expect(index.length).to.equal(6);
+      expect(index.distinct).to.equal(3);
+      expect(index.count(7)).to.equal(3);
+      expect(index.find(3)).to.equal(1);
+      expect(index.find(42)).to.equal(-1);
+      expect(Array.from(index.findAll(7))).to.deep.equal([0, 2, 5]);
+      const counts = await index.countBatch(toInt32Array([1, 3, 42]));
+      expect(Array.from(counts)).to.deep.equal([1, 2, 0]);
+      const firsts = await index.findBatch(toInt32Array([7, 42]));
+      expect(Array.from(firsts)).to.deep.equal([0, -1]);
+    });
+
+    it('should query and update a resident buffer with a zone map', async function() {
+      const data = new Int32Array(200000);
+      for (let i = 0; i < data.length; i++) data[i] = Math.floor(i / 1000);
+      const buffer = await createResidentBuffer(data, { zoneMap: true });
+      expect(buffer.length).to.equal(200000);
+      expect(buffer.hasZoneMap).to.be.true;
+      expect(await buffer.count(150)).to.equal(1000);
+      expect(await buffer.find(150)).to.equal(150000);
+      expect(await buffer.countRange(10, 19)).to.equal(10000);
+      await buffer.write(5, toInt32Array([150, 150]));
+      expect(await buffer.count(150)).to.equal(1002);
+      expect(await buffer.find(150)).to.equal(5);
+      expect(Array.from(await buffer.read(4, 3))).to.deep.equal([0, 150, 150]);
+    });
+
+    it('should keep resident buffer writes atomic under concurrent counts', async function() {
+      const size = 200000;
+      const buffer = await createResidentBuffer(new Int32Array(size), { zoneMap: true });
+      // Every write replaces the whole buffer, so a count sees all or none of it
+      const pending = [];
+      for (let k = 1; k <= 8; k++) {
+        pending.push(buffer.write(0, new Int32Array(size).fill(k)));
+        for (let q = 1; q <= 8; q++) pending.push(buffer.count(q));
+      }
+      const results = await Promise.all(pending);
+      results.filter((r) => typeof r === 'number').forEach((n) => expect([0, size]).to.include(n));
+      const last = (await buffer.read(0, 1))[0];
+      expect(await buffer.count(last)).to.equal(size);
+    });
+
+    it('should build and query a Bloom filter using HPX bloomBuild/bloomQuery', async function() {
+      const keys = new Int32Array(50000);
+      for (let i = 0; i < keys.length; i++) keys[i] = i * 2;
+      const filter = await bloomBuild(keys, { fpRate: 0.01 });
+      expect(filter).to.be.instanceOf(Uint8Array);
+      const present = await bloomQuery(filter, keys);
+      expect(present.every(v => v === 1)).to.be.true;
+      const probes = new Int32Array(50000);
+      for (let i = 0; i < probes.length; i++) probes[i] = i * 2 + 1;
+      const absent = await bloomQuery(filter, probes);
+      const falsePositives = absent.reduce((sum, v) => sum + v, 0);
+      expect(falsePositives).to.be.below(probes.length * 0.03);
+    });
+
+    it('should reject a malformed Bloom filter', async function() {
+      try {
+        await bloomQuery(new Uint8Array(16), toInt32Array([1]));
+        throw new Error('bloomQuery should have rejected');
+      } catch (err) {
+        expect(String(err)).to.match(/Invalid Bloom filter/);
+      }
+    });
+
+    it('should estimate distinct counts using HPX distinctApprox', async function() {
+      const arr = new Int32Array(200000);
+      for (let i = 0; i < arr.length; i++) arr[i] = i % 50000;
+      const { estimate, sketch } = await distinctApprox(arr);
+      expect(sketch).to.be.instanceOf(Uint8Array);
+      expect(Math.abs(estimate - 50000) / 50000).to.be.below(0.05);
+    });
+
+    it('should merge HyperLogLog sketches using HPX hllMerge', async function() {
+      const a = new Int32Array(40000);
+      const b = new Int32Array(40000);
+      for (let i = 0; i < a.length; i++) { a[i] = i; b[i] = i + 20000; }
+      const first = await distinctApprox(a, { precision: 12 });
+      const second = await distinctApprox(b, { precision: 12 });
+      const { estimate } = await hllMerge([first.sketch, second.sketch]);
+      expect(Math.abs(estimate - 60000) / 60000).to.be.below(0.08);
+      const other = await distinctApprox(a, { precision: 10 });
+      try {
+        await hllMerge([first.sketch, other.sketch]);
+        throw new Error('hllMerge should have rejected');
+      } catch (err) {
+        expect(String(err)).to.match(/different precision/);
+      }
+    });
+
+    it('should compute exact quantiles using HPX quantiles', async function() {
+      const data = toInt32Array([9, 1, 8, 2, 7, 3, 6, 4, 5, 10]);
+      const result = await quantiles(data, [0.5, 0, 1, 0.9]);
+      expect(result).to.be.instanceOf(Float64Array);
+      expect(Array.from(result.subarray(0, 3))).to.deep.equal([5.5, 1, 10]);
+      expect(result[3]).to.be.closeTo(9.1, 1e-9);
+      expect(Array.from(data)).to.deep.equal([9, 1, 8, 2, 7, 3, 6, 4, 5, 10]);
+    });
+
+    it('should approximate quantiles with mergeable sketches', async function() {
+      const first = new Int32Array(100000);
+      const second = new Int32Array(100000);
+      for (let i = 0; i < first.length; i++) { first[i] = i; second[i] = i + 100000; }
+      const merged = await quantileSketchMerge([await quantileSketch(first), await quantileSketch(second)]);
+      const [p50, p99] = await quantileSketchQuery(merged, [0.5, 0.99]);
+      expect(Math.abs(p50 - 100000)).to.be.below(200000 * 0.02);
+      expect(Math.abs(p99 - 198000)).to.be.below(200000 * 0.02);
+    });
+
+    it('should approximate count and countIf within the requested error bound', async function() {
+      const arr = new Int32Array(2000000);
+      for (let i = 0; i < arr.length; i++) arr[i] = (i * 7919) % 100;
+      const counted = await countApprox(arr, 42, { errorBound: 0.02 });
+      expect(counted.lower).to.be.at.most(counted.estimate);
+      expect(counted.upper).to.be.at.least(counted.estimate);
+      expect(Math.abs(counted.estimate - 20000) / 20000).to.be.below(0.05);
+      const matched = await countIfApprox(arr, elementPredicateToMask(v => v < 10), { errorBound: 0.02 });
+      expect(matched.sampled).to.be.at.most(arr.length);
+      expect(Math.abs(matched.estimate - 200000) / 200000).to.be.below(0.05);
+    });
+
+    it('should return exact approximate aggregates for small arrays', async function() {
+      const arr = toInt32Array([1, 2, 3, 4, 5, 6, 7, 8]);
+      const sum = await sumApprox(arr, { timeBudgetMs: 5 });
+      expect(sum.exact).to.be.true;
+      expect(sum.estimate).to.equal(36);
+      expect((await meanApprox(arr)).estimate).to.equal(4.5);
+    });
+
+    it('should compute rolling aggregates using HPX rolling', async function() {
+      const data = toInt32Array([4, 1, 3, 5, 2, 6]);
+      const { sum, mean, min, max } = await rolling(data, 3, ['sum', 'mean', 'min', 'max']);
+      expect(Array.from(sum)).to.deep.equal([8, 9, 10, 13]);
+      expect(mean[1]).to.equal(3);
+      expect(Array.from(min)).to.deep.equal([1, 1, 2, 2]);
+      expect(Array.from(max)).to.deep.equal([4, 5, 5, 6]);
+      const onlyMax = await rolling(data, 2, ['max']);
+      expect(onlyMax.sum).to.be.undefined;
+      expect(Array.from(onlyMax.max)).to.deep.equal([4, 3, 5, 5, 6]);
+    });
+
+    it('should convolve Float64 signals using HPX convolve', async function() {
+      const signal = Float64Array.from([1, 2, 3, 4]);
+      const kernel = Float64Array.from([1, 0, -1]);
+      expect(Array.from(await convolve(signal, kernel))).to.deep.equal([1, 2, 2, 2, -3, -4]);
+      expect(Array.from(await convolve(signal, kernel, { mode: 'same' }))).to.deep.equal([2, 2, 2, -3]);
+      const out = new Float64Array(2);
+      const valid = await convolve(signal, kernel, { mode: 'valid', out });
+      expect(valid).to.equal(out);
+      expect(Array.from(out)).to.deep.equal([2, 2]);
+
+      // In place, tasks would read signal halos that other tasks already overwrote
+      expect(() => convolve(signal, kernel, { mode: 'same', out: signal })).to.throw(RangeError);
+      expect(() => convolve(signal, kernel, { mode: 'valid', out: kernel.subarray(1) })).to.throw(RangeError);
+    });
+
+    it('should convolve with long kernels via FFT using HPX convolve', async function() {
+      const signal = new Float32Array(5000);
+      const kernel = new Float32Array(200);
+      for (let i = 0; i < signal.length; i++) signal[i] = Math.sin(i / 10);
+      for (let i = 0; i < kernel.length; i++) kernel[i] = 1 / kernel.length;
+      const result = await convolve(signal, kernel, { mode: 'valid' });
+      expect(result).to.be.instanceOf(Float32Array);
+      expect(result.length).to.equal(4801);
+      let expected = 0;
+      for (let i = 0; i < kernel.length; i++) expected += signal[1000 + i] * kernel[i];
+      expect(result[1000]).to.be.closeTo(expected, 1e-4);
+    });
+
+    it('should multiply matrices using HPX matmul', async function() {
+      const a = Float64Array.from([1, 2, 3, 4, 5, 6]);        // 2 x 3
+      const b = Float64Array.from([7, 8, 9, 10, 11, 12]);     // 3 x 2
+      const c = await matmul(a, b, { m: 2, n: 2, k: 3 });
+      expect(Array.from(c)).to.deep.equal([58, 64, 139, 154]);
+      try {
+        await matmul(a, b, { m: 3, n: 2, k: 3 });
+        throw new Error('matmul should have thrown');
+      } catch (err) {
+        expect(err).to.be.instanceOf(RangeError);
+      }
+      // 'out' aliasing an input would be read while it is being written
+      const shared = new Float64Array(8);
+      const square = shared.subarray(0, 4);
+      for (const out of [square, shared.subarray(2, 6)]) {
+        try {
+          await matmul(square, Float64Array.from([1, 0, 0, 1]), { m: 2, n: 2, k: 2, out });
+          throw new Error('matmul should have rejected an overlapping out');
+        } catch (err) {
+          expect(err).to.be.instanceOf(RangeError);
+        }
+      }
+      const product = await matmul(square.fill(1), Float64Array.from([1, 0, 0, 1]), { m: 2, n: 2, k: 2, out: shared.subarray(4, 8) });
+      expect(Array.from(product)).to.deep.equal([1, 1, 1, 1]);
+
+      // Dimensions whose product would wrap around size_t must not reach the kernel
+      for (const dims of [{ m: 2 ** 32, n: 2, k: 2 ** 32 }, { m: -2, n: 2, k: -3 }, { m: 1.5, n: 2, k: 4 }]) {
+        expect(() => matmul(a, b, dims)).to.throw(RangeError);
+      }
+    });
+
+    it('should transpose matrices using HPX transpose', async function() {
+      const a = Float32Array.from([1, 2, 3, 4, 5, 6]);        // 2 x 3
+      const out = new Float32Array(6);
+      const t = await transpose(a, 2, 3, { out });
+      expect(t).to.equal(out);
+      expect(Array.from(out)).to.deep.equal([1, 4, 2, 5, 3, 6]);
+
+      expect(() => transpose(new Float64Array(0), 2 ** 32, 2 ** 32)).to.throw(RangeError);
+      expect(() => transpose(new Float64Array(6), -2, -3)).to.throw(RangeError);
+      expect(() => transpose(a, 2, 3, { out: a })).to.throw(RangeError);
+    });
+
+    it('should multiply sparse CSR matrices using HPX spmv', async function() {
+      // [[1, 0, 2], [0, 0, 0], [3, 4, 0]]
+      const rowOffsets = Uint32Array.from([0, 2, 2, 4]);
+      const colIdx = Uint32Array.from([0, 2, 0, 1]);
+      const values = Float64Array.from([1, 2, 3, 4]);
+      const x = Float64Array.from([1, 2, 3]);
+      const y = await spmv(rowOffsets, colIdx, values, x, new Float64Array(3));
+      expect(Array.from(y)).to.deep.equal([7, 0, 11]);
+
+      const matrix = await createCsrMatrix(rowOffsets, colIdx, values);
+      expect(matrix.nnz).to.equal(4);
+      expect(Array.from(await matrix.multiply(x))).to.deep.equal([7, 0, 11]);
+      expect(Array.from(await matrix.multiply(Float64Array.from([0, 1, 0])))).to.deep.equal([0, 0, 4]);
+
+      // y is written while x is still being read, so the two must not share bytes
+      const vectors = new Float64Array(5);
+      for (const call of [
+        () => spmv(rowOffsets, colIdx, values, vectors.subarray(0, 3), vectors.subarray(2, 5)),
+        () => matrix.multiply(vectors.subarray(0, 3), vectors.subarray(2, 5)),
+      ]) {
+        try {
+          await call();
+          throw new Error('an overlapping y should have been rejected');
+        } catch (err) {
+          expect(err).to.be.instanceOf(RangeError);
+        }
+      }
+
+      try {
+        await createCsrMatrix(rowOffsets, Uint32Array.from([0, 3, 0, 1]), values);
+        throw new Error('createCsrMatrix should have rejected');
+      } catch (err) {
+        expect(String(err)).to.include('column index out of range');
+      }
+    });
+
+    it('should compute BFS levels and connected components', async function() {
+      // 0 -> 1 -> 2, 0 -> 3, and a separate edge 4 -> 5
+      const offsets = toInt32Array([0, 2, 3, 3, 3, 4, 4]);
+      const edges = toInt32Array([1, 3, 2, 5]);
+      const levels = await bfs(offsets, edges, 0);
+      expect(Array.from(levels)).to.deep.equal([0, 1, 2, 1, -1, -1]);
+      const labels = await connectedComponents(offsets, edges);
+      expect(Array.from(labels)).to.deep.equal([0, 0, 0, 0, 4, 4]);
+
+      try {
+        await bfs(offsets, toInt32Array([1, 3, 2, 9]), 0);
+        throw new Error('bfs should have rejected');
+      } catch (err) {
+        expect(String(err)).to.include('out of range');
+      }
+    });
+
+    it('should cluster points using HPX kmeans', async function() {
+      // Two well separated groups in 2D
+      const points = Float32Array.from([0, 0, 0, 1, 1, 0, 10, 10, 10, 11, 11, 10]);
+      const res = await kmeans(points, 2, 2, { seed: 1 });
+      expect(res.converged).to.be.true;
+      expect(res.centroids).to.be.instanceOf(Float32Array);
+      const a = Array.from(res.assignments);
+      expect(a[0]).to.equal(a[1]).and.to.equal(a[2]);
+      expect(a[3]).to.equal(a[4]).and.to.equal(a[5]);
+      expect(a[0]).to.not.equal(a[3]);
+      expect(res.inertia).to.be.closeTo(8 / 3, 1e-5);
+    });
+
+    it('should resample time series into buckets using HPX resample', async function() {
+      const timestamps = Float64Array.from([1000, 1200, 1900, 3100, 3500]);
+      const values = Float64Array.from([1, 2, 3, 4, 5]);
+      const sums = await resample(timestamps, values, { bucketMs: 1000, agg: 'sum' });
+      expect(Array.from(sums)).to.deep.equal([6, 0, 9]);
+      const out = new Float64Array(2);
+      const means = await resample(timestamps, values, { bucketMs: 1000, start: 1000, end: 3000, out });
+      expect(means).to.equal(out);
+      expect(out[0]).to.equal(2);
+      expect(Number.isNaN(out[1])).to.be.true;
+
+      // Buckets written into the inputs would clobber points other tasks still read
+      const series = Float64Array.from([1000, 1200, 1900, 3100, 3500, 1, 2, 3, 4, 5]);
+      const seriesTimes = series.subarray(0, 5);
+      const seriesValues = series.subarray(5);
+      expect(() => resample(seriesTimes, seriesValues, { bucketMs: 1000, out: series.subarray(4, 7) })).to.throw(RangeError);
+      expect(() => resample(seriesTimes, seriesValues, { bucketMs: 1000, out: seriesTimes.subarray(0, 3) })).to.throw(RangeError);
+    });
+
+    it('should downsample series using HPX downsampleLTTB', async function() {
+      const x = Float64Array.from({ length: 100 }, (_, i) => i);
+      const y = Float64Array.from({ length: 100 }, (_, i) => (i === 40 ? 50 : 0));
+      const idx = await downsampleLTTB(x, y, 5);
+      expect(idx).to.be.instanceOf(Uint32Array);
+      expect(idx.length).to.equal(5);
+      expect(idx[0]).to.equal(0);
+      expect(idx[4]).to.equal(99);
+      expect(Array.from(idx)).to.include(40);
+    });
+
+    it('should match nearest preceding timestamps using HPX asofJoin', async function() {
+      const trades = Float64Array.from([1, 5, 10, 20]);
+      const quotes = Float64Array.from([2, 5, 8, 9]);
+      const idx = await asofJoin(trades, quotes);
+      expect(Array.from(idx)).to.deep.equal([-1, 1, 3, 3]);
+      const near = await asofJoin(trades, quotes, { tolerance: 3, allowExactMatches: false });
+      expect(Array.from(near)).to.deep.equal([-1, 0, 3, -1]);
+    });
+
+    it('should parse numeric CSV columns using HPX parseNumbers', async function() {
+      const csv = 'id,price\n1,2.5\r\n2, -3\n\n3,4e2\n';
+      const ids = await parseNumbers(Buffer.from(csv), { header: true });
+      expect(ids).to.be.instanceOf(Int32Array);
+      expect(Array.from(ids)).to.deep.equal([1, 2, 3]);
+      const prices = await parseNumbers(Buffer.from(csv), { header: true, column: 1, type: 'float64' });
+      expect(Array.from(prices)).to.deep.equal([2.5, -3, 400]);
+
+      const dir = mkdtempSync(join(tmpdir(), 'hpx-parse-'));
+      try {
+        const file = join(dir, 'values.tsv');
+        writeFileSync(file, 'a\t10\nb\t20\nc\tx\n');
+        try {
+          await parseNumbers(file, { delimiter: '\t', column: 1 });
+          throw new Error('parseNumbers should have rejected');
+        } catch (err) {
+          expect(String(err)).to.include('line 3');
+        }
+      } finally {
+        rmSync(dir, { recursive: true, force: true });
+      }
+    });
+
+    it('should save and load snapshots using HPX saveSnapshot/loadSnapshot', async function() {
+      const data = Int32Array.from({ length: 200000 }, (_, i) => (i * 7919) % 1000);
+      const buffer = await createResidentBuffer(data, { zoneMap: true });
+      const index = await buildValueIndex(data);
+      const dir = mkdtempSync(join(tmpdir(), 'hpx-snapshot-'));
+      try {
+        const file = join(dir, 'state.snap');
+        expect(await saveSnapshot(file, { buffers: { data: buffer }, indexes: { byValue: index } })).to.equal(true);
+
+        const loaded = await loadSnapshot(file, { verify: true });
+        const restored = loaded.buffers.data;
+        expect(restored.length).to.equal(data.length);
+        expect(restored.hasZoneMap).to.equal(true);
+        expect(Array.from(await restored.read())).to.deep.equal(Array.from(data));
+        expect(await restored.count(42)).to.equal(await buffer.count(42));
+        expect(loaded.indexes.byValue.count(42)).to.equal(index.count(42));
+        expect(Array.from(loaded.indexes.byValue.findAll(7))).to.deep.equal(Array.from(index.findAll(7)));
+
+        // Writes to a loaded buffer stay in memory
+        await restored.write(0, Int32Array.from([-1]));
+        const reloaded = await loadSnapshot(file);
+        expect(Array.from(await reloaded.buffers.data.read(0, 1))).to.deep.equal([data[0]]);
+
+        // A save racing a write captures all of it or none of it
+        const racing = join(dir, 'racing.snap');
+        const filled = new Int32Array(data.length).fill(9);
+        await Promise.all([buffer.write(0, filled), saveSnapshot(racing, { buffers: { data: buffer } })]);
+        const raced = await (await loadSnapshot(racing, { verify: true })).buffers.data.read();
+        if (!raced.every((v) => v === 9)) expect(Array.from(raced)).to.deep.equal(Array.from(data));
+
+        const bytes = readFileSync(file);
+        bytes[bytes.length >> 1] ^= 1;
+        writeFileSync(file, bytes);
+        try {
+          await loadSnapshot(file, { verify: true });
+          throw new Error('loadSnapshot should have rejected');
+        } catch (err) {
+          expect(String(err)).to.include('checksum mismatch');
+        }
+      } finally {
+        rmSync(dir, { recursive: true, force: true });
+      }
+    });
+
+    it('should index lines and search bytes using HPX indexLines/searchBytes', async function() {
+      const log = Buffer.from('INFO start\nERROR disk\nINFO ok\nERROR net\nERRORERROR');
+      expect(Array.from(await indexLines(log))).to.deep.equal([10, 21, 29, 39]);
+      expect(Array.from(await searchBytes(log, 'ERROR'))).to.deep.equal([11, 30, 40, 45]);
+      expect(Array.from(await searchBytes(log, Buffer.from('\n')))).to.deep.equal([10, 21, 29, 39]);
+      expect(Array.from(await searchBytes(log, 'missing'))).to.deep.equal([]);
+
+      const big = Buffer.alloc(1 << 21, 'x');
+      big.write('needle', 1 << 20);
+      expect(Array.from(await searchBytes(big, 'needle'))).to.deep.equal([1 << 20]);
+    });
+
+    it('should dictionary-encode strings using HPX dictEncode', async function() {
+      const values = ['pear', 'apple', 'pear', 'fig', 'apple', ''];
+      const bytes = Buffer.from(values.join(''));
+      const offsets = new Int32Array(values.length + 1);
+      values.forEach((v, i) => { offsets[i + 1] = offsets[i] + Buffer.byteLength(v); });
+      const decode = ({ bytes, offsets }) =>
+        Array.from({ length: offsets.length - 1 }, (_, k) => Buffer.from(bytes.subarray(offsets[k], offsets[k + 1])).toString());
+
+      const byAppearance = await dictEncode(bytes, offsets);
+      expect(Array.from(byAppearance.codes)).to.deep.equal([0, 1, 0, 2, 1, 3]);
+      expect(decode(byAppearance.dictionary)).to.deep.equal(['pear', 'apple', 'fig', '']);
+
+      const sorted = await dictEncode(bytes, offsets, { sorted: true });
+      expect(Array.from(sorted.codes)).to.deep.equal([3, 1, 3, 2, 1, 0]);
+      expect(decode(sorted.dictionary)).to.deep.equal(['', 'apple', 'fig', 'pear']);
+    });
+
+    it('should bit-pack Int32 columns using HPX encodeBitpacked/decodeBitpacked', async function() {
+      const ids = Int32Array.from({ length: 5000 }, (_, i) => 1000000 + i * 3 + (i % 2));
+      const packed = await encodeBitpacked(ids, { delta: true });
+      expect(packed).to.be.instanceOf(Uint8Array);
+      expect(packed.length).to.be.below(ids.byteLength / 4);
+      expect(Array.from(await decodeBitpacked(packed))).to.deep.equal(Array.from(ids));
+      expect(Array.from(await decodeBitpacked(packed, { begin: 1020, end: 2050 }))).to.deep.equal(Array.from(ids.subarray(1020, 2050)));
+      expect(Array.from(await decodeBitpacked(packed, { begin: 2040, end: Infinity }))).to.deep.equal(Array.from(ids.subarray(2040)));
+      expect(Array.from(await decodeBitpacked(packed, { begin: -Infinity, end: 2 ** 70 }))).to.deep.equal(Array.from(ids));
+      expect((await decodeBitpacked(packed, { begin: Infinity })).length).to.equal(0);
+
+      const mixed = Int32Array.from({ length: 3000 }, (_, i) => ((i * 2654435761) % 4096) - (i % 7 === 0 ? 2147483648 : 0));
+      expect(Array.from(await decodeBitpacked(await encodeBitpacked(mixed)))).to.deep.equal(Array.from(mixed));
+      expect((await decodeBitpacked(await encodeBitpacked(new Int32Array(0)))).length).to.equal(0);
+
+      try {
+        await decodeBitpacked(packed.subarray(0, 40));
+        throw new Error('Expected decodeBitpacked to reject truncated bytes');
+      } catch (err) {
+        expect(String(err)).to.not.include('Expected decodeBitpacked');
+      }
+    });
+
+    it('should query bit-packed columns using HPX bitpackedCount/Find/CountRange/Sum', async function() {
+      // Runs of constant blocks, a sorted stretch and noise, so every block-skipping path is taken
+      const values = Int32Array.from({ length: 10000 }, (_, i) =>
+        i < 3072 ? 7 : i < 6000 ? i : ((i * 7919) % 1000) - 500);
+      const expected = (pred) => values.reduce((n, v) => n + (pred(v) ? 1 : 0), 0);
+      for (const delta of [false, true]) {
+        const packed = await encodeBitpacked(values, { delta });
+        expect(await bitpackedCount(packed, 7)).to.equal(expected((v) => v === 7));
+        expect(await bitpackedCount(packed, 4500)).to.equal(1);
+        expect(await bitpackedCount(packed, 123456)).to.equal(0);
+        expect(await bitpackedFind(packed, 7)).to.equal(0);
+        expect(await bitpackedFind(packed, 5000)).to.equal(5000);
+        expect(await bitpackedFind(packed, values[9999])).to.equal(values.indexOf(values[9999]));
+        expect(await bitpackedFind(packed, -1000)).to.equal(-1);
+        expect(await bitpackedCountRange(packed, -100, 4000)).to.equal(expected((v) => v >= -100 && v <= 4000));
+        expect(await bitpackedCountRange(packed, 10, 5)).to.equal(0);
+        expect(await bitpackedSum(packed)).to.equal(values.reduce((a, b) => a + b, 0));
+      }
+
+      expect(() => bitpackedCount(new Int32Array(4), 1)).to.throw(TypeError);
+      // Values that are not int32 would otherwise be truncated into a different query
+      const small = await encodeBitpacked(Int32Array.from([7, 7, 8]));
+      expect(() => bitpackedCount(small, 7.5)).to.throw(RangeError);
+      expect(() => bitpackedFind(small, 2 ** 32 + 7)).to.throw(RangeError);
+      expect(() => bitpackedCountRange(small, 0, NaN)).to.throw(RangeError);
+      expect(await bitpackedCountRange(small, -(2 ** 31), 2 ** 31 - 1)).to.equal(3);
+      try {
+        await bitpackedSum(new Uint8Array(40));
+        throw new Error('Expected bitpackedSum to reject invalid bytes');
+      } catch (err) {
+        expect(String(err)).to.not.include('Expected bitpackedSum');
+      }
+    });
+
+    it('should count, sort and filter Arrow arrays using HPX arrowCount/arrowSort/arrowFilter', async function() {
+      // Laid out like apache-arrow Data: row 2 is null
+      const data = { values: new Int32Array([5, 3, 0, 5, 1]), nullBitmap: new Uint8Array([0b11011]), offset: 0, length: 5 };
+      expect(await arrowCount(data, 5)).to.equal(2);
+      expect(await arrowCount(data, 0)).to.equal(0);
+
+      const sorted = await arrowSort(data);
+      expect(sorted.type).to.equal('int32');
+      expect(sorted.length).to.equal(5);
+      expect(sorted.nullCount).to.equal(1);
+      const sortedJS = sorted.toJS();
+      expect(Array.from(sortedJS.values.subarray(0, 4))).to.deep.equal([1, 3, 5, 5]);
+      expect(Array.from(sortedJS.nullBitmap)).to.deep.equal([0b01111]);
+      expect(await arrowCount(sorted, 5)).to.equal(2);
+
+      // Bit-packed Boolean mask keeping rows 0, 2 and 4
+      const mask = { values: new Uint8Array([0b10101]), length: 5 };
+      const filtered = (await arrowFilter(data, mask)).toJS();
+      expect(filtered.length).to.equal(3);
+      expect(filtered.nullCount).to.equal(1);
+      expect([filtered.values[0], filtered.values[2]]).to.deep.equal([5, 1]);
+      expect(Array.from(filtered.nullBitmap)).to.deep.equal([0b101]);
+
+      expect(() => new sorted.constructor()).to.throw(TypeError);
+    });
+
+    it('should import and export Arrow arrays through the C Data Interface using HPX arrowImport/exportTo', async function() {
+      this.timeout(20000);
+      setFlagsFromString('--expose-gc');
+      const gc = runInNewContext('gc');
+      // Built next to the addon by the hpx_test_arrow target of binding.gyp
+      const producer = require(fileURLToPath(new URL('../addons/hpx_test_arrow.node', import.meta.url)));
+      const collect = async (done) => {
+        for (let i = 0; i < 50 && !done(); i++) {
+          gc();
+          await new Promise((resolve) => setTimeout(resolve, 20));
+        }
+      };
+
+      // Row 2 is null; the mask keeps rows 0, 2 and 4
+      const data = producer.produce('i', new Int32Array([5, 3, 0, 5, 1]), new Uint8Array([1, 1, 0, 1, 1]));
+      const mask = producer.produce('b', new Uint8Array([1, 0, 1, 0, 1]));
+      const consumer = producer.consumer();
+      await (async () => {
+        const column = arrowImport(data.schema, data.array);
+        const maskColumn = arrowImport(mask.schema, mask.array);
+        // Both structs are moved; only the schema is released right away
+        expect(producer.moved(data.slot)).to.equal(true);
+        expect(producer.releases(data.slot)).to.deep.equal({ schema: 1, array: 0 });
+        expect(column.type).to.equal('int32');
+        expect(column.length).to.equal(5);
+        expect(column.nullCount).to.equal(1);
+        expect(maskColumn.type).to.equal('bool');
+
+        expect(await arrowCount(column, 5)).to.equal(2);
+        const sorted = (await arrowSort(column)).toJS();
+        expect(Array.from(sorted.values.subarray(0, 4))).to.deep.equal([1, 3, 5, 5]);
+        const filtered = (await arrowFilter(column, maskColumn)).toJS();
+        expect([filtered.length, filtered.nullCount]).to.deep.equal([3, 1]);
+        expect([filtered.values[0], filtered.values[2]]).to.deep.equal([5, 1]);
+
+        column.exportTo(consumer.schema, consumer.array);
+      })();
+
+      // The mask has no users left; the exported column keeps the imported buffers alive
+      await collect(() => producer.releases(mask.slot).array === 1);
+      expect(producer.releases(mask.slot)).to.deep.equal({ schema: 1, array: 1 });
+      expect(producer.releases(data.slot)).to.deep.equal({ schema: 1, array: 0 });
+      const exported = producer.consume(consumer.slot);
+      expect(exported.format).to.equal('i');
+      expect([exported.length, exported.nullCount, exported.offset]).to.deep.equal([5, 1, 0]);
+      expect(Array.from(exported.values)).to.deep.equal([5, 3, 0, 5, 1]);
+      expect(Array.from(exported.valid)).to.deep.equal([1, 1, 0, 1, 1]);
+
+      expect(producer.release(consumer.slot)).to.equal(true);
+      await collect(() => producer.releases(data.slot).array === 1);
+      gc();
+      await new Promise((resolve) => setTimeout(resolve, 50));
+      expect(producer.releases(data.slot)).to.deep.equal({ schema: 1, array: 1 });
+
+      // Unsupported formats still release both structs, exactly once
+      const int64 = producer.produce('l', new Int32Array([1, 2]));
+      expect(() => arrowImport(int64.schema, int64.array)).to.throw(/Unsupported Arrow format 'l'/);
+      expect(producer.moved(int64.slot)).to.equal(true);
+      expect(producer.releases(int64.slot)).to.deep.equal({ schema: 1, array: 1 });
+      expect(() => arrowImport(int64.schema, int64.array)).to.throw(/already released/);
+      expect(producer.releases(int64.slot)).to.deep.equal({ schema: 1, array: 1 });
+    });
+
+    it('should reject unknown kernel plugins and kernel names', async function() {
+      expect(() => loadKernelPlugin('/nonexistent/libkernels.so')).to.throw(/Failed to load kernel plugin/);
+      expect(() => countIf(new Int32Array([1, 2, 3]), 'noSuchKernel')).to.throw(/Unknown kernel 'noSuchKernel'/);
+      expect(() => sortComp(new Int32Array([1, 2, 3]), 'noSuchKernel')).to.throw(/Unknown kernel/);
+    });
+
+    it('should run plugin kernels using HPX countIf/copyIf/sortComp/partialSortComp/transform', async function() {
+      // Built next to the addon by the hpx_test_kernels targets of binding.gyp
+      const plugin = fileURLToPath(new URL('../addons/hpx_test_kernels.node', import.meta.url));
+      const kernels = loadKernelPlugin(plugin);
+      expect(kernels).to.deep.equal([
+        { name: 'testIsEven', kind: 'predicate' },
+        { name: 'testByAbs', kind: 'key' },
+        { name: 'testDescending', kind: 'comparator' },
+        { name: 'testAddTen', kind: 'map' }
+      ]);
+      expect(loadKernelPlugin(plugin)).to.deep.equal(kernels);
+
+      const input = Int32Array.from({ length: 50000 }, (_, i) => ((i * 7919) % 2001) - 1000);
+      const even = input.filter((v) => (v & 1) === 0);
+      expect(await countIf(input, 'testIsEven')).to.equal(even.length);
+      expect(Array.from(await copyIf(input, 'testIsEven'))).to.deep.equal(Array.from(even));
+
+      const descending = Array.from(input).sort((a, b) => b - a);
+      expect(Array.from(await sortComp(input, 'testDescending'))).to.deep.equal(descending);
+      const byAbs = Array.from(await sortComp(input, 'testByAbs'));
+      expect(byAbs.map(Math.abs)).to.deep.equal(Array.from(input, Math.abs).sort((a, b) => a - b));
+      expect(byAbs.slice().sort((a, b) => a - b)).to.deep.equal(Array.from(input).sort((a, b) => a - b));
+      const partial = await partialSortComp(input, 100, 'testDescending');
+      expect(Array.from(partial.subarray(0, 100))).to.deep.equal(descending.slice(0, 100));
+
+      expect(Array.from(await transform(input, 'testAddTen'))).to.deep.equal(Array.from(input, (v) => v + 10));
+      expect(() => transform(input, 'testIsEven')).to.throw(TypeError, /wrong kind/);
+    });
+
+    it('should reject kernel plugins built for another ABI version', async function() {
+      const plugin = fileURLToPath(new URL('../addons/hpx_test_kernels_bad_abi.node', import.meta.url));
+      expect(() => loadKernelPlugin(plugin)).to.throw(/ABI version 0, expected 1/);
+    });
+
+    it('should evaluate JS predicates on a worker pool using HPX countIf/copyIf', async function() {
+      const pool = createPredicatePool('(arr) => Uint8Array.from(arr, (v) => (v % 3 === 0 ? 1 : 0))', { Worker, workers: 2 });
+      try {
+        expect(pool.size).to.equal(2);
+        const input = Int32Array.from({ length: 100000 }, (_, i) => (i * 7919) % 1000);
+        const expected = input.filter((v) => v % 3 === 0);
+        expect(await countIf(input, pool)).to.equal(expected.length);
+        expect(Array.from(await copyIf(input, pool))).to.deep.equal(Array.from(expected));
+
+        // SharedArrayBuffer-backed input is handed to the workers without a copy
+        const shared = new Int32Array(new SharedArrayBuffer(input.byteLength));
+        shared.set(input);
+        expect(await countIf(shared, pool)).to.equal(expected.length);
+      } finally {
+        pool.close();
+      }
+      expect(() => countIf(new Int32Array([3]), pool)).to.throw(/closed/);
+
+      const failing = createPredicatePool((arr) => { throw new Error('bad value ' + arr[0]); }, { Worker, workers: 1 });
+      try {
+        await countIf(new Int32Array([42]), failing);
+        expect.fail('countIf should reject when the predicate throws');
+      } catch (err) {
+        expect(String(err)).to.match(/bad value 42/);
+      } finally {
+        failing.close();
+      }
+    });
+
+    it('should terminate the workers of a predicate pool collected without close()', async function() {
+      this.timeout(20000);
+      setFlagsFromString('--expose-gc');
+      const gc = runInNewContext('gc');
+      // Every worker answers pings on a BroadcastChannel until it is terminated
+      const channelName = `hpx-pool-gc-${process.pid}`;
+      const source = `(() => {
+        const channel = new BroadcastChannel('${channelName}');
+        channel.onmessage = ({ data }) => { if (data === 'ping') channel.postMessage('pong'); };
+        return (arr) => new Uint8Array(arr.length);
+      })()`;
+      const channel = new BroadcastChannel(channelName);
+      const countPongs = async () => {
+        let pongs = 0;
+        channel.onmessage = () => { pongs++; };
+        channel.postMessage('ping');
+        await new Promise((resolve) => setTimeout(resolve, 200));
+        return pongs;
+      };
+      try {
+        (() => { createPredicatePool(source, { Worker, workers: 2 }); })();
+        let alive = 0;
+        for (let i = 0; i < 25 && alive < 2; i++) alive = await countPongs();
+        expect(alive).to.equal(2);
+        for (let i = 0; i < 25 && alive > 0; i++) {
+          gc();
+          alive = await countPongs();
+        }
+        expect(alive).to.equal(0);
+      } finally {
+        channel.close();
+      }
+    });
+
+    it('should combine bitmaps using HPX bitmapFromMask/bitmapFromIndices', async function() {
+      // Spans dense and sparse containers (65536 rows each) and a partial last container
+      const size = 3 * 65536 + 1234;
+      const maskA = Uint8Array.from({ length: size }, (_, i) => (i < 65536 ? i % 2 : i % 97 === 0 ? 5 : 0));
+      const rowsB = Int32Array.from({ length: 20000 }, (_, k) => (k * 7919) % size);
+      const inB = new Uint8Array(size);
+      rowsB.forEach((r) => { inB[r] = 1; });
+
+      const a = await bitmapFromMask(maskA);
+      const b = await bitmapFromIndices(rowsB, size);
+      expect(a.size).to.equal(size);
+      expect(a.cardinality).to.equal(maskA.filter((v) => v !== 0).length);
+      expect(b.cardinality).to.equal(inB.filter((v) => v === 1).length);
+
+      const expectedRows = (pred) => Array.from({ length: size }, (_, i) => i).filter((i) => pred(maskA[i] !== 0, inB[i] === 1));
+      expect(Array.from(await (await a.and(b)).toIndices())).to.deep.equal(expectedRows((x, y) => x && y));
+      expect(Array.from(await (await a.or(b)).toIndices())).to.deep.equal(expectedRows((x, y) => x || y));
+      expect(Array.from(await (await a.xor(b)).toIndices())).to.deep.equal(expectedRows((x, y) => x !== y));
+      expect(Array.from(await (await a.andNot(b)).toIndices())).to.deep.equal(expectedRows((x, y) => x && !y));
+      expect(Array.from(await a.toMask())).to.deep.equal(Array.from(maskA, (v) => (v !== 0 ? 1 : 0)));
+
+      expect(() => a.and(new Uint8Array(4))).to.throw(TypeError);
+      expect(() => a.or()).to.throw(TypeError);
+      const small = await bitmapFromIndices(new Int32Array([1]), 10);
+      expect(() => a.and(small)).to.throw(RangeError);
+      try {
+        await bitmapFromIndices(new Int32Array([10]), 10);
+        throw new Error('Expected bitmapFromIndices to reject a bad index');
+      } catch (err) {
+        expect(String(err)).to.include('out of range');
+      }
+    });
+
     it('should handle incorrect HPX configuration gracefully', async function() {
       const badConfig = {
         foo: 'bar',